@@ -1,6 +1,9 @@
 from seal import *
 import cmath
 import time
+import pickle
+import asyncio
+from concurrent.futures import ProcessPoolExecutor
 
 """CKKS Homomorphic Encryption Setup Example (Beginner Friendly)
 
@@ -499,6 +502,740 @@ def ckks_rotation_example():
     print('[DEBUG] Decoded after rotation:', decoded_rot[:10])
     print('-' * 70)
 
+
+def _square_in_worker(context, cipher, relin_keys):
+    # Runs in a child process; context arrives as a registry reference
+    evaluator = Evaluator(context)
+    evaluator.square_inplace(cipher)
+    evaluator.relinearize_inplace(cipher, relin_keys)
+    return cipher
+
+
+def pickle_protocol5_example():
+    """CKKS Pickle Protocol 5 Example
+
+    Ciphertexts, plaintexts, public/relin/Galois keys, EncryptionParameters and
+    SEALContext support pickle. With protocol 5 the SEAL binary payload travels
+    as an out-of-band buffer, and objects reference their SEALContext by parms_id.
+
+    Steps:
+    ------
+    1. Pickle a ciphertext with out-of-band buffers and load it back.
+    2. Send a ciphertext and relin keys to a worker process and square it there.
+    3. Decrypt and decode both results.
+    """
+    print('pickle protocol 5 example')
+    print('-' * 70)
+    cipher, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+
+    cipher.save('tmp_pickle_cipher.bin')
+    cipher = Ciphertext()
+    cipher.load(context, 'tmp_pickle_cipher.bin')
+
+    # Out-of-band: the pickle stream only holds the metadata
+    buffers = []
+    stream = pickle.dumps(cipher, protocol=5, buffer_callback=buffers.append)
+    restored = pickle.loads(stream, buffers=buffers)
+    print('[DEBUG] Pickle stream bytes:', len(stream), 'out-of-band buffers:', len(buffers))
+    print('[DEBUG] Decoded after pickle round trip:', encoder.decode(decryptor.decrypt_new(restored))[:3])
+
+    with ProcessPoolExecutor(max_workers=1) as pool:
+        squared = pool.submit(_square_in_worker, context, cipher, relin_keys).result()
+    print('[DEBUG] Decoded after squaring in worker:', encoder.decode(decryptor.decrypt_new(squared))[:3])
+    print('-' * 70)
+
+
+def ckks_dot_product_example():
+    """CKKS Fused Dot Product Example
+
+    `BatchEvaluator.dot` computes sum(a[i] * b[i]) natively: the size-3 products
+    are accumulated in place and relinearized and rescaled once at the end,
+    instead of once per term. `dot_plain` does the same with plaintext weights.
+    """
+    print('CKKS dot product example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    batch = BatchEvaluator(context)
+
+    cts_a, cts_b, pts = [], [], []
+    for i in range(8):
+        encryptor.encrypt(encoder.encode_new([i + 1.0], scale)).save('tmp_dot_cipher.bin')
+        cts_a.append(load_ciphertext(context, 'tmp_dot_cipher.bin'))
+        encryptor.encrypt(encoder.encode_new([0.5], scale)).save('tmp_dot_cipher.bin')
+        cts_b.append(load_ciphertext(context, 'tmp_dot_cipher.bin'))
+        pts.append(encoder.encode_new([2.0], scale))
+
+    result = batch.dot(cts_a, cts_b, relin_keys)
+    print('[DEBUG] dot (expected 18.0):', encoder.decode(decryptor.decrypt_new(result))[0])
+    result = batch.dot_plain(cts_a, pts)
+    print('[DEBUG] dot_plain (expected 72.0):', encoder.decode(decryptor.decrypt_new(result))[0])
+    print('-' * 70)
+
+
+def ckks_compact_keys_example():
+    """CKKS Compact Galois Keys Example
+
+    `CompactGaloisKeys` keeps each key-switching key in SEAL's seeded form and
+    expands a Galois element only when a rotation needs it, keeping at most
+    `cache_size` elements expanded.
+    """
+    print('CKKS compact Galois keys example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    keygen = KeyGenerator(context)
+    decryptor = Decryptor(context, keygen.secret_key())
+    encryptor = Encryptor(context, keygen.create_public_key())
+    compact = CompactGaloisKeys.from_steps(context, keygen, [1, 2, 4, 8], cache_size=2)
+    print('[DEBUG] Seeded key bytes:', compact.compact_bytes())
+
+    encryptor.encrypt(encoder.encode_new([i + 1.0 for i in range(10)], scale)).save('tmp_compact_cipher.bin')
+    cipher = load_ciphertext(context, 'tmp_compact_cipher.bin')
+    for steps in [1, 2, 4, 1]:
+        compact.rotate_vector_inplace(evaluator, cipher, steps)
+    print('[DEBUG] Decoded after rotating by 8:', encoder.decode(decryptor.decrypt_new(cipher))[:3])
+    print('[DEBUG] Cache hits/misses:', compact.hits(), compact.misses(), 'cached:', compact.cached_keys())
+    print('-' * 70)
+
+
+def ckks_scalar_example():
+    """CKKS Scalar Operations Example
+
+    `BatchEvaluator.multiply_scalar`, `add_scalar` and `multiply_integer` work on
+    the ciphertext's RNS data directly, so no plaintext is encoded for a constant.
+    multiply_scalar scales by the last prime, so rescale_to_next restores the scale.
+    """
+    print('CKKS scalar example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    batch = BatchEvaluator(context)
+
+    encryptor.encrypt(encoder.encode_new([1.0, 2.0, 3.0], scale)).save('tmp_scalar_cipher.bin')
+    cipher = load_ciphertext(context, 'tmp_scalar_cipher.bin')
+
+    batch.multiply_integer(cipher, 3)
+    batch.add_scalar(cipher, 0.5)
+    batch.multiply_scalar(cipher, 0.25)
+    evaluator.rescale_to_next(cipher)
+    print('[DEBUG] Scale restored:', cipher.scale() == scale)
+    print('[DEBUG] Decoded (expected 0.875, 1.625, 2.375):', encoder.decode(decryptor.decrypt_new(cipher))[:3])
+    print('-' * 70)
+
+
+def ckks_pair_packing_example():
+    """CKKS Real-Pair Packing Example
+
+    `CKKSEncoder.encode_pair` packs two real vectors as x + i*y. Additions,
+    rotations and real-plaintext products then process both at once;
+    `BatchEvaluator.separate_pair` splits them apart with one conjugation.
+    """
+    print('CKKS pair packing example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    batch = BatchEvaluator(context)
+
+    plain = encoder.encode_pair([1.0, 2.0, 3.0], [10.0, 20.0, 30.0], scale)
+    encryptor.encrypt(plain).save('tmp_pair_cipher.bin')
+    cipher = load_ciphertext(context, 'tmp_pair_cipher.bin')
+    evaluator.add_plain(cipher, encoder.encode_pair([1.0] * 3, [1.0] * 3, scale))
+
+    real, imag = encoder.decode_pair(decryptor.decrypt_new(cipher))
+    print('[DEBUG] Packed decode:', real[:3], imag[:3])
+    ct_real, ct_imag = batch.separate_pair(cipher, galois_keys)
+    print('[DEBUG] Separated real:', encoder.decode(decryptor.decrypt_new(ct_real))[:3])
+    print('[DEBUG] Separated imag:', encoder.decode(decryptor.decrypt_new(ct_imag))[:3])
+    print('-' * 70)
+
+
+def ckks_async_example():
+    """CKKS Asynchronous Evaluation Example
+
+    `AsyncEvaluator` runs operations on a native thread pool and returns
+    awaitable futures, so an asyncio event loop is never blocked. `chain_async`
+    runs multiply -> relinearize -> rescale without returning to Python.
+    """
+    print('CKKS async example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    async_evaluator = AsyncEvaluator(context)
+
+    async def compute():
+        cipher = await async_evaluator.encrypt_async(encryptor, encoder.encode_new([1.5, 2.5], scale))
+        squares = await asyncio.gather(*[
+            async_evaluator.chain_async(cipher, [('multiply', cipher), ('relinearize', relin_keys), 'rescale_to_next'])
+            for _ in range(4)
+        ])
+        print('[DEBUG] Queue depth / in flight:', async_evaluator.queue_depth(), async_evaluator.in_flight())
+        return await async_evaluator.decrypt_async(decryptor, squares[0])
+
+    plain = asyncio.run(compute())
+    print('[DEBUG] Decoded after async square (expected 2.25, 6.25):', encoder.decode(plain)[:2])
+    print('-' * 70)
+
+def ckks_tuner_example():
+    """Pick encryption parameters for a circuit by benchmarking the candidates.
+
+    The tuner lists the poly_modulus_degree / coeff_modulus layouts that fit the
+    security bound, runs a depth-2 circuit with one rotation on each, and returns
+    the fastest layout that reaches the requested precision.
+    """
+    print('CKKS parameter tuner example')
+    print('-' * 70)
+    result = ParameterTuner.tune(SchemeType.CKKS, depth=2, precision_bits=20, rotations=1, trials=3)
+    print(result.report())
+    best = result.best
+    print('[DEBUG] Chosen N:', best.poly_modulus_degree, 'bit sizes:', best.bit_sizes)
+    print('[DEBUG] Measured precision bits: %.1f' % best.precision_bits)
+    print('[DEBUG] Estimated circuit ms: %.3f' % best.circuit_ms)
+
+    context = SEALContext(result.parms)
+    print('[DEBUG] Context parameters set:', context.parameters_set())
+    print('-' * 70)
+
+
+def ckks_conv2d_example():
+    """CKKS 2-D Convolution Example
+
+    `Conv2D` packs a [C][H][W] image channel major into the slots, pre-encodes
+    the 3x3 filter taps, rotates the input once per tap and returns one
+    ciphertext per output channel, rescaled once. The Galois steps it needs come
+    from `galois_steps()`.
+    """
+    print('CKKS conv2d example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    channels, height, width, out_channels, k = 2, 8, 8, 3, 3
+    image = [((c * 7 + i) % 11) / 10.0 for c in range(channels) for i in range(height * width)]
+    weights = [((o + c + t) % 5 - 2) / 4.0 for o in range(out_channels) for c in range(channels) for t in range(k * k)]
+    conv = Conv2D(context, channels, height, width, out_channels, k, weights, bias=[0.5, 0.0, -0.5])
+
+    keygen = KeyGenerator(context)
+    decryptor = Decryptor(context, keygen.secret_key())
+    encryptor = Encryptor(context, keygen.create_public_key())
+    conv_keys = keygen.create_galois_keys(conv.galois_steps())
+    print('[DEBUG] Galois steps:', conv.galois_steps())
+
+    encryptor.encrypt(conv.encode(image, scale)).save('tmp_conv_cipher.bin')
+    cipher = load_ciphertext(context, 'tmp_conv_cipher.bin')
+    start = time.time()
+    outputs = conv.apply(cipher, conv_keys)
+    print('[DEBUG] conv2d time: %.3fs' % (time.time() - start))
+
+    # Plain reference for output channel 0
+    def pixel(c, y, x):
+        return image[(c * height + y) * width + x] if 0 <= y < height and 0 <= x < width else 0.0
+    expected = [0.5 + sum(weights[(0 * channels + c) * k * k + dy * k + dx] * pixel(c, y + dy - 1, x + dx - 1)
+                          for c in range(channels) for dy in range(k) for dx in range(k))
+                for y in range(height) for x in range(width)]
+    result = conv.decode(decryptor.decrypt_new(outputs[0]))
+    print('[DEBUG] Max error (channel 0):', max(abs(a - b) for a, b in zip(result, expected)))
+    print('-' * 70)
+
+
+def ckks_streaming_reduce_example():
+    """CKKS Streaming Reduction Example
+
+    `StreamingReducer` sums ciphertexts stored on disk with reader threads,
+    compute workers and a final tree merge running as overlapped stages.
+    `save_ciphertexts` writes many ciphertexts into one file for it to stream.
+    """
+    print('CKKS streaming reduce example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    rows, files = 64, 4
+    paths = []
+    for f in range(files):
+        batch = []
+        for i in range(f * rows // files, (f + 1) * rows // files):
+            cipher = Ciphertext()
+            encryptor.encrypt_inplace(encoder.encode_new([i / rows, 1.0], scale), cipher)
+            batch.append(cipher)
+        paths.append('tmp_stream_%d.bin' % f)
+        save_ciphertexts(batch, paths[-1])
+
+    reducer = StreamingReducer(context, readers=2, workers=4, queue_capacity=16)
+    total = reducer.sum(paths)
+    stats = reducer.stats()
+    print('[DEBUG] Sum:', encoder.decode(decryptor.decrypt_new(total))[:2], 'expected:', [(rows - 1) / 2, rows])
+    print('[DEBUG] Items/s: %.1f' % stats['items_per_second'], 'MB/s: %.1f' % stats['mb_per_second'])
+    print('[DEBUG] Reader stall s: %.3f' % stats['reader_stall_seconds'],
+          'worker stall s: %.3f' % stats['worker_stall_seconds'], 'queue high water:', stats['queue_high_water'])
+
+    squares = reducer.sum_of_squares(paths, relin_keys)
+    print('[DEBUG] Sum of squares:', encoder.decode(decryptor.decrypt_new(squares))[:2],
+          'expected:', [sum((i / rows) ** 2 for i in range(rows)), rows])
+    print('-' * 70)
+
+
+def ckks_memo_example():
+    """CKKS Memoization Example
+
+    `content_hash()` identifies a ciphertext or plaintext by parms_id, scale and
+    data. `MemoEvaluator` uses those hashes (plus the key identity) to return
+    cached results for repeated rotations and products, within a memory cap.
+    """
+    print('CKKS memoization example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    encryptor.encrypt(encoder.encode_new([1.0, 2.0, 3.0, 4.0], scale)).save('tmp_memo_cipher.bin')
+    cipher = load_ciphertext(context, 'tmp_memo_cipher.bin')
+    copy = load_ciphertext(context, 'tmp_memo_cipher.bin')
+    print('[DEBUG] Equal content hashes:', cipher.content_hash() == copy.content_hash())
+
+    memo = MemoEvaluator(context, capacity_bytes=64 << 20, relin_keys=relin_keys, galois_keys=galois_keys)
+    plain = encoder.encode_new([0.5] * 4, scale)
+    for _ in range(3):
+        rotated = memo.rotate_vector(cipher, 1)
+        product = memo.multiply_plain(copy, plain)
+    print('[DEBUG] Rotated:', encoder.decode(decryptor.decrypt_new(rotated))[:3])
+    print('[DEBUG] Stats:', memo.stats())
+    memo.set_capacity_bytes(0)
+    print('[DEBUG] After shrinking the cap:', memo.stats())
+    print('-' * 70)
+
+def ckks_trusted_load_example():
+    """CKKS Trusted Load Example
+
+    `TrustedStore` writes objects with an integrity tag (keyed BLAKE2b, a
+    content hash, or nothing) and, once a tag checks out, loads them without
+    SEAL's per-coefficient validation. `BulkLoader` keeps full validation for
+    untrusted files but loads their objects in parallel. Both are timed against
+    the sequential `load_ciphertexts` / `load_galois_keys` path.
+    """
+    print('CKKS trusted load example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    cts = []
+    for i in range(64):
+        cipher = Ciphertext()
+        encryptor.encrypt_inplace(encoder.encode_new([i / 64], scale), cipher)
+        cts.append(cipher)
+    save_ciphertexts(cts, 'tmp_bulk.bin')
+
+    start = time.time()
+    load_ciphertexts(context, 'tmp_bulk.bin')
+    print('[DEBUG] Sequential validated load: %.3fs' % (time.time() - start))
+
+    bulk = BulkLoader(context)
+    loaded = bulk.load_ciphertexts('tmp_bulk.bin')
+    print('[DEBUG] Parallel validated load: %.3fs' % bulk.stats()['seconds'], 'threads:', bulk.threads)
+
+    for integrity in [Integrity.none, Integrity.hash, Integrity.mac]:
+        store = TrustedStore(b'0123456789abcdef', integrity)
+        for compress in [True, False]:
+            store.save(cts, 'tmp_trusted.bin', compress)
+            loaded = store.load_ciphertexts(context, 'tmp_trusted.bin')
+            stats = store.stats()
+            print('[DEBUG] Trusted load (%s, compress=%s): %.3fs, verify %.3fs' %
+                  (integrity.name, compress, stats['seconds'], stats['verify_seconds']))
+    print('[DEBUG] Value:', encoder.decode(decryptor.decrypt_new(loaded[32]))[0], 'expected:', 0.5)
+
+    save(galois_keys, 'tmp_galois.bin')
+    start = time.time()
+    load_galois_keys(context, 'tmp_galois.bin')
+    print('[DEBUG] Galois keys validated load: %.3fs' % (time.time() - start))
+    store = TrustedStore(b'0123456789abcdef')
+    store.save(galois_keys, 'tmp_trusted_galois.bin', compress=False)
+    store.load_galois_keys(context, 'tmp_trusted_galois.bin')
+    print('[DEBUG] Galois keys trusted load: %.3fs' % store.stats()['seconds'])
+
+    # A flipped byte must be rejected rather than loaded
+    with open('tmp_trusted.bin', 'r+b') as f:
+        f.seek(-16, 2)
+        byte = f.read(1)
+        f.seek(-16, 2)
+        f.write(bytes([byte[0] ^ 1]))
+    try:
+        TrustedStore(b'0123456789abcdef').load_ciphertexts(context, 'tmp_trusted.bin')
+        print('[DEBUG] Tampering not detected')
+    except RuntimeError as e:
+        print('[DEBUG] Tampering detected:', e)
+    print('-' * 70)
+
+def ckks_prng_example():
+    """CKKS PRNG Pool Example
+
+    `PooledPRNGFactory` gives every thread its own buffered seed stream, so
+    encryption neither seeds a generator from the OS nor shares a factory
+    across threads. It is set on the parameters with `set_random_generator`
+    and compared here with SEAL's default factory. With a seed, a
+    single-threaded run is reproducible, keys included.
+    """
+    print('CKKS PRNG pool example')
+    print('-' * 70)
+
+    def make_context(factory):
+        parms = EncryptionParameters(SchemeType.CKKS)
+        parms.set_poly_modulus_degree(8192)
+        parms.set_coeff_modulus(CoeffModulus.Create(8192, [60, 40, 40, 60]))
+        if factory is not None:
+            parms.set_random_generator(factory)
+        return SEALContext(parms)
+
+    backends = [('default', None),
+                ('pooled blake2xb', PooledPRNGFactory(prng_type.blake2xb)),
+                ('pooled shake256', PooledPRNGFactory(prng_type.shake256))]
+    for name, factory in backends:
+        prng = benchmark_prng(factory or UniformRandomGeneratorFactory.DefaultFactory(), count=20000, threads=4)
+        context = make_context(factory)
+        keygen = KeyGenerator(context)
+        plain = CKKSEncoder(context).encode_new([1.0, 2.0], 2.0 ** 40)
+        single = benchmark_encryption(context, keygen.create_public_key(), plain, count=200, threads=1)
+        multi = benchmark_encryption(context, keygen.create_public_key(), plain, count=800, threads=4)
+        print('[DEBUG] %-16s generators/s: %9.0f  enc/s 1 thread: %6.1f  4 threads: %6.1f' %
+              (name, prng['generators_per_second'], single['encryptions_per_second'],
+               multi['encryptions_per_second']))
+
+    seed = random_seed()
+    hashes = []
+    for _ in range(2):
+        context = make_context(PooledPRNGFactory(prng_type.blake2xb, seed=seed))
+        keygen = KeyGenerator(context)
+        encryptor = Encryptor(context, keygen.create_public_key())
+        cipher = Ciphertext()
+        encryptor.encrypt_inplace(CKKSEncoder(context).encode_new([1.0], 2.0 ** 40), cipher)
+        hashes.append(cipher.content_hash())
+    print('[DEBUG] Seeded runs identical:', hashes[0] == hashes[1])
+    print('-' * 70)
+
+
+def ckks_cpu_dispatch_example():
+    """CPU Dispatch Example
+
+    The module carries baseline, AVX2 and HEXL (AVX-512) builds of its RNS
+    kernels and picks one at import from CPUID. `SEAL_PYTHON_BACKEND` set
+    before import forces a lower one; any value other than baseline, avx2,
+    hexl or auto makes the import fail. `benchmark_backends` times every backend
+    this CPU can run and checks that they agree.
+    """
+    print('CPU dispatch example')
+    print('-' * 70)
+    _, context, encoder, decryptor, evaluator, encryptor, scale, relin_keys, galois_keys = get_seal()
+    print('[DEBUG] CPU features:', cpu_features())
+    print('[DEBUG] Active backend:', active_backend(), 'available:', available_backends(),
+          'requested:', repr(requested_backend()))
+    timings = benchmark_backends(context, iterations=200)
+    for name, timing in timings.items():
+        print('[DEBUG] %-8s %.4f ms per call' % (name, timing['ms_per_call']))
+    print('[DEBUG] Backends agree:', len({timing['checksum'] for timing in timings.values()}) == 1)
+    print('-' * 70)
+
+def ckks_rotation_planner_example():
+    """CKKS Rotation Planner Example
+
+    With only a few Galois keys, `RotationPlanner` composes any other step
+    from the available ones using the fewest key switches. `rotate_many` shares
+    intermediate rotations between the steps of a batch, and
+    `recommend_keys` picks the key set for a workload.
+    """
+    print('CKKS rotation planner example')
+    print('-' * 70)
+    parms = EncryptionParameters(SchemeType.CKKS)
+    parms.set_poly_modulus_degree(8192)
+    parms.set_coeff_modulus(CoeffModulus.Create(8192, [60, 40, 40, 60]))
+    context = SEALContext(parms)
+    keygen = KeyGenerator(context)
+    encoder = CKKSEncoder(context)
+    encryptor = Encryptor(context, keygen.create_public_key())
+    decryptor = Decryptor(context, keygen.secret_key())
+    slots = encoder.slot_count()
+
+    workload = [1, 3, 5, 7, 12, 100, -9, 257, 300]
+    key_steps = RotationPlanner.recommend_keys(context, workload, max_keys=4)
+    print('[DEBUG] Recommended key steps:', key_steps)
+    planner = RotationPlanner(context, keygen.create_galois_keys(key_steps), threads=4)
+    print('[DEBUG] 257 =', planner.decompose(257), 'cost:', planner.cost(257))
+    plan = planner.plan(workload)
+    print('[DEBUG] Key switches shared: %d, independent: %d, depth: %d' %
+          (plan['keyswitches'], plan['independent_keyswitches'], plan['depth']))
+
+    cipher = Ciphertext()
+    encryptor.encrypt_inplace(encoder.encode_new([float(i) for i in range(slots)], 2.0 ** 40), cipher)
+    start = time.time()
+    rotated = planner.rotate_many(cipher, workload)
+    print('[DEBUG] rotate_many time: %.3fs' % (time.time() - start))
+    first = [round(encoder.decode(decryptor.decrypt_new(c))[0].real) for c in rotated]
+    print('[DEBUG] First slots:', first, 'expected:', [step % slots for step in workload])
+    print('-' * 70)
+
+
+def ckks_pool_example():
+    """CKKS Object Pool Example
+
+    `CiphertextPool` and `PlaintextPool` hand out pre-reserved objects so a
+    steady-state loop stops constructing and resizing ciphertexts. Pass a
+    pool where an output would go, and release results when done.
+    """
+    print('CKKS object pool example')
+    print('-' * 70)
+    parms = EncryptionParameters(SchemeType.CKKS)
+    parms.set_poly_modulus_degree(8192)
+    parms.set_coeff_modulus(CoeffModulus.Create(8192, [60, 40, 40, 60]))
+    context = SEALContext(parms)
+    keygen = KeyGenerator(context)
+    encoder = CKKSEncoder(context)
+    encryptor = Encryptor(context, keygen.create_public_key())
+    decryptor = Decryptor(context, keygen.secret_key())
+    evaluator = Evaluator(context)
+    galois_keys = keygen.create_galois_keys([1])
+    scale = 2.0 ** 40
+
+    ciphers = CiphertextPool(context, size_capacity=2, preallocate=4)
+    plains = PlaintextPool(context, preallocate=4)
+    values = [0.5 * i for i in range(8)]
+    cipher = encryptor.encrypt(encoder.encode_new(values, scale), ciphers)
+
+    start = time.time()
+    for _ in range(50):
+        weights = encoder.encode_new([2.0] * 8, scale, plains)
+        product = evaluator.multiply_plain_out(cipher, weights, ciphers)
+        rotated = evaluator.rotate_vector(product, 1, galois_keys, ciphers)
+        result = decryptor.decrypt_new(rotated, plains)
+        decoded = encoder.decode(result)
+        for plain in (weights, result):
+            plains.release(plain)
+        for c in (product, rotated):
+            ciphers.release(c)
+    print('[DEBUG] 50 pooled iterations: %.3fs' % (time.time() - start))
+    print('[DEBUG] Decoded:', [round(v.real, 3) for v in decoded[:4]])
+    print('[DEBUG] Ciphertext pool:', ciphers.stats())
+    print('[DEBUG] Plaintext pool:', plains.stats())
+    ciphers.release(cipher)
+    print('-' * 70)
+
+
+def ckks_bootstrap_example():
+    """CKKS Bootstrapping Example
+
+    `CKKSBootstrapper` refreshes a ciphertext at the bottom of the modulus
+    chain back up to `output_level`, so a circuit can run deeper than the
+    chain. Bootstrapping needs a long chain and a sparse secret; the
+    parameters below are demo-sized and NOT secure (sec_level NONE).
+    Production settings use N = 65536 with a vetted parameter set.
+    """
+    print('CKKS bootstrapping example')
+    print('-' * 70)
+    parms = EncryptionParameters(SchemeType.CKKS)
+    parms.set_poly_modulus_degree(2048)
+    # q0, two application levels, SlotToCoeff, EvalMod + CoeffToSlot, special prime
+    parms.set_coeff_modulus(CoeffModulus.Create(2048, [60] + [40] * 2 + [45] * 3 + [55] * 12 + [60]))
+    context = SEALContext(parms, True, sec_level_type.NONE)
+    bootstrapper = CKKSBootstrapper(context, k_range=12)
+    print('[DEBUG] Depth %d (EvalMod degree %d, depth %d), output level %d' %
+          (bootstrapper.depth, bootstrapper.eval_mod_degree, bootstrapper.eval_mod_depth,
+           bootstrapper.output_level))
+
+    keygen = KeyGenerator(context, sparse_secret_key(context, 64))
+    relin_keys = keygen.create_relin_keys()
+    galois_keys = keygen.create_galois_keys_from_elts(bootstrapper.galois_elements())
+    encoder = CKKSEncoder(context)
+    encryptor = Encryptor(context, keygen.create_public_key())
+    decryptor = Decryptor(context, keygen.secret_key())
+    evaluator = Evaluator(context)
+
+    values = [0.01 * (i % 100) - 0.5 for i in range(encoder.slot_count())]
+    cipher = Ciphertext()
+    encryptor.encrypt_inplace(encoder.encode_new(values, 2.0 ** 40), cipher)
+    for _ in range(context.first_context_data().chain_index):
+        evaluator.mod_switch_to_next_inplace(cipher)
+    refreshed, report = bootstrapper.measure(cipher, relin_keys, galois_keys, decryptor)
+    print('[DEBUG] Level %d -> %d, precision %.1f bits (max error %.2e)' %
+          (report['input_level'], report['output_level'], report['precision_bits'], report['max_error']))
+    print('[DEBUG] Timings:', {k: round(v, 3) for k, v in report['timings'].items()})
+
+    evaluator.square_inplace(refreshed)
+    evaluator.relinearize_inplace(refreshed, relin_keys)
+    evaluator.rescale_to_next(refreshed)
+    decoded = encoder.decode(decryptor.decrypt_new(refreshed))
+    print('[DEBUG] Squared after bootstrapping:', [round(v.real, 4) for v in decoded[:4]],
+          'expected:', [round(v * v, 4) for v in values[:4]])
+    print('-' * 70)
+
+
+def ckks_inference_example():
+    """CKKS Encrypted Inference Example
+
+    `NNModel` describes a small network (conv, square activation, average
+    pooling, dense) and saves it in a compact file. `EncryptedInference`
+    loads it onto a context: it plans the level of every layer, pre-encodes
+    the weights and reports the Galois keys it needs. Batches of encrypted
+    inputs then run across the worker threads.
+    """
+    print('CKKS encrypted inference example')
+    print('-' * 70)
+    model = NNModel(1, 8, 8)
+    model.add_conv(2, 3, [((i % 5) - 2) * 0.1 for i in range(2 * 9)], bias=[0.1, -0.1])
+    model.add_poly([0.0, 0.5, 0.25])
+    model.add_avg_pool(2)
+    model.add_dense(10, [((i % 7) - 3) * 0.05 for i in range(10 * 32)])
+    model.save('tmp_model.bin')
+    model = NNModel.load('tmp_model.bin')
+
+    parms = EncryptionParameters(SchemeType.CKKS)
+    parms.set_poly_modulus_degree(16384)
+    parms.set_coeff_modulus(CoeffModulus.Create(16384, [60] + [40] * 5 + [60]))
+    context = SEALContext(parms)
+    runtime = EncryptedInference(context, model, 2.0 ** 40, threads=4)
+    for layer in runtime.layers():
+        print('[DEBUG] %-8s levels %d -> %d, rotations %d, plaintexts %d' %
+              (layer['kind'], layer['input_level'], layer['output_level'], layer['rotations'], layer['plaintexts']))
+
+    keygen = KeyGenerator(context)
+    relin_keys = keygen.create_relin_keys()
+    galois_keys = keygen.create_galois_keys(runtime.galois_steps())
+    encryptor = Encryptor(context, keygen.create_public_key())
+    decryptor = Decryptor(context, keygen.secret_key())
+
+    images = [[((i * (b + 1)) % 9) / 9.0 for i in range(64)] for b in range(4)]
+    ciphers = []
+    for image in images:
+        cipher = Ciphertext()
+        encryptor.encrypt_inplace(runtime.encode(image), cipher)
+        ciphers.append(cipher)
+    start = time.time()
+    results = runtime.infer_batch(ciphers, relin_keys, galois_keys)
+    print('[DEBUG] Batch of %d: %.3fs' % (len(results), time.time() - start))
+    scores = runtime.decode(decryptor.decrypt_new(results[0]))
+    print('[DEBUG] Scores:', [round(v, 4) for v in scores])
+    for layer in runtime.stats():
+        print('[DEBUG] %-8s %.1f ms/call over %d calls' % (layer['kind'], layer['mean_seconds'] * 1000, layer['calls']))
+    print('-' * 70)
+
+
+def ckks_numa_example():
+    """CKKS NUMA Worker Pool Example
+
+    `NumaWorkerPool` runs batched key-switching work with one pinned worker
+    pool per NUMA node. Relinearization and Galois keys are replicated into
+    each node's memory, and every ciphertext is processed on the node that
+    holds its data. On a single-socket machine there is just one node.
+    """
+    print('CKKS NUMA worker pool example')
+    print('-' * 70)
+    for node in numa_topology():
+        print('[DEBUG] Node %d: %d CPUs' % (node['id'], len(node['cpus'])))
+
+    parms = EncryptionParameters(SchemeType.CKKS)
+    parms.set_poly_modulus_degree(8192)
+    parms.set_coeff_modulus(CoeffModulus.Create(8192, [60, 40, 40, 60]))
+    context = SEALContext(parms)
+    keygen = KeyGenerator(context)
+    encoder = CKKSEncoder(context)
+    encryptor = Encryptor(context, keygen.create_public_key())
+    decryptor = Decryptor(context, keygen.secret_key())
+
+    workers = NumaWorkerPool(context)
+    workers.set_relin_keys(keygen.create_relin_keys())
+    workers.set_galois_keys(keygen.create_galois_keys([1]))
+    ciphers = []
+    for i in range(16):
+        cipher = Ciphertext()
+        encryptor.encrypt_inplace(encoder.encode_new([float(i)] * 4, 2.0 ** 40), cipher)
+        ciphers.append(cipher)
+    print('[DEBUG] Routes:', workers.route(ciphers))
+
+    squares = workers.multiply_relinearize(ciphers, ciphers)
+    rotated = workers.rotate(squares, 1)
+    print('[DEBUG] 3^2 =', round(encoder.decode(decryptor.decrypt_new(rotated[3]))[0], 3))
+    for node in workers.stats():
+        print('[DEBUG] Node %d: %d items (%d local), %.1f items/s' %
+              (node['node'], node['items'], node['local_items'], node['items_per_second']))
+    print('-' * 70)
+
+
+def ckks_matmul_example():
+    """CKKS Matrix Multiplication Example
+
+    `CKKSMatMul` multiplies encrypted d x d matrices natively with the
+    Jiang-Kim-Lauter-Song packing: one call replaces O(d^2) rotations,
+    multiplications and additions issued from Python. `galois_steps()`
+    lists the rotation keys it needs, and `transpose` together with
+    `matmul` gives the Gram matrix X^T X.
+    """
+    print('CKKS matrix multiplication example')
+    print('-' * 70)
+    d = 8
+    parms = EncryptionParameters(SchemeType.CKKS)
+    parms.set_poly_modulus_degree(16384)
+    parms.set_coeff_modulus(CoeffModulus.Create(16384, [60, 40, 40, 40, 40, 60]))
+    context = SEALContext(parms)
+    mm = CKKSMatMul(context, d)
+    steps = mm.galois_steps(transpose=True)
+    print('[DEBUG] d = %d, copies: %d, Galois keys: %d, key switches per matmul: %d' %
+          (d, mm.copies, len(steps), mm.keyswitches))
+
+    keygen = KeyGenerator(context)
+    relin_keys = keygen.create_relin_keys()
+    galois_keys = keygen.create_galois_keys(steps)
+    encryptor = Encryptor(context, keygen.create_public_key())
+    decryptor = Decryptor(context, keygen.secret_key())
+
+    x = [((i * 7) % 11 - 5) / 10.0 for i in range(d * d)]
+    y = [((i * 3) % 7 - 3) / 10.0 for i in range(d * d)]
+    cx, cy = Ciphertext(), Ciphertext()
+    encryptor.encrypt_inplace(mm.encode(x, 2.0 ** 40), cx)
+    encryptor.encrypt_inplace(mm.encode(y, 2.0 ** 40), cy)
+    start = time.time()
+    product = mm.matmul(cx, cy, relin_keys, galois_keys)
+    print('[DEBUG] matmul: %.3fs' % (time.time() - start))
+    got = mm.decode(decryptor.decrypt_new(product))
+    want = [sum(x[i * d + k] * y[k * d + j] for k in range(d)) for i in range(d) for j in range(d)]
+    print('[DEBUG] Max error:', max(abs(g - w) for g, w in zip(got, want)))
+
+    # X^T X: transpose uses one level, so X is matched to it inside matmul
+    gram = mm.decode(decryptor.decrypt_new(mm.matmul(mm.transpose(cx, galois_keys), cx, relin_keys, galois_keys)))
+    want = [sum(x[k * d + i] * x[k * d + j] for k in range(d)) for i in range(d) for j in range(d)]
+    print('[DEBUG] Gram max error:', max(abs(g - w) for g, w in zip(gram, want)))
+    print('-' * 70)
+
+
+def ckks_group_by_example():
+    """Encrypted Group-By Example
+
+    `GroupByAggregator` computes SUM / COUNT / AVG grouped by a plaintext key
+    over encrypted columns, one row per slot. The group masks are encoded
+    once; `aggregate` then runs every requested aggregate in one native,
+    multithreaded sweep and returns one ciphertext per aggregate with group
+    g in slot g. CKKS gives sums and means; BFV exact sums and counts are in
+    test_bfv_and_bgv.py.
+    """
+    print('CKKS group-by example')
+    print('-' * 70)
+    rows, group_count = 6000, 12
+    groups = [(i * 7) % group_count for i in range(rows)]
+    values = [((i * 13) % 100) / 10.0 for i in range(rows)]
+
+    parms = EncryptionParameters(SchemeType.CKKS)
+    parms.set_poly_modulus_degree(8192)
+    parms.set_coeff_modulus(CoeffModulus.Create(8192, [60, 40, 40, 60]))
+    context = SEALContext(parms)
+    agg = GroupByAggregator(context, groups)
+    print('[DEBUG] groups: %d, ciphertexts per column: %d, rotations per column: %d' %
+          (agg.group_count, agg.ciphertext_count, agg.rotations))
+
+    keygen = KeyGenerator(context)
+    galois_keys = keygen.create_galois_keys(agg.galois_steps())
+    encryptor = Encryptor(context, keygen.create_public_key())
+    decryptor = Decryptor(context, keygen.secret_key())
+    encoder = CKKSEncoder(context)
+    slots = agg.slot_count
+    column = []
+    for i in range(0, rows, slots):
+        cipher = Ciphertext()
+        encryptor.encrypt_inplace(encoder.encode_new(values[i:i + slots], 2.0 ** 40), cipher)
+        column.append(cipher)
+
+    start = time.time()
+    total, mean = agg.aggregate([column, column], ['sum', 'mean'], galois_keys)
+    print('[DEBUG] sum + mean: %.3fs' % (time.time() - start))
+    got_sum = encoder.decode(decryptor.decrypt_new(total))[:group_count]
+    got_mean = encoder.decode(decryptor.decrypt_new(mean))[:group_count]
+    want_sum = [sum(v for v, g in zip(values, groups) if g == k) for k in range(group_count)]
+    want_mean = [s / c for s, c in zip(want_sum, agg.counts)]
+    print('[DEBUG] Max sum error:', max(abs(a - b) for a, b in zip(got_sum, want_sum)))
+    print('[DEBUG] Max mean error:', max(abs(a - b) for a, b in zip(got_mean, want_mean)))
+    print('-' * 70)
+
+
 if __name__ == "__main__":
     serialization_example()
     pickle_example()
@@ -508,4 +1245,24 @@ if __name__ == "__main__":
     ckks_rotation_example()
     ckks_rescale_modswitch_example()
     ckks_conjugation_example()
+    pickle_protocol5_example()
+    ckks_dot_product_example()
+    ckks_compact_keys_example()
+    ckks_scalar_example()
+    ckks_pair_packing_example()
+    ckks_async_example()
+    ckks_tuner_example()
+    ckks_conv2d_example()
+    ckks_streaming_reduce_example()
+    ckks_memo_example()
+    ckks_trusted_load_example()
+    ckks_prng_example()
+    ckks_cpu_dispatch_example()
+    ckks_rotation_planner_example()
+    ckks_pool_example()
+    ckks_bootstrap_example()
+    ckks_inference_example()
+    ckks_numa_example()
+    ckks_matmul_example()
+    ckks_group_by_example()
     print('All examples completed successfully.')
\ No newline at end of file
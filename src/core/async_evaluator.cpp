@@ -0,0 +1,208 @@
+#include "async_evaluator.h"
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+using namespace seal;
+
+namespace {
+    // Process-wide count of uncompleted futures, used by drain_all at exit
+    std::atomic<std::size_t> total_pending{ 0 };
+    std::mutex total_mutex;
+    std::condition_variable total_cv;
+
+    py::object to_python_exception(const std::exception_ptr &error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::invalid_argument &e) {
+            return py::reinterpret_borrow<py::object>(PyExc_ValueError)(e.what());
+        } catch (const std::exception &e) {
+            return py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(e.what());
+        } catch (...) {
+            return py::reinterpret_borrow<py::object>(PyExc_RuntimeError)("unknown native error");
+        }
+    }
+
+    // Reports a native failure raised while completing a future the same way
+    // error_already_set::discard_as_unraisable reports Python ones
+    void report_unraisable(const std::exception_ptr &error, const char *where) {
+        auto exception = to_python_exception(error);
+        PyErr_SetObject(reinterpret_cast<PyObject *>(Py_TYPE(exception.ptr())), exception.ptr());
+        py::error_already_set().discard_as_unraisable(where);
+    }
+
+    // Runs fn when the scope exits, however it exits
+    template <class F>
+    class ScopeExit {
+    public:
+        explicit ScopeExit(F fn) : fn_(std::move(fn)) {}
+        ScopeExit(const ScopeExit &) = delete;
+        ScopeExit &operator=(const ScopeExit &) = delete;
+        ~ScopeExit() { fn_(); }
+
+    private:
+        F fn_;
+    };
+
+    // Creates the future handed back to Python; must be called with the GIL
+    std::pair<py::object, py::object> make_future() {
+        py::object loop = py::none();
+        try {
+            loop = py::module_::import("asyncio").attr("get_running_loop")();
+        } catch (py::error_already_set &) {
+            // No running loop: fall back to a thread-safe concurrent future
+        }
+        if (loop.is_none()) return { py::module_::import("concurrent.futures").attr("Future")(), loop };
+        return { loop.attr("create_future")(), loop };
+    }
+
+    // Sets a result or exception unless the caller already cancelled the future
+    void set_future(const py::object &future, const py::object &value, bool is_error) {
+        if (future.attr("done")().cast<bool>()) return;
+        future.attr(is_error ? "set_exception" : "set_result")(value);
+    }
+}
+
+AsyncStep::Op AsyncStep::parse_op(const std::string &name) {
+    static const std::unordered_map<std::string, Op> ops = {
+        { "add", Op::add }, { "sub", Op::sub }, { "multiply", Op::multiply }, { "square", Op::square },
+        { "negate", Op::negate }, { "add_plain", Op::add_plain }, { "sub_plain", Op::sub_plain },
+        { "multiply_plain", Op::multiply_plain }, { "relinearize", Op::relinearize },
+        { "rescale_to_next", Op::rescale_to_next }, { "mod_switch_to_next", Op::mod_switch_to_next },
+        { "rotate_vector", Op::rotate_vector }, { "rotate_rows", Op::rotate_rows },
+        { "rotate_columns", Op::rotate_columns }, { "complex_conjugate", Op::complex_conjugate }
+    };
+    auto it = ops.find(name);
+    if (it == ops.end()) throw std::invalid_argument("unknown operation: " + name);
+    return it->second;
+}
+
+void AsyncStep::apply(const Evaluator &evaluator, Ciphertext &encrypted) const {
+    switch (op) {
+    case Op::add: evaluator.add_inplace(encrypted, *ciphertext); break;
+    case Op::sub: evaluator.sub_inplace(encrypted, *ciphertext); break;
+    case Op::multiply: evaluator.multiply_inplace(encrypted, *ciphertext); break;
+    case Op::square: evaluator.square_inplace(encrypted); break;
+    case Op::negate: evaluator.negate_inplace(encrypted); break;
+    case Op::add_plain: evaluator.add_plain_inplace(encrypted, *plaintext); break;
+    case Op::sub_plain: evaluator.sub_plain_inplace(encrypted, *plaintext); break;
+    case Op::multiply_plain: evaluator.multiply_plain_inplace(encrypted, *plaintext); break;
+    case Op::relinearize: evaluator.relinearize_inplace(encrypted, *relin_keys); break;
+    case Op::rescale_to_next: evaluator.rescale_to_next_inplace(encrypted); break;
+    case Op::mod_switch_to_next: evaluator.mod_switch_to_next_inplace(encrypted); break;
+    case Op::rotate_vector: evaluator.rotate_vector_inplace(encrypted, steps, *galois_keys); break;
+    case Op::rotate_rows: evaluator.rotate_rows_inplace(encrypted, steps, *galois_keys); break;
+    case Op::rotate_columns: evaluator.rotate_columns_inplace(encrypted, *galois_keys); break;
+    case Op::complex_conjugate: evaluator.complex_conjugate_inplace(encrypted, *galois_keys); break;
+    }
+}
+
+AsyncEvaluator::AsyncEvaluator(std::shared_ptr<SEALContext> context, std::size_t threads)
+    : context_(std::move(context)), evaluator_(*context_), pool_(std::make_unique<ThreadPool>(threads)) {}
+
+AsyncEvaluator::~AsyncEvaluator() {
+    // Workers need the GIL to complete futures, so join them without it
+    py::gil_scoped_release release;
+    pool_.reset();
+}
+
+template <class T>
+py::object AsyncEvaluator::submit(std::vector<py::object> refs, std::function<T()> work) {
+    auto [future, loop] = make_future();
+    refs.push_back(future);
+    refs.push_back(loop);
+
+    // Python references are only copied or released while holding the GIL; the
+    // shared_ptr itself can be destroyed anywhere once the vector is cleared
+    auto held = std::make_shared<std::vector<py::object>>(std::move(refs));
+    pending_++;
+    total_pending++;
+
+    pool_->submit([this, held, work = std::move(work)]() {
+        // pending_ must reach zero on every path, or the atexit drain waits forever
+        ScopeExit done([this] { finished(); });
+        std::unique_ptr<T> result;
+        std::exception_ptr error;
+        try {
+            result = std::make_unique<T>(work());
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            py::gil_scoped_acquire gil;
+            ScopeExit release([&] {
+                result.reset();
+                held->clear();
+            });
+            try {
+                auto &future = (*held)[held->size() - 2];
+                auto &loop = (*held)[held->size() - 1];
+                py::object value = error ? to_python_exception(error) : py::cast(std::move(*result));
+                if (loop.is_none()) {
+                    set_future(future, value, static_cast<bool>(error));
+                } else {
+                    loop.attr("call_soon_threadsafe")(py::cpp_function(set_future), future, value, static_cast<bool>(error));
+                }
+            } catch (py::error_already_set &e) {
+                e.discard_as_unraisable(__func__);
+            } catch (...) {
+                // py::cast_error from the result, or a native failure in set_future
+                report_unraisable(std::current_exception(), __func__);
+            }
+        }
+    });
+    return future;
+}
+
+void AsyncEvaluator::finished() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        pending_--;
+    }
+    idle_cv_.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(total_mutex);
+        total_pending--;
+    }
+    total_cv.notify_all();
+}
+
+py::object AsyncEvaluator::run(const Ciphertext &encrypted, std::vector<AsyncStep> steps, std::vector<py::object> refs) {
+    const Ciphertext *input = &encrypted;
+    return submit<Ciphertext>(std::move(refs), [this, input, steps = std::move(steps)]() {
+        Ciphertext result = *input;
+        for (auto &step : steps) step.apply(evaluator_, result);
+        return result;
+    });
+}
+
+py::object AsyncEvaluator::encrypt(const Encryptor &encryptor, const Plaintext &plain, std::vector<py::object> refs) {
+    const Encryptor *enc = &encryptor;
+    const Plaintext *input = &plain;
+    return submit<Ciphertext>(std::move(refs), [enc, input]() {
+        Ciphertext result;
+        enc->encrypt(*input, result);
+        return result;
+    });
+}
+
+py::object AsyncEvaluator::decrypt(Decryptor &decryptor, const Ciphertext &encrypted, std::vector<py::object> refs) {
+    Decryptor *dec = &decryptor;
+    const Ciphertext *input = &encrypted;
+    return submit<Plaintext>(std::move(refs), [dec, input]() {
+        Plaintext result;
+        dec->decrypt(*input, result);
+        return result;
+    });
+}
+
+void AsyncEvaluator::wait_idle() {
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    idle_cv_.wait(lock, [this]() { return pending_.load() == 0; });
+}
+
+void AsyncEvaluator::drain_all() {
+    std::unique_lock<std::mutex> lock(total_mutex);
+    total_cv.wait(lock, []() { return total_pending.load() == 0; });
+}
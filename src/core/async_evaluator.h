@@ -0,0 +1,84 @@
+#pragma once
+#include "thread_pool.h"
+#include <seal/context.h>
+#include <seal/evaluator.h>
+#include <seal/encryptor.h>
+#include <seal/decryptor.h>
+#include <pybind11/pybind11.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+// One Evaluator operation applied in place to a running ciphertext. Operands
+// are borrowed; the Python objects owning them are kept alive by the task.
+struct AsyncStep {
+    enum class Op {
+        add, sub, multiply, square, negate,
+        add_plain, sub_plain, multiply_plain,
+        relinearize, rescale_to_next, mod_switch_to_next,
+        rotate_vector, rotate_rows, rotate_columns, complex_conjugate
+    };
+
+    Op op;
+    const seal::Ciphertext *ciphertext = nullptr;
+    const seal::Plaintext *plaintext = nullptr;
+    const seal::RelinKeys *relin_keys = nullptr;
+    const seal::GaloisKeys *galois_keys = nullptr;
+    int steps = 0;
+
+    static Op parse_op(const std::string &name);
+    void apply(const seal::Evaluator &evaluator, seal::Ciphertext &encrypted) const;
+};
+
+// Runs Evaluator/Encryptor/Decryptor work on a native thread pool and
+// completes Python futures from the worker threads. Inside a running asyncio
+// loop the futures are asyncio futures; otherwise concurrent.futures.Future.
+class AsyncEvaluator {
+public:
+    AsyncEvaluator(std::shared_ptr<seal::SEALContext> context, std::size_t threads = 0);
+
+    // Drains outstanding work with the GIL released
+    ~AsyncEvaluator();
+
+    const seal::Evaluator &evaluator() const noexcept { return evaluator_; }
+
+    // Copies encrypted and applies steps in order on one worker, without
+    // returning to Python between steps. refs keeps the operands alive.
+    py::object run(const seal::Ciphertext &encrypted, std::vector<AsyncStep> steps, std::vector<py::object> refs);
+
+    py::object encrypt(const seal::Encryptor &encryptor, const seal::Plaintext &plain, std::vector<py::object> refs);
+    py::object decrypt(seal::Decryptor &decryptor, const seal::Ciphertext &encrypted, std::vector<py::object> refs);
+
+    std::size_t threads() const noexcept { return pool_->size(); }
+    std::size_t queue_depth() const { return pool_->queue_depth(); }
+    std::size_t in_flight() const { return pool_->in_flight(); }
+
+    // Submitted operations whose future has not been completed yet
+    std::size_t pending() const noexcept { return pending_.load(); }
+
+    // Blocks (GIL released by the caller) until pending() == 0
+    void wait_idle();
+
+    // Blocks until every AsyncEvaluator in the process is idle; registered
+    // with atexit so no worker needs the GIL after finalization starts
+    static void drain_all();
+
+private:
+    template <class T>
+    py::object submit(std::vector<py::object> refs, std::function<T()> work);
+
+    void finished();
+
+    std::shared_ptr<seal::SEALContext> context_;
+    seal::Evaluator evaluator_;
+    std::unique_ptr<ThreadPool> pool_;
+    std::atomic<std::size_t> pending_{ 0 };
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+};
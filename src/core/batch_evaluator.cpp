@@ -0,0 +1,441 @@
+#include "batch_evaluator.h"
+#include "rns_kernels.h"
+#include <seal/util/polyarithsmallmod.h>
+#include <seal/util/uintarithsmallmod.h>
+#include <seal/util/ntt.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace seal;
+using namespace seal::util;
+
+namespace {
+    // Chunks smaller than this spend more time merging than multiplying
+    constexpr std::size_t min_dot_chunk = 4;
+
+    // The fused path works directly on NTT-form RNS limbs (CKKS and BGV). It
+    // needs every left operand to share metadata, and likewise every right one.
+    bool uniform_ntt_operands(const std::vector<const Ciphertext *> &cts) {
+        const Ciphertext &first = *cts.front();
+        if (!first.is_ntt_form() || first.size() != 2) return false;
+        return std::all_of(cts.begin(), cts.end(), [&first](const Ciphertext *ct) {
+            return ct->is_ntt_form() && ct->size() == 2 && ct->parms_id() == first.parms_id() &&
+                   ct->scale() == first.scale() && ct->correction_factor() == first.correction_factor();
+        });
+    }
+
+    bool uniform_ntt_plaintexts(const std::vector<const Plaintext *> &pts, const parms_id_type &parms_id) {
+        double scale = pts.front()->scale();
+        return std::all_of(pts.begin(), pts.end(), [&parms_id, scale](const Plaintext *pt) {
+            return pt->is_ntt_form() && pt->parms_id() == parms_id && pt->scale() == scale;
+        });
+    }
+
+    void check_operands(const std::vector<const Ciphertext *> &a, std::size_t other_size) {
+        if (a.empty()) throw std::invalid_argument("operands cannot be empty");
+        if (a.size() != other_size) throw std::invalid_argument("operand lists must have the same length");
+    }
+
+    template <class T>
+    void check_not_null(const std::vector<const T *> &operands) {
+        if (std::any_of(operands.begin(), operands.end(), [](const T *p) { return p == nullptr; })) {
+            throw std::invalid_argument("operands cannot contain None");
+        }
+    }
+
+    void check_scale(const SEALContext::ContextData &context_data, double scale) {
+        if (context_data.parms().scheme() == scheme_type::ckks &&
+            std::log2(scale) >= static_cast<double>(context_data.total_coeff_modulus_bit_count())) {
+            throw std::invalid_argument("scale out of bounds");
+        }
+    }
+
+    std::uint64_t reduce_signed(std::int64_t value, const Modulus &modulus) {
+        std::uint64_t magnitude = value < 0 ? std::uint64_t(0) - static_cast<std::uint64_t>(value)
+                                            : static_cast<std::uint64_t>(value);
+        std::uint64_t reduced = barrett_reduce_64(magnitude, modulus);
+        return (value < 0 && reduced) ? modulus.value() - reduced : reduced;
+    }
+
+    // Rounds a CKKS scaled value; larger magnitudes would need multi-word RNS
+    // decomposition, which the plaintext encoder already covers
+    std::int64_t round_scaled(double value, double scale) {
+        double scaled = std::round(value * scale);
+        if (!std::isfinite(scaled) || std::fabs(scaled) >= std::ldexp(1.0, 63)) {
+            throw std::invalid_argument("scalar is too large for the scale; use CKKSEncoder and multiply_plain");
+        }
+        return static_cast<std::int64_t>(scaled);
+    }
+
+    // Multiplies every polynomial of encrypted by a signed integer
+    void multiply_limbs(Ciphertext &encrypted, std::int64_t value, const EncryptionParameters &parms) {
+        auto &coeff_modulus = parms.coeff_modulus();
+        std::size_t coeff_count = parms.poly_modulus_degree();
+        for (std::size_t j = 0; j < coeff_modulus.size(); j++) {
+            std::uint64_t scalar = reduce_signed(value, coeff_modulus[j]);
+            for (std::size_t i = 0; i < encrypted.size(); i++) {
+                std::uint64_t *limb = encrypted.data(i) + j * coeff_count;
+                multiply_poly_scalar_coeffmod(limb, coeff_count, scalar, coeff_modulus[j], limb);
+            }
+        }
+    }
+
+    // Adds a signed constant to every NTT evaluation point of c0; in NTT form a
+    // constant polynomial is the same value at every point
+    void add_constant_ntt(Ciphertext &encrypted, std::int64_t value, const EncryptionParameters &parms) {
+        auto &coeff_modulus = parms.coeff_modulus();
+        std::size_t coeff_count = parms.poly_modulus_degree();
+        for (std::size_t j = 0; j < coeff_modulus.size(); j++) {
+            std::uint64_t constant = reduce_signed(value, coeff_modulus[j]);
+            std::uint64_t *limb = encrypted.data(0) + j * coeff_count;
+            for (std::size_t k = 0; k < coeff_count; k++) {
+                limb[k] = add_uint_mod(limb[k], constant, coeff_modulus[j]);
+            }
+        }
+    }
+
+    // Maps an integer to the balanced residue modulo the plain modulus so the
+    // noise grows by at most t / 2
+    std::int64_t balanced_plain_residue(std::int64_t value, const Modulus &plain_modulus) {
+        std::uint64_t residue = reduce_signed(value, plain_modulus);
+        if (residue > (plain_modulus.value() >> 1)) {
+            return -static_cast<std::int64_t>(plain_modulus.value() - residue);
+        }
+        return static_cast<std::int64_t>(residue);
+    }
+}
+
+BatchEvaluator::BatchEvaluator(std::shared_ptr<SEALContext> context, std::size_t threads)
+    : context_(std::move(context)), evaluator_(*context_) {
+    if (!context_->parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+    if (threads) own_pool_ = std::make_unique<ThreadPool>(threads);
+}
+
+Ciphertext BatchEvaluator::finish(std::vector<Ciphertext> &partials, const RelinKeys *relin_keys, bool rescale) const {
+    Ciphertext result = std::move(partials.front());
+    for (std::size_t i = 1; i < partials.size(); i++) {
+        evaluator_.add_inplace(result, partials[i]);
+    }
+    if (relin_keys && result.size() > 2) evaluator_.relinearize_inplace(result, *relin_keys);
+    if (rescale && context_->get_context_data(result.parms_id())->parms().scheme() == scheme_type::ckks) {
+        evaluator_.rescale_to_next_inplace(result);
+    }
+    return result;
+}
+
+Ciphertext BatchEvaluator::dot(const std::vector<const Ciphertext *> &a, const std::vector<const Ciphertext *> &b,
+                               const RelinKeys &relin_keys, bool rescale) const {
+    check_operands(a, b.size());
+    check_not_null(a);
+    check_not_null(b);
+
+    std::size_t chunks = std::min(threads(), (a.size() + min_dot_chunk - 1) / min_dot_chunk);
+    chunks = std::max<std::size_t>(1, chunks);
+    std::vector<Ciphertext> partials(chunks);
+    std::size_t per_chunk = (a.size() + chunks - 1) / chunks;
+
+    bool fused = uniform_ntt_operands(a) && uniform_ntt_operands(b) && a.front()->parms_id() == b.front()->parms_id();
+    if (fused) {
+        auto context_data = context_->get_context_data(a.front()->parms_id());
+        if (!context_data) throw std::invalid_argument("operands are not valid for encryption parameters");
+        auto &parms = context_data->parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        std::size_t coeff_count = parms.poly_modulus_degree();
+        double scale = a.front()->scale() * b.front()->scale();
+        check_scale(*context_data, scale);
+        std::uint64_t correction_factor = 1;
+        if (parms.scheme() == scheme_type::bgv) {
+            correction_factor = multiply_uint_mod(
+                a.front()->correction_factor(), b.front()->correction_factor(), parms.plain_modulus());
+        }
+
+        pool().parallel_for(chunks, [&](std::size_t begin_chunk, std::size_t end_chunk) {
+            std::vector<std::uint64_t> scratch(coeff_count);
+            for (std::size_t c = begin_chunk; c < end_chunk; c++) {
+                Ciphertext &acc = partials[c];
+                acc.resize(*context_, a.front()->parms_id(), 3);
+                std::fill_n(acc.data(), acc.dyn_array().size(), std::uint64_t(0));
+                acc.is_ntt_form() = true;
+                acc.scale() = scale;
+                acc.correction_factor() = correction_factor;
+
+                std::size_t end = std::min(a.size(), (c + 1) * per_chunk);
+                for (std::size_t i = c * per_chunk; i < end; i++) {
+                    const Ciphertext &x = *a[i];
+                    const Ciphertext &y = *b[i];
+                    multiply_accumulate(x.data(0), y.data(0), acc.data(0), coeff_count, coeff_modulus, scratch.data());
+                    multiply_accumulate(x.data(0), y.data(1), acc.data(1), coeff_count, coeff_modulus, scratch.data());
+                    multiply_accumulate(x.data(1), y.data(0), acc.data(1), coeff_count, coeff_modulus, scratch.data());
+                    multiply_accumulate(x.data(1), y.data(1), acc.data(2), coeff_count, coeff_modulus, scratch.data());
+                }
+            }
+        });
+    } else {
+        // BFV, or mixed metadata: let SEAL multiply, reusing one product buffer per chunk
+        pool().parallel_for(chunks, [&](std::size_t begin_chunk, std::size_t end_chunk) {
+            Ciphertext product;
+            for (std::size_t c = begin_chunk; c < end_chunk; c++) {
+                std::size_t end = std::min(a.size(), (c + 1) * per_chunk);
+                for (std::size_t i = c * per_chunk; i < end; i++) {
+                    if (i == c * per_chunk) {
+                        evaluator_.multiply(*a[i], *b[i], partials[c]);
+                    } else {
+                        evaluator_.multiply(*a[i], *b[i], product);
+                        evaluator_.add_inplace(partials[c], product);
+                    }
+                }
+            }
+        });
+    }
+
+    partials.resize(std::min(partials.size(), (a.size() + per_chunk - 1) / per_chunk));
+    return finish(partials, &relin_keys, rescale);
+}
+
+Ciphertext BatchEvaluator::dot_plain(const std::vector<const Ciphertext *> &cts, const std::vector<const Plaintext *> &pts,
+                                     bool rescale) const {
+    check_operands(cts, pts.size());
+    check_not_null(cts);
+    check_not_null(pts);
+
+    std::size_t chunks = std::min(threads(), (cts.size() + min_dot_chunk - 1) / min_dot_chunk);
+    chunks = std::max<std::size_t>(1, chunks);
+    std::vector<Ciphertext> partials(chunks);
+    std::size_t per_chunk = (cts.size() + chunks - 1) / chunks;
+
+    bool fused = uniform_ntt_operands(cts) && uniform_ntt_plaintexts(pts, cts.front()->parms_id());
+    if (fused) {
+        auto context_data = context_->get_context_data(cts.front()->parms_id());
+        if (!context_data) throw std::invalid_argument("operands are not valid for encryption parameters");
+        auto &parms = context_data->parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        std::size_t coeff_count = parms.poly_modulus_degree();
+        double scale = cts.front()->scale() * pts.front()->scale();
+        check_scale(*context_data, scale);
+
+        pool().parallel_for(chunks, [&](std::size_t begin_chunk, std::size_t end_chunk) {
+            std::vector<std::uint64_t> scratch(coeff_count);
+            for (std::size_t c = begin_chunk; c < end_chunk; c++) {
+                Ciphertext &acc = partials[c];
+                acc.resize(*context_, cts.front()->parms_id(), 2);
+                std::fill_n(acc.data(), acc.dyn_array().size(), std::uint64_t(0));
+                acc.is_ntt_form() = true;
+                acc.scale() = scale;
+                acc.correction_factor() = cts.front()->correction_factor();
+
+                std::size_t end = std::min(cts.size(), (c + 1) * per_chunk);
+                for (std::size_t i = c * per_chunk; i < end; i++) {
+                    const std::uint64_t *p = pts[i]->data();
+                    multiply_accumulate(cts[i]->data(0), p, acc.data(0), coeff_count, coeff_modulus, scratch.data());
+                    multiply_accumulate(cts[i]->data(1), p, acc.data(1), coeff_count, coeff_modulus, scratch.data());
+                }
+            }
+        });
+    } else {
+        pool().parallel_for(chunks, [&](std::size_t begin_chunk, std::size_t end_chunk) {
+            Ciphertext product;
+            for (std::size_t c = begin_chunk; c < end_chunk; c++) {
+                std::size_t end = std::min(cts.size(), (c + 1) * per_chunk);
+                for (std::size_t i = c * per_chunk; i < end; i++) {
+                    if (i == c * per_chunk) {
+                        evaluator_.multiply_plain(*cts[i], *pts[i], partials[c]);
+                    } else {
+                        evaluator_.multiply_plain(*cts[i], *pts[i], product);
+                        evaluator_.add_inplace(partials[c], product);
+                    }
+                }
+            }
+        });
+    }
+
+    partials.resize(std::min(partials.size(), (cts.size() + per_chunk - 1) / per_chunk));
+    return finish(partials, nullptr, rescale);
+}
+
+const SEALContext::ContextData &BatchEvaluator::context_data_for(const Ciphertext &encrypted) const {
+    auto context_data = context_->get_context_data(encrypted.parms_id());
+    if (!context_data) throw std::invalid_argument("encrypted is not valid for encryption parameters");
+    if (encrypted.size() < 2) throw std::invalid_argument("encrypted is empty");
+    return *context_data;
+}
+
+void BatchEvaluator::multiply_integer(Ciphertext &encrypted, std::int64_t value) const {
+    auto &parms = context_data_for(encrypted).parms();
+    if (parms.scheme() != scheme_type::ckks) value = balanced_plain_residue(value, parms.plain_modulus());
+    multiply_limbs(encrypted, value, parms);
+}
+
+void BatchEvaluator::multiply_scalar(Ciphertext &encrypted, double value, double scale_factor) const {
+    auto &context_data = context_data_for(encrypted);
+    auto &parms = context_data.parms();
+    if (parms.scheme() != scheme_type::ckks) throw std::logic_error("multiply_scalar requires CKKS; use multiply_integer");
+    if (scale_factor == 0) scale_factor = static_cast<double>(parms.coeff_modulus().back().value());
+    if (scale_factor < 1) throw std::invalid_argument("scale_factor must be at least 1");
+
+    double new_scale = encrypted.scale() * scale_factor;
+    check_scale(context_data, new_scale);
+    multiply_limbs(encrypted, round_scaled(value, scale_factor), parms);
+    encrypted.scale() = new_scale;
+}
+
+void BatchEvaluator::add_scalar(Ciphertext &encrypted, double value) const {
+    auto &parms = context_data_for(encrypted).parms();
+    if (parms.scheme() != scheme_type::ckks) throw std::logic_error("add_scalar requires CKKS; use add_integer");
+    if (!encrypted.is_ntt_form()) throw std::invalid_argument("CKKS encrypted must be in NTT form");
+    add_constant_ntt(encrypted, round_scaled(value, encrypted.scale()), parms);
+}
+
+void BatchEvaluator::add_integer(Ciphertext &encrypted, std::int64_t value) const {
+    auto &parms = context_data_for(encrypted).parms();
+    switch (parms.scheme()) {
+    case scheme_type::ckks:
+        add_scalar(encrypted, static_cast<double>(value));
+        break;
+    case scheme_type::bgv: {
+        // BGV adds the message multiplied by the correction factor, as add_plain does
+        auto &t = parms.plain_modulus();
+        std::uint64_t message = multiply_uint_mod(reduce_signed(value, t), encrypted.correction_factor(), t);
+        add_constant_ntt(encrypted, static_cast<std::int64_t>(message), parms);
+        break;
+    }
+    default: {
+        // BFV needs the Delta scaling; a one-coefficient plaintext keeps add_plain O(1)
+        Plaintext constant(1);
+        constant[0] = reduce_signed(value, parms.plain_modulus());
+        evaluator_.add_plain_inplace(encrypted, constant);
+        break;
+    }
+    }
+}
+
+void BatchEvaluator::multiply_integer_batch(const std::vector<Ciphertext *> &cts, const std::vector<std::int64_t> &values) const {
+    if (cts.size() != values.size()) throw std::invalid_argument("cts and values must have the same length");
+    check_not_null(std::vector<const Ciphertext *>(cts.begin(), cts.end()));
+    pool().parallel_for(cts.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) multiply_integer(*cts[i], values[i]);
+    });
+}
+
+void BatchEvaluator::multiply_scalar_batch(const std::vector<Ciphertext *> &cts, const std::vector<double> &values,
+                                           double scale_factor) const {
+    if (cts.size() != values.size()) throw std::invalid_argument("cts and values must have the same length");
+    check_not_null(std::vector<const Ciphertext *>(cts.begin(), cts.end()));
+    pool().parallel_for(cts.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) multiply_scalar(*cts[i], values[i], scale_factor);
+    });
+}
+
+void BatchEvaluator::add_scalar_batch(const std::vector<Ciphertext *> &cts, const std::vector<double> &values) const {
+    if (cts.size() != values.size()) throw std::invalid_argument("cts and values must have the same length");
+    check_not_null(std::vector<const Ciphertext *>(cts.begin(), cts.end()));
+    pool().parallel_for(cts.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) add_scalar(*cts[i], values[i]);
+    });
+}
+
+Ciphertext BatchEvaluator::align(const Ciphertext &encrypted, const parms_id_type &parms_id, double scale,
+                                 double value) const {
+    auto context_data = context_->get_context_data(parms_id);
+    auto above = context_data ? context_data->prev_context_data() : nullptr;
+    if (!above) throw std::invalid_argument("parms_id is not a level of the context below the top");
+    double prime = static_cast<double>(above->parms().coeff_modulus().back().value());
+    Ciphertext result;
+    evaluator_.mod_switch_to(encrypted, above->parms_id(), result);
+    multiply_scalar(result, value, scale * prime / result.scale());
+    evaluator_.rescale_to_next_inplace(result);
+    result.scale() = scale;
+    return result;
+}
+
+void BatchEvaluator::power_ladder(std::size_t degree, const std::function<void(std::size_t, std::size_t)> &step) const {
+    for (std::size_t top = 2; top / 2 < degree; top *= 2) {
+        std::size_t first = top / 2 + 1, last = std::min(top, degree), a = top / 2;
+        pool().parallel_for(last - first + 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = first + begin; k < first + end; k++) step(k, a);
+        });
+    }
+}
+
+Ciphertext BatchEvaluator::linear_combination(const std::vector<Ciphertext> &powers, const std::vector<double> &coeffs,
+                                              const parms_id_type &parms_id, double scale) const {
+    if (coeffs.empty()) throw std::invalid_argument("coeffs must not be empty");
+    if (powers.size() < coeffs.size()) throw std::invalid_argument("powers must cover every coefficient");
+    std::size_t degree = coeffs.size() - 1;
+    std::vector<Ciphertext> terms(degree + 1);
+    pool().parallel_for(degree, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin + 1; k < end + 1; k++) {
+            if (coeffs[k] != 0) terms[k] = align(powers[k], parms_id, scale, coeffs[k]);
+        }
+    });
+    Ciphertext result;
+    bool first = true;
+    for (std::size_t k = 1; k <= degree; k++) {
+        if (coeffs[k] == 0) continue;
+        if (first) {
+            result = std::move(terms[k]);
+            first = false;
+        } else {
+            evaluator_.add_inplace(result, terms[k]);
+        }
+    }
+    if (first) throw std::invalid_argument("coeffs has no nonzero term above degree 0");
+    if (coeffs[0] != 0) add_scalar(result, coeffs[0]);
+    return result;
+}
+
+void BatchEvaluator::multiply_by_i(Ciphertext &encrypted) const {
+    auto &context_data = context_data_for(encrypted);
+    auto &parms = context_data.parms();
+    if (parms.scheme() != scheme_type::ckks) throw std::logic_error("multiply_by_i requires CKKS");
+    if (!encrypted.is_ntt_form()) throw std::invalid_argument("CKKS encrypted must be in NTT form");
+
+    // Slot j sits at the root w^(3^j), where X^(N/2) evaluates to i for even j
+    // but -i for odd j. X^(N/4) + X^(3N/4) evaluates to i * sqrt(2) at every
+    // root, so multiplying by it in NTT form (a dyadic product with its
+    // transform) and folding sqrt(2) into the scale multiplies every slot by i
+    auto &coeff_modulus = parms.coeff_modulus();
+    std::size_t coeff_count = parms.poly_modulus_degree();
+    auto ntt_tables = context_data.small_ntt_tables();
+    double new_scale = encrypted.scale() * std::sqrt(2.0);
+    check_scale(context_data, new_scale);
+    std::vector<std::uint64_t> binomial(coeff_count);
+    for (std::size_t j = 0; j < coeff_modulus.size(); j++) {
+        std::fill(binomial.begin(), binomial.end(), std::uint64_t(0));
+        binomial[coeff_count / 4] = 1;
+        binomial[3 * coeff_count / 4] = 1;
+        ntt_negacyclic_harvey(binomial.data(), ntt_tables[j]);
+        for (std::size_t i = 0; i < encrypted.size(); i++) {
+            std::uint64_t *limb = encrypted.data(i) + j * coeff_count;
+            dyadic_product_coeffmod(limb, binomial.data(), coeff_count, coeff_modulus[j], limb);
+        }
+    }
+    encrypted.scale() = new_scale;
+}
+
+std::pair<Ciphertext, Ciphertext> BatchEvaluator::separate_pair(const Ciphertext &encrypted, const GaloisKeys &galois_keys,
+                                                                bool rescale) const {
+    Ciphertext conjugate;
+    evaluator_.complex_conjugate(encrypted, galois_keys, conjugate);
+
+    // z + conj(z) = 2x and -i * (z - conj(z)) = 2y
+    Ciphertext real, imag;
+    evaluator_.add(encrypted, conjugate, real);
+    evaluator_.sub(encrypted, conjugate, imag);
+    multiply_by_i(imag);
+    evaluator_.negate_inplace(imag);
+
+    if (rescale) {
+        // imag carries the extra sqrt(2) of multiply_by_i; the scale factor
+        // removes it so both halves rescale back to the input scale
+        double last_prime = static_cast<double>(context_data_for(imag).parms().coeff_modulus().back().value());
+        multiply_scalar(real, 0.5);
+        multiply_scalar(imag, 0.5, last_prime / std::sqrt(2.0));
+        evaluator_.rescale_to_next_inplace(real);
+        evaluator_.rescale_to_next_inplace(imag);
+    } else {
+        real.scale() *= 2;
+        imag.scale() *= 2;
+    }
+    return { std::move(real), std::move(imag) };
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "thread_pool.h"
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/plaintext.h>
+#include <seal/relinkeys.h>
+#include <seal/galoiskeys.h>
+#include <seal/evaluator.h>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Native batched kernels over lists of ciphertexts. Work is split into chunks
+// on a ThreadPool; each chunk accumulates into a single partial result so no
+// per-term temporaries are allocated.
+class BatchEvaluator {
+public:
+    // threads == 0 shares the process-wide pool
+    explicit BatchEvaluator(std::shared_ptr<seal::SEALContext> context, std::size_t threads = 0);
+
+    const seal::SEALContext &context() const noexcept { return *context_; }
+    const seal::Evaluator &evaluator() const noexcept { return evaluator_; }
+    ThreadPool &pool() const noexcept { return own_pool_ ? *own_pool_ : ThreadPool::Global(); }
+    std::size_t threads() const noexcept { return pool().size(); }
+
+    // Sum of a[i] * b[i]. Products stay at size 3 and are accumulated in place;
+    // relinearization (and the CKKS rescale when rescale is true) runs once on
+    // the final sum.
+    seal::Ciphertext dot(const std::vector<const seal::Ciphertext *> &a,
+                         const std::vector<const seal::Ciphertext *> &b,
+                         const seal::RelinKeys &relin_keys, bool rescale = true) const;
+
+    // Sum of cts[i] * pts[i] with a single CKKS rescale at the end.
+    seal::Ciphertext dot_plain(const std::vector<const seal::Ciphertext *> &cts,
+                               const std::vector<const seal::Plaintext *> &pts, bool rescale = true) const;
+
+    // Scalar operations applied directly to the RNS limbs, without encoding a
+    // plaintext. multiply_integer consumes no level; for BFV/BGV the integer is
+    // reduced modulo the plain modulus first.
+    void multiply_integer(seal::Ciphertext &encrypted, std::int64_t value) const;
+
+    // CKKS: multiplies by round(value * scale_factor) and multiplies the scale by
+    // scale_factor. scale_factor == 0 uses the last prime at the ciphertext's
+    // level, so a following rescale restores the original scale exactly.
+    void multiply_scalar(seal::Ciphertext &encrypted, double value, double scale_factor = 0) const;
+
+    // CKKS: adds value to every slot
+    void add_scalar(seal::Ciphertext &encrypted, double value) const;
+
+    // Adds an integer to every slot (all schemes)
+    void add_integer(seal::Ciphertext &encrypted, std::int64_t value) const;
+
+    // Batched forms: element i of values is applied to cts[i], in parallel
+    void multiply_integer_batch(const std::vector<seal::Ciphertext *> &cts, const std::vector<std::int64_t> &values) const;
+    void multiply_scalar_batch(const std::vector<seal::Ciphertext *> &cts, const std::vector<double> &values,
+                               double scale_factor = 0) const;
+    void add_scalar_batch(const std::vector<seal::Ciphertext *> &cts, const std::vector<double> &values) const;
+
+    // CKKS polynomials over a power basis whose ciphertexts sit at a fixed
+    // scale per level
+
+    // Brings encrypted to parms_id with exactly the given scale while
+    // multiplying it by value; uses one rescale, so encrypted must start
+    // above parms_id
+    seal::Ciphertext align(const seal::Ciphertext &encrypted, const seal::parms_id_type &parms_id, double scale,
+                           double value = 1.0) const;
+
+    // Calls step(k, a) for 2 <= k <= degree with a the largest power of two
+    // below k, so power k can be built from powers a and k - a. Each run up
+    // to the next power of two is parallel and waits for the one before.
+    void power_ladder(std::size_t degree, const std::function<void(std::size_t, std::size_t)> &step) const;
+
+    // coeffs[0] plus coeffs[k] * powers[k] for every nonzero coeffs[k],
+    // k >= 1, with each term aligned to parms_id and scale
+    seal::Ciphertext linear_combination(const std::vector<seal::Ciphertext> &powers, const std::vector<double> &coeffs,
+                                        const seal::parms_id_type &parms_id, double scale) const;
+
+    // CKKS real-pair packing: x + i*y carries two real vectors in one
+    // ciphertext. Addition, rotation and multiplication by real plaintexts act
+    // on both halves at once; ciphertext-ciphertext products do not.
+
+    // Multiplies every slot by the imaginary unit; no level or key-switch is
+    // consumed, but the scale grows by a factor sqrt(2)
+    void multiply_by_i(seal::Ciphertext &encrypted) const;
+
+    // Splits x + i*y into encryptions of x and y using one conjugation. With
+    // rescale false the factor 1/2 is folded into the scale (results carry twice
+    // the input scale, and the imaginary half another sqrt(2) from
+    // multiply_by_i; no level used); with rescale true it is applied with
+    // multiply_scalar + rescale_to_next so both keep the original scale.
+    std::pair<seal::Ciphertext, seal::Ciphertext> separate_pair(const seal::Ciphertext &encrypted,
+                                                                const seal::GaloisKeys &galois_keys,
+                                                                bool rescale = false) const;
+
+private:
+    const seal::SEALContext::ContextData &context_data_for(const seal::Ciphertext &encrypted) const;
+
+    // Adds partial sums together and applies the deferred relinearize/rescale
+    seal::Ciphertext finish(std::vector<seal::Ciphertext> &partials, const seal::RelinKeys *relin_keys,
+                            bool rescale) const;
+
+    std::shared_ptr<seal::SEALContext> context_;
+    seal::Evaluator evaluator_;
+    std::unique_ptr<ThreadPool> own_pool_;
+};
@@ -0,0 +1,117 @@
+#include "bind_async.h"
+#include "async_evaluator.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    // Turns [("multiply", ct), ("relinearize", rk), "rescale_to_next", ...]
+    // into native steps, collecting every operand so it outlives the task
+    py::object run_chain(AsyncEvaluator &self, const py::object &encrypted, const py::sequence &steps) {
+        std::vector<py::object> refs{ encrypted };
+        std::vector<AsyncStep> parsed;
+        for (auto item : steps) {
+            py::tuple spec = py::isinstance<py::str>(item) ? py::make_tuple(item) : py::tuple(py::reinterpret_borrow<py::object>(item));
+            if (spec.size() == 0) throw std::invalid_argument("empty chain step");
+
+            AsyncStep step;
+            step.op = AsyncStep::parse_op(spec[0].cast<std::string>());
+            auto operand = [&spec, &refs](std::size_t index) -> py::object {
+                if (spec.size() <= index) throw std::invalid_argument("chain step is missing an operand");
+                refs.push_back(spec[index]);
+                return refs.back();
+            };
+
+            switch (step.op) {
+            case AsyncStep::Op::add:
+            case AsyncStep::Op::sub:
+            case AsyncStep::Op::multiply:
+                step.ciphertext = &operand(1).cast<const Ciphertext &>();
+                break;
+            case AsyncStep::Op::add_plain:
+            case AsyncStep::Op::sub_plain:
+            case AsyncStep::Op::multiply_plain:
+                step.plaintext = &operand(1).cast<const Plaintext &>();
+                break;
+            case AsyncStep::Op::relinearize:
+                step.relin_keys = &operand(1).cast<const RelinKeys &>();
+                break;
+            case AsyncStep::Op::rotate_vector:
+            case AsyncStep::Op::rotate_rows:
+                step.steps = operand(1).cast<int>();
+                step.galois_keys = &operand(2).cast<const GaloisKeys &>();
+                break;
+            case AsyncStep::Op::rotate_columns:
+            case AsyncStep::Op::complex_conjugate:
+                step.galois_keys = &operand(1).cast<const GaloisKeys &>();
+                break;
+            default:
+                break;
+            }
+            parsed.push_back(step);
+        }
+        return self.run(encrypted.cast<const Ciphertext &>(), std::move(parsed), std::move(refs));
+    }
+
+    py::object run_one(AsyncEvaluator &self, const py::object &encrypted, const char *op, const py::tuple &operands) {
+        py::list spec;
+        spec.append(py::str(op));
+        for (auto operand : operands) spec.append(operand);
+        py::list steps;
+        steps.append(py::tuple(spec));
+        return run_chain(self, encrypted, steps);
+    }
+}
+
+void bind_async(py::module &m) {
+    py::class_<AsyncEvaluator>(m, "AsyncEvaluator")
+        .def(py::init<std::shared_ptr<SEALContext>, std::size_t>(), py::arg("context"), py::arg("threads") = 0,
+            "Creates an AsyncEvaluator with its own native thread pool (threads=0 uses all cores). "
+            "Methods return futures: asyncio futures inside a running loop, concurrent.futures.Future otherwise.")
+
+        // Dependent operations run back to back on one worker
+        .def("chain_async", &run_chain, py::arg("encrypted"), py::arg("steps"),
+            "Applies steps such as [('multiply', ct), ('relinearize', relin_keys), 'rescale_to_next'] "
+            "to a copy of encrypted without returning to Python between steps.")
+
+        // Single operations (out-of-place; the result is the future's value)
+        .def("add_async", [](AsyncEvaluator &self, py::object a, py::object b) { return run_one(self, a, "add", py::make_tuple(b)); })
+        .def("sub_async", [](AsyncEvaluator &self, py::object a, py::object b) { return run_one(self, a, "sub", py::make_tuple(b)); })
+        .def("multiply_async", [](AsyncEvaluator &self, py::object a, py::object b) { return run_one(self, a, "multiply", py::make_tuple(b)); })
+        .def("square_async", [](AsyncEvaluator &self, py::object a) { return run_one(self, a, "square", py::tuple()); })
+        .def("negate_async", [](AsyncEvaluator &self, py::object a) { return run_one(self, a, "negate", py::tuple()); })
+        .def("add_plain_async", [](AsyncEvaluator &self, py::object a, py::object b) { return run_one(self, a, "add_plain", py::make_tuple(b)); })
+        .def("sub_plain_async", [](AsyncEvaluator &self, py::object a, py::object b) { return run_one(self, a, "sub_plain", py::make_tuple(b)); })
+        .def("multiply_plain_async", [](AsyncEvaluator &self, py::object a, py::object b) { return run_one(self, a, "multiply_plain", py::make_tuple(b)); })
+        .def("relinearize_async", [](AsyncEvaluator &self, py::object a, py::object relin_keys) { return run_one(self, a, "relinearize", py::make_tuple(relin_keys)); })
+        .def("rescale_to_next_async", [](AsyncEvaluator &self, py::object a) { return run_one(self, a, "rescale_to_next", py::tuple()); })
+        .def("mod_switch_to_next_async", [](AsyncEvaluator &self, py::object a) { return run_one(self, a, "mod_switch_to_next", py::tuple()); })
+        .def("rotate_vector_async", [](AsyncEvaluator &self, py::object a, py::object steps, py::object galois_keys) { return run_one(self, a, "rotate_vector", py::make_tuple(steps, galois_keys)); })
+        .def("rotate_rows_async", [](AsyncEvaluator &self, py::object a, py::object steps, py::object galois_keys) { return run_one(self, a, "rotate_rows", py::make_tuple(steps, galois_keys)); })
+        .def("rotate_columns_async", [](AsyncEvaluator &self, py::object a, py::object galois_keys) { return run_one(self, a, "rotate_columns", py::make_tuple(galois_keys)); })
+        .def("complex_conjugate_async", [](AsyncEvaluator &self, py::object a, py::object galois_keys) { return run_one(self, a, "complex_conjugate", py::make_tuple(galois_keys)); })
+
+        // Encryption and decryption
+        .def("encrypt_async", [](AsyncEvaluator &self, py::object encryptor, py::object plain) {
+            return self.encrypt(encryptor.cast<const Encryptor &>(), plain.cast<const Plaintext &>(), { encryptor, plain });
+        }, py::arg("encryptor"), py::arg("plain"))
+        .def("decrypt_async", [](AsyncEvaluator &self, py::object decryptor, py::object encrypted) {
+            return self.decrypt(decryptor.cast<Decryptor &>(), encrypted.cast<const Ciphertext &>(), { decryptor, encrypted });
+        }, py::arg("decryptor"), py::arg("encrypted"))
+
+        // Backpressure
+        .def("threads", &AsyncEvaluator::threads)
+        .def("queue_depth", &AsyncEvaluator::queue_depth, "Returns the number of tasks waiting for a worker.")
+        .def("in_flight", &AsyncEvaluator::in_flight, "Returns the number of tasks running on a worker.")
+        .def("pending", &AsyncEvaluator::pending, "Returns the number of futures not completed yet.")
+        .def("wait_idle", &AsyncEvaluator::wait_idle, py::call_guard<py::gil_scoped_release>(),
+            "Blocks until every submitted operation has completed.");
+
+    // Workers complete futures under the GIL, so let them finish before finalization
+    py::module_::import("atexit").attr("register")(py::cpp_function([]() {
+        py::gil_scoped_release release;
+        AsyncEvaluator::drain_all();
+    }));
+}
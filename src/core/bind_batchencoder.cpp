@@ -1,4 +1,5 @@
 // bind_batchencoder.cpp
+#include "object_pool.h"
 #include <seal/batchencoder.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -48,5 +49,11 @@ void bind_batchencoder(py::module &m) {
             Plaintext plain;
             encoder.encode(values, plain);
             return plain;
-        });
+        })
+        .def("encode_new", [](const BatchEncoder &encoder, const std::vector<std::uint64_t> &values, PlaintextPool &pool) {
+            auto plain = pool.acquire();
+            encoder.encode(values, *plain);
+            return plain;
+        }, py::arg("values"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>(),
+            "Encodes into a Plaintext acquired from pool; release it back when done.");
 }
@@ -0,0 +1,71 @@
+#include "bind_batchevaluator.h"
+#include "batch_evaluator.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+void bind_batchevaluator(py::module &m) {
+    py::class_<BatchEvaluator, std::shared_ptr<BatchEvaluator>>(m, "BatchEvaluator")
+        .def(py::init<std::shared_ptr<SEALContext>, std::size_t>(), py::arg("context"), py::arg("threads") = 0,
+            "Creates a BatchEvaluator; threads=0 shares the process-wide native worker pool.")
+
+        .def("threads", &BatchEvaluator::threads,
+            "Returns the number of native worker threads.")
+
+        // Fused inner products; the GIL is released while the workers run
+        .def("dot", [](const BatchEvaluator &self, const std::vector<const Ciphertext *> &cts_a,
+                       const std::vector<const Ciphertext *> &cts_b, const RelinKeys &relin_keys, bool rescale) {
+            py::gil_scoped_release release;
+            return self.dot(cts_a, cts_b, relin_keys, rescale);
+        }, py::arg("cts_a"), py::arg("cts_b"), py::arg("relin_keys"), py::arg("rescale") = true,
+            "Returns sum(cts_a[i] * cts_b[i]) with one relinearization and, for CKKS, one rescale.")
+
+        .def("dot_plain", [](const BatchEvaluator &self, const std::vector<const Ciphertext *> &cts,
+                             const std::vector<const Plaintext *> &pts, bool rescale) {
+            py::gil_scoped_release release;
+            return self.dot_plain(cts, pts, rescale);
+        }, py::arg("cts"), py::arg("pts"), py::arg("rescale") = true,
+            "Returns sum(cts[i] * pts[i]) with, for CKKS, one rescale.")
+
+        // Scalar operations on the RNS limbs (in place, no plaintext encoding)
+        .def("multiply_integer", &BatchEvaluator::multiply_integer, py::arg("encrypted"), py::arg("value"),
+            "Multiplies every slot by an integer without consuming a level.")
+        .def("multiply_scalar", &BatchEvaluator::multiply_scalar, py::arg("encrypted"), py::arg("value"),
+            py::arg("scale_factor") = 0.0,
+            "CKKS: multiplies every slot by value, scaled by scale_factor (default: the last prime, "
+            "so rescale_to_next restores the original scale).")
+        .def("add_scalar", &BatchEvaluator::add_integer, py::arg("encrypted"), py::arg("value"),
+            "Adds an integer to every slot.")
+        .def("add_scalar", &BatchEvaluator::add_scalar, py::arg("encrypted"), py::arg("value"),
+            "CKKS: adds a real value to every slot.")
+
+        .def("multiply_integer_batch", [](const BatchEvaluator &self, const std::vector<Ciphertext *> &cts,
+                                          const std::vector<std::int64_t> &values) {
+            py::gil_scoped_release release;
+            self.multiply_integer_batch(cts, values);
+        }, py::arg("cts"), py::arg("values"))
+        .def("multiply_scalar_batch", [](const BatchEvaluator &self, const std::vector<Ciphertext *> &cts,
+                                         const std::vector<double> &values, double scale_factor) {
+            py::gil_scoped_release release;
+            self.multiply_scalar_batch(cts, values, scale_factor);
+        }, py::arg("cts"), py::arg("values"), py::arg("scale_factor") = 0.0)
+        .def("add_scalar_batch", [](const BatchEvaluator &self, const std::vector<Ciphertext *> &cts,
+                                    const std::vector<double> &values) {
+            py::gil_scoped_release release;
+            self.add_scalar_batch(cts, values);
+        }, py::arg("cts"), py::arg("values"))
+
+        // CKKS real-pair packing helpers
+        .def("multiply_by_i", &BatchEvaluator::multiply_by_i, py::arg("encrypted"),
+            "CKKS: multiplies every slot by the imaginary unit in place, without using a level. The scale grows "
+            "by a factor sqrt(2).")
+        .def("separate_pair", [](const BatchEvaluator &self, const Ciphertext &encrypted, const GaloisKeys &galois_keys, bool rescale) {
+            py::gil_scoped_release release;
+            return self.separate_pair(encrypted, galois_keys, rescale);
+        }, py::arg("encrypted"), py::arg("galois_keys"), py::arg("rescale") = false,
+            "CKKS: splits a pair-packed ciphertext into (real, imag) ciphertexts. With rescale=False "
+            "the results carry twice the input scale (imag another factor sqrt(2)); with rescale=True they keep "
+            "it one level lower.");
+}
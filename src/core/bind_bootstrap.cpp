@@ -0,0 +1,98 @@
+#include "bind_bootstrap.h"
+#include "ckks_bootstrap.h"
+#include "context_registry.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    py::dict timings_dict(const CKKSBootstrapper::Timings &timings) {
+        py::dict result;
+        result["mod_raise"] = timings.mod_raise;
+        result["coeff_to_slot"] = timings.coeff_to_slot;
+        result["eval_mod"] = timings.eval_mod;
+        result["slot_to_coeff"] = timings.slot_to_coeff;
+        result["total"] = timings.total;
+        return result;
+    }
+}
+
+void bind_bootstrap(py::module &m) {
+    m.def("sparse_secret_key", [](const SEALContext &context, std::size_t hamming_weight) {
+        py::gil_scoped_release release;
+        return sparse_secret_key(context, hamming_weight);
+    }, py::arg("context"), py::arg("hamming_weight"),
+        "Returns a secret key with exactly hamming_weight nonzero (+-1) coefficients for "
+        "KeyGenerator(context, secret_key). Sparse secrets keep bootstrapping shallow but lower security.");
+
+    py::class_<CKKSBootstrapper, std::shared_ptr<CKKSBootstrapper>>(m, "CKKSBootstrapper")
+        .def(py::init([](std::shared_ptr<SEALContext> context, std::size_t cts_levels, std::size_t stc_levels,
+                         double k_range, std::size_t degree, std::size_t double_angle, std::size_t threads) {
+            CKKSBootstrapper::Config config;
+            config.cts_levels = cts_levels;
+            config.stc_levels = stc_levels;
+            config.k_range = k_range;
+            config.degree = degree;
+            config.double_angle = double_angle;
+            py::gil_scoped_release release;
+            return std::make_shared<CKKSBootstrapper>(context, config, threads);
+        }), py::arg("context"), py::arg("cts_levels") = 3, py::arg("stc_levels") = 3, py::arg("k_range") = 16.0,
+            py::arg("degree") = 0, py::arg("double_angle") = 3, py::arg("threads") = 0,
+            "Pre-encodes CoeffToSlot and SlotToCoeff with cts_levels / stc_levels levels each. k_range bounds "
+            "the multiple of q0 removed by EvalMod (about 4.5 * sqrt(h / 12) + 1 for sparse_secret_key weight "
+            "h); degree 0 picks the Chebyshev degree automatically. Raises ValueError when the modulus chain is "
+            "shorter than depth.")
+
+        .def("galois_steps", &CKKSBootstrapper::galois_steps,
+            "Returns the rotation steps of both linear transforms.")
+        .def("galois_elements", &CKKSBootstrapper::galois_elements,
+            "Returns the Galois elements bootstrap() needs, conjugation included; pass them to "
+            "KeyGenerator.create_galois_keys_from_elts.")
+
+        .def_property_readonly("depth", &CKKSBootstrapper::depth)
+        .def_property_readonly("eval_mod_degree", &CKKSBootstrapper::eval_mod_degree)
+        .def_property_readonly("eval_mod_depth", &CKKSBootstrapper::eval_mod_depth)
+        .def_property_readonly("output_level", &CKKSBootstrapper::output_level)
+        .def_property_readonly("output_parms_id", [](const CKKSBootstrapper &self) {
+            return parms_id_to_bytes(self.output_parms_id());
+        })
+
+        .def("bootstrap", [](const CKKSBootstrapper &self, const Ciphertext &encrypted, const RelinKeys &relin_keys,
+                             const GaloisKeys &galois_keys) {
+            py::gil_scoped_release release;
+            return self.bootstrap(encrypted, relin_keys, galois_keys);
+        }, py::arg("encrypted"), py::arg("relin_keys"), py::arg("galois_keys"),
+            "Returns a relinearized ciphertext at any level refreshed to output_level with the same scale and "
+            "slots.")
+        .def("measure", [](const CKKSBootstrapper &self, const Ciphertext &encrypted, const RelinKeys &relin_keys,
+                           const GaloisKeys &galois_keys, Decryptor &decryptor) {
+            Ciphertext destination;
+            CKKSBootstrapper::Report report;
+            {
+                py::gil_scoped_release release;
+                report = self.measure(encrypted, relin_keys, galois_keys, decryptor, destination);
+            }
+            py::dict result;
+            result["timings"] = timings_dict(report.timings);
+            result["input_level"] = report.input_level;
+            result["output_level"] = report.output_level;
+            result["max_error"] = report.max_error;
+            result["mean_error"] = report.mean_error;
+            result["precision_bits"] = report.precision_bits;
+            return py::make_tuple(destination, result);
+        }, py::arg("encrypted"), py::arg("relin_keys"), py::arg("galois_keys"), py::arg("decryptor"),
+            "Bootstraps and returns (result, report): per-phase seconds, levels, and the max / mean slot error "
+            "between the decryptions before and after with the precision in bits.")
+
+        .def("stats", [](const CKKSBootstrapper &self) {
+            auto stats = self.stats();
+            py::dict result;
+            result["bootstraps"] = stats.bootstraps;
+            result["last"] = timings_dict(stats.last);
+            result["total"] = timings_dict(stats.total);
+            return result;
+        }, "Returns the bootstrap count and the per-phase seconds of the last bootstrap and of all of them.")
+        .def("reset_stats", &CKKSBootstrapper::reset_stats);
+}
@@ -1,4 +1,7 @@
 #include "bind_ciphertext.h"
+#include "bind_pickle.h"
+#include "context_registry.h"
+#include "bind_memo.h"
 #include <seal/ciphertext.h>
 #include <pybind11/pybind11.h>
 #include <fstream>
@@ -42,5 +45,16 @@ void bind_ciphertext(py::module &m) {
             in.close();
         })
         .def("resize", [](Ciphertext &ct, std::size_t size) { ct.resize(size); })
+
+        // Content hash over parms_id, scale and data (not cryptographic)
+        .def("content_hash", [](const Ciphertext &self) { return content_hash_to_int(content_hash(self)); },
+            "Returns a 128-bit hash of the parms_id, scale and data as an int.")
+
+        // Pickle support; protocol 5 ships the coefficient data out-of-band
+        .def("__reduce_ex__", [](const Ciphertext &self, int protocol) {
+            return py::make_tuple(
+                pickle_reconstructor(py::type::of<Ciphertext>(), "_unpickle_ciphertext"),
+                py::make_tuple(parms_id_to_bytes(self.parms_id()), pickle_payload(self, protocol)));
+        }, py::arg("protocol"))
         ;
 }
\ No newline at end of file
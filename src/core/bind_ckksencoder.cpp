@@ -1,8 +1,11 @@
 // bind_ckksencoder.cpp
+#include "object_pool.h"
 #include <seal/ckks.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/complex.h>
+#include <algorithm>
+#include <stdexcept>
 
 namespace py = pybind11;
 using namespace seal;
@@ -77,5 +80,44 @@ void bind_ckksencoder(py::module &m) {
             encoder.encode(values, scale, plain);
             return plain;
         }, py::arg("values"), py::arg("scale"),
-        "Encodes a vector of complex<double> into a Plaintext with the given scale.");
+        "Encodes a vector of complex<double> into a Plaintext with the given scale.")
+
+        // Pooled variants: encode into a Plaintext acquired from pool
+        .def("encode_new", [](const CKKSEncoder &encoder, const std::vector<double> &values, double scale, PlaintextPool &pool) {
+            auto plain = pool.acquire();
+            encoder.encode(values, scale, *plain);
+            return plain;
+        }, py::arg("values"), py::arg("scale"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("encode_new", [](const CKKSEncoder &encoder, const std::vector<std::complex<double>> &values, double scale, PlaintextPool &pool) {
+            auto plain = pool.acquire();
+            encoder.encode(values, scale, *plain);
+            return plain;
+        }, py::arg("values"), py::arg("scale"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>(),
+        "Encodes into a Plaintext acquired from pool; release it back when done.")
+
+        // Real-pair packing: two real vectors as the real and imaginary parts
+        .def("encode_pair", [](const CKKSEncoder &encoder, const std::vector<double> &real, const std::vector<double> &imag, double scale) {
+            if (std::max(real.size(), imag.size()) > encoder.slot_count()) {
+                throw std::invalid_argument("values do not fit in the slots");
+            }
+            std::vector<std::complex<double>> values(std::max(real.size(), imag.size()));
+            for (std::size_t i = 0; i < real.size(); i++) values[i].real(real[i]);
+            for (std::size_t i = 0; i < imag.size(); i++) values[i].imag(imag[i]);
+            Plaintext plain;
+            encoder.encode(values, scale, plain);
+            return plain;
+        }, py::arg("real"), py::arg("imag"), py::arg("scale"),
+            "Encodes real + i*imag so one Plaintext carries two real vectors.")
+
+        .def("decode_pair", [](const CKKSEncoder &encoder, const Plaintext &plain) {
+            std::vector<std::complex<double>> values;
+            encoder.decode(plain, values);
+            std::vector<double> real(values.size()), imag(values.size());
+            for (std::size_t i = 0; i < values.size(); i++) {
+                real[i] = values[i].real();
+                imag[i] = values[i].imag();
+            }
+            return std::make_pair(std::move(real), std::move(imag));
+        }, py::arg("plain"),
+            "Decodes a pair-packed Plaintext into (real, imag) lists.");
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "bind_context.h"
+#include "bind_pickle.h"
+#include "context_registry.h"
 #include <seal/context.h>
 #include <pybind11/pybind11.h>
 
@@ -50,7 +52,9 @@ void bind_context(py::module &m) {
         .def(py::init([](const EncryptionParameters &parms, 
                         bool expand_mod_chain = true, 
                         sec_level_type sec_level = sec_level_type::tc128) {
-            return std::make_shared<SEALContext>(parms, expand_mod_chain, sec_level);
+            auto context = std::make_shared<SEALContext>(parms, expand_mod_chain, sec_level);
+            register_context(context, expand_mod_chain, sec_level);
+            return context;
         }), py::arg("parms"), 
             py::arg("expand_mod_chain") = true, 
             py::arg("sec_level") = sec_level_type::tc128)
@@ -90,5 +94,16 @@ void bind_context(py::module &m) {
             })
         .def("__repr__", [](const SEALContext &ctx) {
             return "<SEALContext with " + std::to_string(ctx.first_context_data()->chain_index() + 1) + " modulus levels>";
-        });
+        })
+
+        // Pickle support; unpickling returns the receiver's live context with the
+        // same parameters when one exists instead of rebuilding it
+        .def("__reduce_ex__", [](const SEALContext &ctx, int protocol) {
+            return py::make_tuple(
+                pickle_reconstructor(py::type::of<SEALContext>(), "_unpickle_context"),
+                py::make_tuple(
+                    pickle_payload(ctx.key_context_data()->parms(), protocol),
+                    context_expand_mod_chain(ctx),
+                    static_cast<int>(context_sec_level(ctx))));
+        }, py::arg("protocol"));
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "bind_conv2d.h"
+#include "conv2d.h"
+#include "context_registry.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+void bind_conv2d(py::module &m) {
+    py::class_<Conv2D, std::shared_ptr<Conv2D>>(m, "Conv2D")
+        .def(py::init([](std::shared_ptr<SEALContext> context, std::size_t in_channels, std::size_t height,
+                         std::size_t width, std::size_t out_channels, std::size_t kernel_size,
+                         const std::vector<double> &weights, const std::vector<double> &bias,
+                         const py::object &parms_id, double scale_factor, std::size_t threads) {
+            auto level = parms_id.is_none() ? context->first_parms_id() : parms_id_from_bytes(parms_id.cast<py::bytes>());
+            py::gil_scoped_release release;
+            return std::make_shared<Conv2D>(context, in_channels, height, width, out_channels, kernel_size, weights,
+                                            bias, level, scale_factor, threads);
+        }), py::arg("context"), py::arg("in_channels"), py::arg("height"), py::arg("width"), py::arg("out_channels"),
+            py::arg("kernel_size"), py::arg("weights"), py::arg("bias") = std::vector<double>(),
+            py::arg("parms_id") = py::none(), py::arg("scale_factor") = 0.0, py::arg("threads") = 0,
+            "Pre-encodes a stride-1 'same' convolution. weights is a flat [out][in][k][k] list; parms_id (bytes) "
+            "is the level of the inputs, the first data level by default. Inputs are packed channel major: "
+            "slot c*H*W + y*W + x.")
+
+        .def("galois_steps", &Conv2D::galois_steps,
+            "Returns the rotation steps apply() needs; pass them to KeyGenerator.create_galois_keys.")
+        .def("pack", &Conv2D::pack, py::arg("image"),
+            "Packs a flat [C][H][W] image into slot order.")
+        .def("encode", &Conv2D::encode, py::arg("image"), py::arg("scale"),
+            "Packs and encodes a flat [C][H][W] image at the convolution's level.")
+        .def("decode", &Conv2D::decode, py::arg("plain"),
+            "Decodes one output channel into its H*W pixels.")
+
+        .def("apply", [](const Conv2D &self, const Ciphertext &encrypted, const GaloisKeys &galois_keys) {
+            py::gil_scoped_release release;
+            return self.apply(encrypted, galois_keys);
+        }, py::arg("encrypted"), py::arg("galois_keys"),
+            "Convolves an encrypted image and returns one ciphertext per output channel, one level lower at the "
+            "input scale, with pixel (y, x) in slot y*W + x.")
+
+        .def_property_readonly("in_channels", &Conv2D::in_channels)
+        .def_property_readonly("out_channels", &Conv2D::out_channels)
+        .def_property_readonly("height", &Conv2D::height)
+        .def_property_readonly("width", &Conv2D::width)
+        .def_property_readonly("kernel_size", &Conv2D::kernel_size);
+}
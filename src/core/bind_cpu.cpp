@@ -0,0 +1,59 @@
+#include "bind_cpu.h"
+#include "cpu_dispatch.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+void bind_cpu(py::module &m) {
+    // Select the kernel backend now, so it is fixed from import on and a
+    // misspelled SEAL_PYTHON_BACKEND fails the import
+    kernels();
+
+    m.def("cpu_features", []() {
+        auto &features = cpu_features();
+        py::dict result;
+        result["sse4_2"] = features.sse4_2;
+        result["avx"] = features.avx;
+        result["avx2"] = features.avx2;
+        result["bmi2"] = features.bmi2;
+        result["avx512f"] = features.avx512f;
+        result["avx512dq"] = features.avx512dq;
+        result["avx512ifma"] = features.avx512ifma;
+        result["avx512vbmi2"] = features.avx512vbmi2;
+        result["hexl_compiled"] = hexl_compiled();
+        return result;
+    }, "Returns the instruction-set extensions of this CPU and whether SEAL was built with HEXL.");
+
+    m.def("active_backend", []() { return std::string(backend_name(kernels().backend)); },
+        "Returns the kernel backend chosen at import: baseline, avx2 or hexl. Set SEAL_PYTHON_BACKEND before "
+        "importing to force a lower one; an unknown value makes the import fail.");
+
+    m.def("available_backends", []() {
+        std::vector<std::string> names;
+        for (auto backend : available_backends()) names.push_back(backend_name(backend));
+        return names;
+    }, "Returns the backends this CPU and build can run, slowest first.");
+
+    m.def("requested_backend", []() { return requested_backend(); },
+        "Returns SEAL_PYTHON_BACKEND as read at import, or an empty string.");
+
+    m.def("benchmark_backends", [](const SEALContext &context, std::size_t iterations) {
+        std::vector<BackendTiming> timings;
+        {
+            py::gil_scoped_release release;
+            timings = benchmark_backends(context, iterations);
+        }
+        py::dict result;
+        for (auto &timing : timings) {
+            py::dict entry;
+            entry["ms_per_call"] = timing.seconds_per_call * 1e3;
+            entry["checksum"] = timing.checksum;
+            result[backend_name(timing.backend)] = entry;
+        }
+        return result;
+    }, py::arg("context"), py::arg("iterations") = 100,
+        "Times the RNS multiply-accumulate kernel on every available backend. Equal checksums mean the backends "
+        "agree.");
+}
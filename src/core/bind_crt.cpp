@@ -0,0 +1,139 @@
+#include "bind_crt.h"
+#include "crt_pipeline.h"
+#include "context_registry.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <cstring>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    // Little-endian limbs <-> Python int, through int.to_bytes/int.from_bytes
+    py::int_ limbs_to_int(const std::uint64_t *limbs, std::size_t words) {
+        std::string bytes(words * sizeof(std::uint64_t), '\0');
+        std::memcpy(&bytes[0], limbs, bytes.size());
+        return py::module_::import("builtins").attr("int").attr("from_bytes")(py::bytes(bytes), "little");
+    }
+
+    py::int_ plain_modulus(const CRTPipeline &pipeline) {
+        auto product = pipeline.plain_modulus_product();
+        return limbs_to_int(product.data(), product.size());
+    }
+
+    // Python's % is non-negative for a positive modulus, so negative values wrap
+    std::vector<std::uint64_t> values_to_limbs(const CRTPipeline &pipeline, const py::iterable &values) {
+        auto modulus = plain_modulus(pipeline);
+        std::size_t words = pipeline.word_count();
+        std::vector<std::uint64_t> limbs;
+        for (auto value : values) {
+            py::bytes bytes = py::int_(py::reinterpret_borrow<py::object>(value)).attr("__mod__")(modulus)
+                                  .attr("to_bytes")(words * sizeof(std::uint64_t), "little");
+            std::string data = bytes;
+            limbs.resize(limbs.size() + words);
+            std::memcpy(limbs.data() + limbs.size() - words, data.data(), data.size());
+        }
+        return limbs;
+    }
+
+    py::list limbs_to_values(const CRTPipeline &pipeline, const std::vector<std::uint64_t> &limbs, bool is_signed) {
+        auto modulus = plain_modulus(pipeline);
+        py::object half = modulus.attr("__floordiv__")(2);
+        std::size_t words = pipeline.word_count();
+        py::list result;
+        for (std::size_t i = 0; i < limbs.size(); i += words) {
+            py::object value = limbs_to_int(limbs.data() + i, words);
+            if (is_signed && value > half) value = value - modulus;
+            result.append(value);
+        }
+        return result;
+    }
+}
+
+void bind_crt(py::module &m) {
+    py::class_<CRTPlaintext, std::shared_ptr<CRTPlaintext>>(m, "CRTPlaintext")
+        .def("__len__", [](const CRTPlaintext &self) { return self.shards.size(); })
+        .def("shard", [](const CRTPlaintext &self, std::size_t index) -> const Plaintext & {
+            return self.shards.at(index);
+        }, py::arg("index"), py::return_value_policy::reference_internal);
+
+    py::class_<CRTCiphertext, std::shared_ptr<CRTCiphertext>>(m, "CRTCiphertext")
+        .def("__len__", [](const CRTCiphertext &self) { return self.shards.size(); })
+        .def("shard", [](const CRTCiphertext &self, std::size_t index) -> const Ciphertext & {
+            return self.shards.at(index);
+        }, py::arg("index"), py::return_value_policy::reference_internal);
+
+    py::class_<CRTPipeline, std::shared_ptr<CRTPipeline>>(m, "CRTPipeline")
+        .def(py::init([](const EncryptionParameters &parms, const std::vector<Modulus> &plain_moduli,
+                         sec_level_type sec_level, std::size_t threads) {
+            std::shared_ptr<CRTPipeline> pipeline;
+            {
+                py::gil_scoped_release release;
+                pipeline = std::make_shared<CRTPipeline>(parms, plain_moduli, sec_level, threads);
+            }
+            for (std::size_t i = 0; i < pipeline->shard_count(); i++) {
+                register_context(pipeline->context(i), true, sec_level);
+            }
+            return pipeline;
+        }), py::arg("parms"), py::arg("plain_moduli"), py::arg("sec_level") = sec_level_type::tc128,
+            py::arg("threads") = 0,
+            "Creates one BFV/BGV context per plain prime (e.g. from PlainModulus.BatchingMany); parms supplies "
+            "the scheme, poly_modulus_degree and coeff_modulus. threads=0 shares the process-wide pool.")
+        .def("generate_keys", [](CRTPipeline &self, bool relin_keys, const std::vector<int> &galois_steps) {
+            py::gil_scoped_release release;
+            self.generate_keys(relin_keys, galois_steps);
+        }, py::arg("relin_keys") = true, py::arg("galois_steps") = std::vector<int>(),
+            "Generates a key set per shard, with Galois keys for galois_steps (0 is the column swap).")
+        .def_property_readonly("shard_count", &CRTPipeline::shard_count)
+        .def_property_readonly("slot_count", &CRTPipeline::slot_count)
+        .def_property_readonly("plain_moduli", &CRTPipeline::plain_moduli)
+        .def_property_readonly("plain_modulus", &plain_modulus,
+            "The product of the plain primes; results are exact modulo this integer.")
+        .def("context", &CRTPipeline::context, py::arg("shard"))
+
+        .def("encode", [](const CRTPipeline &self, const py::iterable &values) {
+            auto limbs = values_to_limbs(self, values);
+            py::gil_scoped_release release;
+            return self.encode(limbs);
+        }, py::arg("values"),
+            "Splits at most slot_count Python ints (reduced modulo plain_modulus) into one plaintext per prime.")
+        .def("decode", [](const CRTPipeline &self, const CRTPlaintext &plain, bool is_signed) {
+            std::vector<std::uint64_t> limbs;
+            {
+                py::gil_scoped_release release;
+                limbs = self.decode(plain);
+            }
+            return limbs_to_values(self, limbs, is_signed);
+        }, py::arg("plain"), py::arg("signed") = false,
+            "Recombines every slot into a Python int in [0, plain_modulus), or centered around zero with "
+            "signed=True.")
+        .def("encrypt", [](const CRTPipeline &self, const CRTPlaintext &plain) {
+            py::gil_scoped_release release;
+            return self.encrypt(plain);
+        }, py::arg("plain"))
+        .def("decrypt", [](const CRTPipeline &self, const CRTCiphertext &encrypted) {
+            py::gil_scoped_release release;
+            return self.decrypt(encrypted);
+        }, py::arg("encrypted"))
+        .def("invariant_noise_budget", &CRTPipeline::invariant_noise_budget, py::arg("encrypted"),
+            "BFV: returns the smallest noise budget over the shards, in bits.")
+
+        // Every operation runs on all shards concurrently with the GIL released
+        .def("add", &CRTPipeline::add, py::arg("a"), py::arg("b"), py::call_guard<py::gil_scoped_release>())
+        .def("sub", &CRTPipeline::sub, py::arg("a"), py::arg("b"), py::call_guard<py::gil_scoped_release>())
+        .def("negate", &CRTPipeline::negate, py::arg("encrypted"), py::call_guard<py::gil_scoped_release>())
+        .def("multiply", &CRTPipeline::multiply, py::arg("a"), py::arg("b"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Multiplies shard by shard, relinearizing when relinearization keys were generated.")
+        .def("square", &CRTPipeline::square, py::arg("encrypted"), py::call_guard<py::gil_scoped_release>())
+        .def("add_plain", &CRTPipeline::add_plain, py::arg("encrypted"), py::arg("plain"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("multiply_plain", &CRTPipeline::multiply_plain, py::arg("encrypted"), py::arg("plain"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_rows", &CRTPipeline::rotate_rows, py::arg("encrypted"), py::arg("steps"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_columns", &CRTPipeline::rotate_columns, py::arg("encrypted"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("mod_switch_to_next", &CRTPipeline::mod_switch_to_next, py::arg("encrypted"),
+            py::call_guard<py::gil_scoped_release>());
+}
@@ -1,3 +1,4 @@
+#include "object_pool.h"
 #include <seal/decryptor.h>
 #include <pybind11/pybind11.h>
 
@@ -24,6 +25,13 @@ void bind_decryptor(py::module &m) {
         }, py::arg("encrypted"),
             "Decrypts a Ciphertext and returns a new Plaintext.")
 
+        .def("decrypt_new", [](Decryptor &self, const Ciphertext &encrypted, PlaintextPool &pool) {
+            auto destination = pool.acquire();
+            self.decrypt(encrypted, *destination);
+            return destination;
+        }, py::arg("encrypted"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>(),
+            "Decrypts into a Plaintext acquired from pool.")
+
         // Invariant noise budget
         .def("invariant_noise_budget", &Decryptor::invariant_noise_budget,
             py::arg("encrypted"),
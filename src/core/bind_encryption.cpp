@@ -5,6 +5,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <fstream>
+#include "bind_pickle.h"
 
 namespace py = pybind11;
 using namespace seal;
@@ -53,5 +54,12 @@ void bind_encryption_parameters(py::module &m) {
         .def("parms_id", [](const EncryptionParameters &p) {
             auto id = p.parms_id();
             return py::bytes(reinterpret_cast<const char*>(id.data()), id.size());
-        });
+        })
+
+        // Pickle support
+        .def("__reduce_ex__", [](const EncryptionParameters &self, int protocol) {
+            return py::make_tuple(
+                pickle_reconstructor(py::type::of<EncryptionParameters>(), "_unpickle_encryption_parameters"),
+                py::make_tuple(pickle_payload(self, protocol)));
+        }, py::arg("protocol"));
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "bind_encryptor.h"
+#include "object_pool.h"
 #include <seal/encryptor.h>
 #include <seal/serializable.h>
 #include <pybind11/pybind11.h>
@@ -21,6 +22,13 @@ void bind_encryptor(py::module &m) {
         }, py::arg("plain"),
             "Encrypts a Plaintext and returns a SerializableCiphertext.")
 
+        .def("encrypt", [](Encryptor &self, const Plaintext &plain, CiphertextPool &pool) {
+            auto cipher = pool.acquire();
+            self.encrypt(plain, *cipher);
+            return cipher;
+        }, py::arg("plain"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>(),
+            "Encrypts a Plaintext into a Ciphertext acquired from pool.")
+
         // Encrypt (in-place, writes to Ciphertext)
         .def("encrypt_inplace", [](Encryptor &self, const Plaintext &plain, Ciphertext &cipher) {
             self.encrypt(plain, cipher);
@@ -54,6 +62,13 @@ void bind_encryptor(py::module &m) {
         }, py::arg("plain"),
             "Encrypts a Plaintext using symmetric encryption and returns a SerializableCiphertext.")
 
+        .def("encrypt_symmetric", [](Encryptor &self, const Plaintext &plain, CiphertextPool &pool) {
+            auto cipher = pool.acquire();
+            self.encrypt_symmetric(plain, *cipher);
+            return cipher;
+        }, py::arg("plain"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>(),
+            "Encrypts a Plaintext symmetrically into a Ciphertext acquired from pool.")
+
         // Symmetric encryption (in-place)
         .def("encrypt_symmetric_inplace", [](Encryptor &self, const Plaintext &plain, Ciphertext &cipher) {
             self.encrypt_symmetric(plain, cipher);
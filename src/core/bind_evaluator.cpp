@@ -1,3 +1,4 @@
+#include "object_pool.h"
 #include <seal/evaluator.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -80,5 +81,31 @@ void bind_evaluator(py::module &m) {
         .def("transform_to_ntt", [](Evaluator &e, const Ciphertext &a, Ciphertext &out) { e.transform_to_ntt(a, out); })
         .def("transform_from_ntt", [](Evaluator &e, const Ciphertext &a, Ciphertext &out) { e.transform_from_ntt(a, out); })
         .def("transform_to_ntt_plain_inplace", [](Evaluator &e, Plaintext &a, parms_id_type parms_id) { e.transform_to_ntt_inplace(a, parms_id); })
+
+        // Pooled outputs: pass a CiphertextPool instead of out to get a result
+        // acquired from it (release it back when done)
+        .def("add", [](Evaluator &e, const Ciphertext &a, const Ciphertext &b, CiphertextPool &pool) { auto out = pool.acquire(); e.add(a, b, *out); return out; }, py::arg("a"), py::arg("b"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("sub", [](Evaluator &e, const Ciphertext &a, const Ciphertext &b, CiphertextPool &pool) { auto out = pool.acquire(); e.sub(a, b, *out); return out; }, py::arg("a"), py::arg("b"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("add_plain_out", [](Evaluator &e, const Ciphertext &a, const Plaintext &b, CiphertextPool &pool) { auto out = pool.acquire(); e.add_plain(a, b, *out); return out; }, py::arg("a"), py::arg("b"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("sub_plain_out", [](Evaluator &e, const Ciphertext &a, const Plaintext &b, CiphertextPool &pool) { auto out = pool.acquire(); e.sub_plain(a, b, *out); return out; }, py::arg("a"), py::arg("b"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("negate", [](Evaluator &e, const Ciphertext &a, CiphertextPool &pool) { auto out = pool.acquire(); e.negate(a, *out); return out; }, py::arg("a"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>())
+        .def("multiply", [](Evaluator &e, const Ciphertext &a, const Ciphertext &b, CiphertextPool &pool) { auto out = pool.acquire(); e.multiply(a, b, *out); return out; }, py::arg("a"), py::arg("b"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("multiply_plain_out", [](Evaluator &e, const Ciphertext &a, const Plaintext &b, CiphertextPool &pool) { auto out = pool.acquire(); e.multiply_plain(a, b, *out); return out; }, py::arg("a"), py::arg("b"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("square", [](Evaluator &e, const Ciphertext &a, CiphertextPool &pool) { auto out = pool.acquire(); e.square(a, *out); return out; }, py::arg("a"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>())
+        .def("relinearize", [](Evaluator &e, const Ciphertext &a, const RelinKeys &relin_keys, CiphertextPool &pool) { auto out = pool.acquire(); e.relinearize(a, relin_keys, *out); return out; }, py::arg("a"), py::arg("relin_keys"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("mod_switch_to_next", [](Evaluator &e, const Ciphertext &a, CiphertextPool &pool) { auto out = pool.acquire(); e.mod_switch_to_next(a, *out); return out; }, py::arg("a"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>())
+        .def("rescale_to_next_out", [](Evaluator &e, const Ciphertext &a, CiphertextPool &pool) { auto out = pool.acquire(); e.rescale_to_next(a, *out); return out; }, py::arg("a"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>())
+        .def("rotate_rows", [](Evaluator &e, const Ciphertext &a, int steps, const GaloisKeys &galois_keys, CiphertextPool &pool) { auto out = pool.acquire(); e.rotate_rows(a, steps, galois_keys, *out); return out; }, py::arg("a"), py::arg("steps"), py::arg("galois_keys"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 5>())
+        .def("rotate_columns", [](Evaluator &e, const Ciphertext &a, const GaloisKeys &galois_keys, CiphertextPool &pool) { auto out = pool.acquire(); e.rotate_columns(a, galois_keys, *out); return out; }, py::arg("a"), py::arg("galois_keys"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("rotate_vector", [](Evaluator &e, const Ciphertext &a, int steps, const GaloisKeys &galois_keys, CiphertextPool &pool) { auto out = pool.acquire(); e.rotate_vector(a, steps, galois_keys, *out); return out; }, py::arg("a"), py::arg("steps"), py::arg("galois_keys"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 5>())
+        .def("complex_conjugate", [](Evaluator &e, const Ciphertext &a, const GaloisKeys &galois_keys, CiphertextPool &pool) { auto out = pool.acquire(); e.complex_conjugate(a, galois_keys, *out); return out; }, py::arg("a"), py::arg("galois_keys"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("add_many", [](Evaluator &e, const std::vector<Ciphertext> &operands, CiphertextPool &pool) { auto out = pool.acquire(); e.add_many(operands, *out); return out; }, py::arg("operands"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>())
+        .def("multiply_many", [](Evaluator &e, const std::vector<Ciphertext> &operands, const RelinKeys &relin_keys, CiphertextPool &pool) { auto out = pool.acquire(); e.multiply_many(operands, relin_keys, *out); return out; }, py::arg("operands"), py::arg("relin_keys"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("exponentiate", [](Evaluator &e, const Ciphertext &a, std::uint64_t exponent, const RelinKeys &relin_keys, CiphertextPool &pool) { auto out = pool.acquire(); e.exponentiate(a, exponent, relin_keys, *out); return out; }, py::arg("a"), py::arg("exponent"), py::arg("relin_keys"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 5>())
+        .def("mod_switch_to", [](Evaluator &e, const Ciphertext &a, parms_id_type parms_id, CiphertextPool &pool) { auto out = pool.acquire(); e.mod_switch_to(a, parms_id, *out); return out; }, py::arg("a"), py::arg("parms_id"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("rescale_to_out", [](Evaluator &e, const Ciphertext &a, parms_id_type parms_id, CiphertextPool &pool) { auto out = pool.acquire(); e.rescale_to(a, parms_id, *out); return out; }, py::arg("a"), py::arg("parms_id"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 4>())
+        .def("apply_galois", [](Evaluator &e, const Ciphertext &a, std::uint32_t galois_elt, const GaloisKeys &galois_keys, CiphertextPool &pool) { auto out = pool.acquire(); e.apply_galois(a, galois_elt, galois_keys, *out); return out; }, py::arg("a"), py::arg("galois_elt"), py::arg("galois_keys"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 5>())
+        .def("transform_to_ntt", [](Evaluator &e, const Ciphertext &a, CiphertextPool &pool) { auto out = pool.acquire(); e.transform_to_ntt(a, *out); return out; }, py::arg("a"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>())
+        .def("transform_from_ntt", [](Evaluator &e, const Ciphertext &a, CiphertextPool &pool) { auto out = pool.acquire(); e.transform_from_ntt(a, *out); return out; }, py::arg("a"), py::arg("pool"), py::return_value_policy::reference, py::keep_alive<0, 3>())
         ;
 }
\ No newline at end of file
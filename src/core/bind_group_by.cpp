@@ -0,0 +1,64 @@
+#include "bind_group_by.h"
+#include "context_registry.h"
+#include "group_by.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    Ciphertext aggregate_one(const GroupByAggregator &self, const std::vector<const Ciphertext *> &column,
+                             AggregateKind kind, const GaloisKeys &galois_keys) {
+        py::gil_scoped_release release;
+        return self.aggregate({ column }, { kind }, galois_keys).front();
+    }
+}
+
+void bind_group_by(py::module &m) {
+    py::class_<GroupByAggregator, std::shared_ptr<GroupByAggregator>>(m, "GroupByAggregator")
+        .def(py::init([](std::shared_ptr<SEALContext> context, const std::vector<std::int64_t> &groups,
+                         const py::object &parms_id, std::size_t threads) {
+            auto level = parms_id.is_none() ? parms_id_zero : parms_id_from_bytes(parms_id.cast<py::bytes>());
+            py::gil_scoped_release release;
+            return std::make_shared<GroupByAggregator>(context, groups, level, threads);
+        }), py::arg("context"), py::arg("groups"), py::arg("parms_id") = py::none(), py::arg("threads") = 0,
+            "Encodes the group masks for the row-to-group assignment groups (negative entries are skipped). "
+            "Columns are expected at parms_id (bytes; the first data level by default).")
+
+        .def_property_readonly("group_count", &GroupByAggregator::group_count)
+        .def_property_readonly("ciphertext_count", &GroupByAggregator::ciphertext_count,
+            "Ciphertexts per column.")
+        .def_property_readonly("slot_count", &GroupByAggregator::slot_count)
+        .def_property_readonly("parms_id", [](const GroupByAggregator &self) {
+            return parms_id_to_bytes(self.parms_id());
+        })
+        .def_property_readonly("counts", &GroupByAggregator::counts, "Rows per group.")
+        .def_property_readonly("rotations", &GroupByAggregator::rotations,
+            "Rotations per distinct column aggregated.")
+        .def("galois_steps", &GroupByAggregator::galois_steps,
+            "Returns the rotation steps aggregation needs; pass them to KeyGenerator.create_galois_keys.")
+
+        .def("aggregate", [](const GroupByAggregator &self,
+                             const std::vector<std::vector<const Ciphertext *>> &columns,
+                             const std::vector<std::string> &kinds, const GaloisKeys &galois_keys) {
+            std::vector<AggregateKind> parsed;
+            for (auto &kind : kinds) parsed.push_back(parse_aggregate(kind));
+            py::gil_scoped_release release;
+            return self.aggregate(columns, parsed, galois_keys);
+        }, py::arg("columns"), py::arg("kinds"), py::arg("galois_keys"),
+            "Aggregates columns[i] by kinds[i] ('sum', 'count' or 'mean') in one sweep and returns one ciphertext "
+            "per aggregate, group g in slot g. count expects a 0/1 indicator column; mean is CKKS only.")
+        .def("sum", [](const GroupByAggregator &self, const std::vector<const Ciphertext *> &column,
+                       const GaloisKeys &galois_keys) {
+            return aggregate_one(self, column, AggregateKind::sum, galois_keys);
+        }, py::arg("column"), py::arg("galois_keys"))
+        .def("count", [](const GroupByAggregator &self, const std::vector<const Ciphertext *> &column,
+                         const GaloisKeys &galois_keys) {
+            return aggregate_one(self, column, AggregateKind::count, galois_keys);
+        }, py::arg("column"), py::arg("galois_keys"))
+        .def("mean", [](const GroupByAggregator &self, const std::vector<const Ciphertext *> &column,
+                        const GaloisKeys &galois_keys) {
+            return aggregate_one(self, column, AggregateKind::mean, galois_keys);
+        }, py::arg("column"), py::arg("galois_keys"));
+}
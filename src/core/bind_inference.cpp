@@ -0,0 +1,118 @@
+#include "bind_inference.h"
+#include "inference.h"
+#include "context_registry.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    py::tuple shape_tuple(const TensorShape &shape) {
+        return py::make_tuple(shape.channels, shape.height, shape.width);
+    }
+}
+
+void bind_inference(py::module &m) {
+    py::class_<NNModel, std::shared_ptr<NNModel>>(m, "NNModel")
+        .def(py::init<std::size_t, std::size_t, std::size_t>(), py::arg("channels"), py::arg("height") = 1,
+            py::arg("width") = 1,
+            "Creates an empty model over a [channels][height][width] input, flattened channel major.")
+        .def("add_dense", &NNModel::add_dense, py::arg("units"), py::arg("weights"),
+            py::arg("bias") = std::vector<double>(), "Adds a dense layer; weights is a flat [units][inputs] list.")
+        .def("add_conv", &NNModel::add_conv, py::arg("out_channels"), py::arg("kernel_size"), py::arg("weights"),
+            py::arg("bias") = std::vector<double>(),
+            "Adds a stride-1 'same' convolution; weights is a flat [out][in][k][k] list.")
+        .def("add_avg_pool", &NNModel::add_avg_pool, py::arg("window"),
+            "Adds non-overlapping window x window average pooling.")
+        .def("add_poly", &NNModel::add_poly, py::arg("coeffs"),
+            "Adds an elementwise polynomial activation, coefficients from the constant term up.")
+        .def_property_readonly("input_shape", [](const NNModel &self) { return shape_tuple(self.input_shape()); })
+        .def_property_readonly("output_shape", [](const NNModel &self) { return shape_tuple(self.output_shape()); })
+        .def("__len__", [](const NNModel &self) { return self.layers().size(); })
+        .def("save", &NNModel::save, py::arg("path"), "Writes the compact model file (float32 weights).")
+        .def_static("load", [](const std::string &path) {
+            return std::make_shared<NNModel>(NNModel::load(path));
+        }, py::arg("path"), "Reads a model file written by save.");
+
+    py::class_<EncryptedInference, std::shared_ptr<EncryptedInference>>(m, "EncryptedInference")
+        .def(py::init([](std::shared_ptr<SEALContext> context, const NNModel &model, double scale,
+                         const py::object &parms_id, std::size_t threads) {
+            auto level = parms_id.is_none() ? context->first_parms_id() : parms_id_from_bytes(parms_id.cast<py::bytes>());
+            py::gil_scoped_release release;
+            return std::make_shared<EncryptedInference>(context, model, scale, level, threads);
+        }), py::arg("context"), py::arg("model"), py::arg("scale"), py::arg("parms_id") = py::none(),
+            py::arg("threads") = 0,
+            "Plans levels for every layer and pre-encodes the weights. Inputs are expected at parms_id (bytes; "
+            "the first data level by default) with the given scale, which should be close to the primes the "
+            "model consumes. Raises ValueError when the chain is too short for the model.")
+
+        .def("galois_steps", &EncryptedInference::galois_steps,
+            "Returns the rotation steps infer() needs; pass them to KeyGenerator.create_galois_keys.")
+        .def("encode", &EncryptedInference::encode, py::arg("input"),
+            "Encodes a flattened input at the input level and scale.")
+        .def("decode", &EncryptedInference::decode, py::arg("plain"),
+            "Decodes the flattened output from a decrypted result.")
+
+        .def("infer", [](const EncryptedInference &self, const Ciphertext &encrypted, const RelinKeys &relin_keys,
+                         const GaloisKeys &galois_keys) {
+            py::gil_scoped_release release;
+            return self.infer(encrypted, relin_keys, galois_keys);
+        }, py::arg("encrypted"), py::arg("relin_keys"), py::arg("galois_keys"))
+        .def("infer_batch", [](const EncryptedInference &self, const std::vector<Ciphertext> &encrypted,
+                               const RelinKeys &relin_keys, const GaloisKeys &galois_keys) {
+            py::gil_scoped_release release;
+            return self.infer_batch(encrypted, relin_keys, galois_keys);
+        }, py::arg("encrypted"), py::arg("relin_keys"), py::arg("galois_keys"),
+            "Runs every input, one per worker when the batch is at least as large as the pool.")
+
+        .def_property_readonly("input_shape",
+            [](const EncryptedInference &self) { return shape_tuple(self.input_shape()); })
+        .def_property_readonly("output_shape",
+            [](const EncryptedInference &self) { return shape_tuple(self.output_shape()); })
+        .def_property_readonly("input_level", &EncryptedInference::input_level)
+        .def_property_readonly("output_level", &EncryptedInference::output_level)
+        .def_property_readonly("depth", &EncryptedInference::depth)
+        .def_property_readonly("input_scale", &EncryptedInference::input_scale)
+        .def_property_readonly("output_scale", &EncryptedInference::output_scale)
+        .def_property_readonly("input_parms_id", [](const EncryptedInference &self) {
+            return parms_id_to_bytes(self.input_parms_id());
+        })
+        .def_property_readonly("output_parms_id", [](const EncryptedInference &self) {
+            return parms_id_to_bytes(self.output_parms_id());
+        })
+
+        .def("layers", [](const EncryptedInference &self) {
+            py::list result;
+            for (auto &info : self.layers()) {
+                py::dict layer;
+                layer["kind"] = layer_kind_name(info.kind);
+                layer["output_shape"] = shape_tuple(info.output);
+                layer["input_level"] = info.input_level;
+                layer["output_level"] = info.output_level;
+                layer["levels"] = info.input_level - info.output_level;
+                layer["rotations"] = info.rotations;
+                layer["plaintexts"] = info.plaintexts;
+                layer["degree"] = info.degree;
+                result.append(layer);
+            }
+            return result;
+        }, "Returns the plan of every layer: kind, output shape, levels in and out, and per-call rotations and "
+           "plaintext multiplies (linear layers) or degree (poly layers).")
+        .def("stats", [](const EncryptedInference &self) {
+            auto infos = self.layers();
+            auto stats = self.stats();
+            py::list result;
+            for (std::size_t i = 0; i < stats.size(); i++) {
+                py::dict layer;
+                layer["kind"] = layer_kind_name(infos[i].kind);
+                layer["levels"] = infos[i].input_level - infos[i].output_level;
+                layer["calls"] = stats[i].calls;
+                layer["seconds"] = stats[i].seconds;
+                layer["mean_seconds"] = stats[i].calls ? stats[i].seconds / static_cast<double>(stats[i].calls) : 0.0;
+                result.append(layer);
+            }
+            return result;
+        }, "Returns per-layer call counts, summed and mean wall-clock seconds, and levels consumed.")
+        .def("reset_stats", &EncryptedInference::reset_stats);
+}
@@ -1,4 +1,7 @@
 #include "bind_keys.h"
+#include "bind_pickle.h"
+#include "context_registry.h"
+#include "compact_keys.h"
 #include <seal/keygenerator.h>
 #include <seal/publickey.h>
 #include <seal/secretkey.h>
@@ -23,7 +26,12 @@ void bind_keys(py::module &m) {
             if (!out) throw std::runtime_error("Failed to open file: " + path);
             obj.save(out);
             if (!out.good()) throw std::runtime_error("Failed to write to file: " + path);
-        });
+        })
+        .def("__reduce_ex__", [](const PublicKey &self, int protocol) {
+            return py::make_tuple(
+                pickle_reconstructor(py::type::of<PublicKey>(), "_unpickle_public_key"),
+                py::make_tuple(parms_id_to_bytes(self.parms_id()), pickle_payload(self, protocol)));
+        }, py::arg("protocol"));
 
     py::class_<SecretKey>(m, "SecretKey")
         .def(py::init<>())
@@ -44,7 +52,12 @@ void bind_keys(py::module &m) {
             if (!out) throw std::runtime_error("Failed to open file: " + path);
             obj.save(out);
             if (!out.good()) throw std::runtime_error("Failed to write to file: " + path);
-        });
+        })
+        .def("__reduce_ex__", [](const RelinKeys &self, int protocol) {
+            return py::make_tuple(
+                pickle_reconstructor(py::type::of<RelinKeys>(), "_unpickle_relin_keys"),
+                py::make_tuple(parms_id_to_bytes(self.parms_id()), pickle_payload(self, protocol)));
+        }, py::arg("protocol"));
 
     py::class_<GaloisKeys>(m, "GaloisKeys")
         .def(py::init<>())
@@ -53,7 +66,12 @@ void bind_keys(py::module &m) {
             if (!out) throw std::runtime_error("Failed to open file: " + path);
             obj.save(out);
             if (!out.good()) throw std::runtime_error("Failed to write to file: " + path);
-        });
+        })
+        .def("__reduce_ex__", [](const GaloisKeys &self, int protocol) {
+            return py::make_tuple(
+                pickle_reconstructor(py::type::of<GaloisKeys>(), "_unpickle_galois_keys"),
+                py::make_tuple(parms_id_to_bytes(self.parms_id()), pickle_payload(self, protocol)));
+        }, py::arg("protocol"));
 
     // Bind KeyGenerator with correct method names for SEAL 4.1.2
     py::class_<KeyGenerator>(m, "KeyGenerator")
@@ -84,5 +102,95 @@ void bind_keys(py::module &m) {
             GaloisKeys gk;
             kg.create_galois_keys(gk);
             return gk;
-        }, "Generates all Galois keys and returns them.");
+        }, "Generates all Galois keys and returns them.")
+
+        // Galois keys for selected rotation steps or Galois elements
+        .def("create_galois_keys", [](KeyGenerator &kg, const std::vector<int> &steps) {
+            GaloisKeys gk;
+            kg.create_galois_keys(steps, gk);
+            return gk;
+        }, py::arg("steps"), "Generates Galois keys for the given rotation steps.")
+        .def("create_galois_keys_from_elts", [](KeyGenerator &kg, const std::vector<std::uint32_t> &galois_elts) {
+            GaloisKeys gk;
+            kg.create_galois_keys(galois_elts, gk);
+            return gk;
+        }, py::arg("galois_elts"), "Generates Galois keys for the given Galois elements.");
+
+    // Seeded in-memory key containers with on-demand expansion
+    py::class_<CompactGaloisKeys, std::shared_ptr<CompactGaloisKeys>>(m, "CompactGaloisKeys")
+        .def(py::init<std::shared_ptr<SEALContext>, KeyGenerator &, const std::vector<std::uint32_t> &, std::size_t>(),
+            py::arg("context"), py::arg("keygen"), py::arg("galois_elts") = std::vector<std::uint32_t>(),
+            py::arg("cache_size") = 8,
+            "Generates seeded Galois keys for the given elements (all when empty); "
+            "at most cache_size elements are kept expanded at a time.")
+        .def_static("from_steps", [](std::shared_ptr<SEALContext> context, KeyGenerator &keygen,
+                                     const std::vector<int> &steps, std::size_t cache_size) {
+            auto elts = CompactGaloisKeys::elts_from_steps(*context, steps);
+            return std::make_shared<CompactGaloisKeys>(context, keygen, elts, cache_size);
+        }, py::arg("context"), py::arg("keygen"), py::arg("steps"), py::arg("cache_size") = 8,
+            "Generates seeded Galois keys for the given rotation steps.")
+
+        .def("has_key", &CompactGaloisKeys::has_key, py::arg("galois_elt"))
+        .def("galois_elts", &CompactGaloisKeys::galois_elts)
+        .def("expand", [](CompactGaloisKeys &self, const std::vector<std::uint32_t> &galois_elts) {
+            py::gil_scoped_release release;
+            return self.expand(galois_elts);
+        }, py::arg("galois_elts"),
+            "Returns a regular GaloisKeys holding the requested elements.")
+
+        // Evaluator operations that expand only the key they need
+        .def("apply_galois", [](CompactGaloisKeys &self, const Evaluator &e, const Ciphertext &a, std::uint32_t galois_elt, Ciphertext &out) {
+            py::gil_scoped_release release;
+            self.apply_galois(e, a, galois_elt, out);
+        }, py::arg("evaluator"), py::arg("encrypted"), py::arg("galois_elt"), py::arg("destination"))
+        .def("rotate_vector", [](CompactGaloisKeys &self, const Evaluator &e, const Ciphertext &a, int steps, Ciphertext &out) {
+            py::gil_scoped_release release;
+            self.rotate(e, a, steps, out);
+        }, py::arg("evaluator"), py::arg("encrypted"), py::arg("steps"), py::arg("destination"))
+        .def("rotate_vector_inplace", [](CompactGaloisKeys &self, const Evaluator &e, Ciphertext &a, int steps) {
+            py::gil_scoped_release release;
+            self.rotate(e, a, steps, a);
+        }, py::arg("evaluator"), py::arg("encrypted"), py::arg("steps"))
+        .def("rotate_rows", [](CompactGaloisKeys &self, const Evaluator &e, const Ciphertext &a, int steps, Ciphertext &out) {
+            py::gil_scoped_release release;
+            self.rotate(e, a, steps, out);
+        }, py::arg("evaluator"), py::arg("encrypted"), py::arg("steps"), py::arg("destination"))
+        .def("rotate_rows_inplace", [](CompactGaloisKeys &self, const Evaluator &e, Ciphertext &a, int steps) {
+            py::gil_scoped_release release;
+            self.rotate(e, a, steps, a);
+        }, py::arg("evaluator"), py::arg("encrypted"), py::arg("steps"))
+        .def("rotate_columns", [](CompactGaloisKeys &self, const Evaluator &e, const Ciphertext &a, Ciphertext &out) {
+            py::gil_scoped_release release;
+            self.conjugate(e, a, out);
+        }, py::arg("evaluator"), py::arg("encrypted"), py::arg("destination"))
+        .def("complex_conjugate", [](CompactGaloisKeys &self, const Evaluator &e, const Ciphertext &a, Ciphertext &out) {
+            py::gil_scoped_release release;
+            self.conjugate(e, a, out);
+        }, py::arg("evaluator"), py::arg("encrypted"), py::arg("destination"))
+
+        // Cache control and statistics
+        .def("cache_size", &CompactGaloisKeys::cache_size)
+        .def("set_cache_size", &CompactGaloisKeys::set_cache_size, py::arg("cache_size"))
+        .def("clear_cache", &CompactGaloisKeys::clear_cache)
+        .def("cached_keys", &CompactGaloisKeys::cached_keys)
+        .def("compact_bytes", &CompactGaloisKeys::compact_bytes,
+            "Returns the bytes held by the seeded keys.")
+        .def("hits", &CompactGaloisKeys::hits)
+        .def("misses", &CompactGaloisKeys::misses);
+
+    py::class_<CompactRelinKeys, std::shared_ptr<CompactRelinKeys>>(m, "CompactRelinKeys")
+        .def(py::init<std::shared_ptr<SEALContext>, KeyGenerator &>(), py::arg("context"), py::arg("keygen"),
+            "Generates relinearization keys kept seeded until first use.")
+        .def("relinearize", [](CompactRelinKeys &self, const Evaluator &e, const Ciphertext &a, Ciphertext &out) {
+            py::gil_scoped_release release;
+            self.relinearize(e, a, out);
+        }, py::arg("evaluator"), py::arg("encrypted"), py::arg("destination"))
+        .def("relinearize_inplace", [](CompactRelinKeys &self, const Evaluator &e, Ciphertext &a) {
+            py::gil_scoped_release release;
+            self.relinearize(e, a, a);
+        }, py::arg("evaluator"), py::arg("encrypted"))
+        .def("release", &CompactRelinKeys::release,
+            "Drops the expanded keys; they are re-expanded from the seed on next use.")
+        .def("expanded", &CompactRelinKeys::expanded)
+        .def("compact_bytes", &CompactRelinKeys::compact_bytes);
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "bind_matmul.h"
+#include "ckks_matmul.h"
+#include "context_registry.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+void bind_matmul(py::module &m) {
+    py::class_<CKKSMatMul, std::shared_ptr<CKKSMatMul>>(m, "CKKSMatMul")
+        .def(py::init([](std::shared_ptr<SEALContext> context, std::size_t dimension, std::size_t threads) {
+            py::gil_scoped_release release;
+            return std::make_shared<CKKSMatMul>(context, dimension, threads);
+        }), py::arg("context"), py::arg("dimension"), py::arg("threads") = 0,
+            "Prepares products of dimension x dimension matrices (dimension * dimension must divide the slot "
+            "count). The permutation masks for the first data level are encoded here, other levels on first use.")
+
+        .def_property_readonly("dimension", &CKKSMatMul::dimension)
+        .def_property_readonly("copies", &CKKSMatMul::copies)
+        .def_property_readonly("depth", &CKKSMatMul::depth)
+        .def_property_readonly("keyswitches", &CKKSMatMul::keyswitches,
+            "Rotations plus relinearizations per matmul.")
+        .def("galois_steps", &CKKSMatMul::galois_steps, py::arg("transpose") = false,
+            "Returns the rotation steps matmul needs (about 3 * dimension keys), plus those of transpose when "
+            "requested; pass them to KeyGenerator.create_galois_keys.")
+
+        .def("encode", [](const CKKSMatMul &self, const std::vector<double> &matrix, double scale,
+                          const py::object &parms_id) {
+            auto level = parms_id.is_none() ? parms_id_zero : parms_id_from_bytes(parms_id.cast<py::bytes>());
+            return self.encode(matrix, scale, level);
+        }, py::arg("matrix"), py::arg("scale"), py::arg("parms_id") = py::none(),
+            "Encodes a row-major matrix, repeated across the slots, at parms_id (bytes; the first data level by "
+            "default).")
+        .def("decode", &CKKSMatMul::decode, py::arg("plain"),
+            "Decodes the row-major matrix from a decrypted result.")
+
+        .def("matmul", [](const CKKSMatMul &self, const Ciphertext &a, const Ciphertext &b,
+                          const RelinKeys &relin_keys, const GaloisKeys &galois_keys) {
+            py::gil_scoped_release release;
+            return self.matmul(a, b, relin_keys, galois_keys);
+        }, py::arg("a"), py::arg("b"), py::arg("relin_keys"), py::arg("galois_keys"),
+            "Returns the encrypted product a * b, three levels below the lower input.")
+        .def("matmul_batch", [](const CKKSMatMul &self, const std::vector<const Ciphertext *> &a,
+                                const std::vector<const Ciphertext *> &b, const RelinKeys &relin_keys,
+                                const GaloisKeys &galois_keys) {
+            py::gil_scoped_release release;
+            return self.matmul_batch(a, b, relin_keys, galois_keys);
+        }, py::arg("a"), py::arg("b"), py::arg("relin_keys"), py::arg("galois_keys"),
+            "Returns a[i] * b[i] for every i, one pair per worker when the batch is at least as large as the pool.")
+        .def("transpose", [](const CKKSMatMul &self, const Ciphertext &encrypted, const GaloisKeys &galois_keys) {
+            py::gil_scoped_release release;
+            return self.transpose(encrypted, galois_keys);
+        }, py::arg("encrypted"), py::arg("galois_keys"),
+            "Returns the encrypted transpose using one level; needs galois_steps(transpose=True).");
+}
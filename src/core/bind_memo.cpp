@@ -0,0 +1,72 @@
+#include "bind_memo.h"
+#include "memo_evaluator.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+py::int_ content_hash_to_int(const ContentHash &hash) {
+    return py::int_(py::int_(hash.hi).attr("__lshift__")(64).attr("__or__")(py::int_(hash.lo)));
+}
+
+void bind_memo(py::module &m) {
+    py::class_<MemoEvaluator, std::shared_ptr<MemoEvaluator>>(m, "MemoEvaluator")
+        .def(py::init([](std::shared_ptr<SEALContext> context, std::size_t capacity_bytes, const RelinKeys *relin_keys,
+                         const GaloisKeys *galois_keys) {
+            auto memo = std::make_shared<MemoEvaluator>(context, capacity_bytes);
+            py::gil_scoped_release release;
+            memo->set_relin_keys(relin_keys);
+            memo->set_galois_keys(galois_keys);
+            return memo;
+        }), py::arg("context"), py::arg("capacity_bytes") = std::size_t(256) << 20, py::arg("relin_keys") = nullptr,
+            py::arg("galois_keys") = nullptr, py::keep_alive<1, 4>(), py::keep_alive<1, 5>(),
+            "Creates a memoizing evaluator whose results are cached by operand content, bounded by capacity_bytes. "
+            "The keys are hashed once here and must not be modified while bound.")
+
+        .def("set_relin_keys", [](MemoEvaluator &self, const RelinKeys *relin_keys) {
+            py::gil_scoped_release release;
+            self.set_relin_keys(relin_keys);
+        }, py::arg("relin_keys"), py::keep_alive<1, 2>())
+        .def("set_galois_keys", [](MemoEvaluator &self, const GaloisKeys *galois_keys) {
+            py::gil_scoped_release release;
+            self.set_galois_keys(galois_keys);
+        }, py::arg("galois_keys"), py::keep_alive<1, 2>())
+
+        // Memoized operations; each returns a new Ciphertext
+        .def("multiply", &MemoEvaluator::multiply, py::arg("a"), py::arg("b"), py::call_guard<py::gil_scoped_release>())
+        .def("square", &MemoEvaluator::square, py::arg("encrypted"), py::call_guard<py::gil_scoped_release>())
+        .def("multiply_plain", &MemoEvaluator::multiply_plain, py::arg("encrypted"), py::arg("plain"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("relinearize", &MemoEvaluator::relinearize, py::arg("encrypted"), py::call_guard<py::gil_scoped_release>())
+        .def("rescale_to_next", &MemoEvaluator::rescale_to_next, py::arg("encrypted"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("mod_switch_to_next", &MemoEvaluator::mod_switch_to_next, py::arg("encrypted"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_vector", &MemoEvaluator::rotate_vector, py::arg("encrypted"), py::arg("steps"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_rows", &MemoEvaluator::rotate_rows, py::arg("encrypted"), py::arg("steps"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_columns", &MemoEvaluator::rotate_columns, py::arg("encrypted"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("complex_conjugate", &MemoEvaluator::complex_conjugate, py::arg("encrypted"),
+            py::call_guard<py::gil_scoped_release>())
+
+        .def("capacity_bytes", &MemoEvaluator::capacity_bytes)
+        .def("set_capacity_bytes", &MemoEvaluator::set_capacity_bytes, py::arg("capacity_bytes"),
+            "Changes the memory cap, evicting least recently used results as needed.")
+        .def("clear", &MemoEvaluator::clear)
+        .def("stats", [](const MemoEvaluator &self) {
+            auto stats = self.stats();
+            py::dict result;
+            result["hits"] = stats.hits;
+            result["misses"] = stats.misses;
+            result["evictions"] = stats.evictions;
+            result["entries"] = stats.entries;
+            result["bytes"] = stats.bytes;
+            auto lookups = stats.hits + stats.misses;
+            result["hit_rate"] = lookups ? static_cast<double>(stats.hits) / static_cast<double>(lookups) : 0.0;
+            return result;
+        }, "Returns hits, misses, evictions, cached entries and bytes.")
+        .def("reset_stats", &MemoEvaluator::reset_stats);
+}
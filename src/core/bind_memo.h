@@ -0,0 +1,8 @@
+#pragma once
+#include "content_hash.h"
+#include <pybind11/pybind11.h>
+
+// 128-bit content hash as a Python int, usable as a dict key
+pybind11::int_ content_hash_to_int(const ContentHash &hash);
+
+void bind_memo(pybind11::module &m);
@@ -0,0 +1,92 @@
+#include "bind_numa.h"
+#include "numa_pool.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    py::dict node_to_dict(const NumaNode &node) {
+        py::dict result;
+        result["id"] = node.id;
+        result["cpus"] = node.cpus;
+        return result;
+    }
+}
+
+void bind_numa(py::module &m) {
+    m.def("numa_topology", []() {
+        py::list result;
+        for (auto &node : numa_topology()) result.append(node_to_dict(node));
+        return result;
+    }, "Returns the NUMA nodes with usable CPUs as dicts of id and cpus; one node on machines without NUMA.");
+
+    py::class_<NumaWorkerPool, std::shared_ptr<NumaWorkerPool>>(m, "NumaWorkerPool")
+        .def(py::init<std::shared_ptr<SEALContext>, std::size_t, bool>(), py::arg("context"),
+            py::arg("threads_per_node") = 0, py::arg("pin") = true,
+            "Creates one worker pool, memory pool and key replica set per NUMA node; threads_per_node=0 starts "
+            "one worker per CPU of the node, and pin=True keeps each worker on its node's CPUs.")
+        .def_property_readonly("node_count", &NumaWorkerPool::node_count)
+        .def_property_readonly("threads", &NumaWorkerPool::threads)
+        .def("node", [](const NumaWorkerPool &self, std::size_t index) { return node_to_dict(self.node(index)); },
+            py::arg("index"))
+        .def("memory_pool", &NumaWorkerPool::memory_pool, py::arg("index"),
+            "Returns the MemoryPoolHandle results routed to that node are allocated from.")
+
+        .def("set_relin_keys", [](NumaWorkerPool &self, const RelinKeys &relin_keys) {
+            py::gil_scoped_release release;
+            self.set_relin_keys(relin_keys);
+        }, py::arg("relin_keys"), "Copies the keys into every node's memory from that node's workers.")
+        .def("set_galois_keys", [](NumaWorkerPool &self, const GaloisKeys &galois_keys) {
+            py::gil_scoped_release release;
+            self.set_galois_keys(galois_keys);
+        }, py::arg("galois_keys"), "Copies the keys into every node's memory from that node's workers.")
+        .def_property_readonly("has_relin_keys", &NumaWorkerPool::has_relin_keys)
+        .def_property_readonly("has_galois_keys", &NumaWorkerPool::has_galois_keys)
+
+        .def("route", &NumaWorkerPool::route, py::arg("cts"),
+            "Returns the node index each ciphertext would run on: the node holding its data, or round-robin "
+            "when that is unknown.")
+
+        // Batched operations; the GIL is released while the workers run
+        .def("relinearize", [](const NumaWorkerPool &self, const std::vector<const Ciphertext *> &cts) {
+            py::gil_scoped_release release;
+            return self.relinearize(cts);
+        }, py::arg("cts"))
+        .def("multiply_relinearize", [](const NumaWorkerPool &self, const std::vector<const Ciphertext *> &cts_a,
+                                        const std::vector<const Ciphertext *> &cts_b) {
+            py::gil_scoped_release release;
+            return self.multiply_relinearize(cts_a, cts_b);
+        }, py::arg("cts_a"), py::arg("cts_b"), "Returns relinearize(cts_a[i] * cts_b[i]) for every i.")
+        .def("rotate", [](const NumaWorkerPool &self, const std::vector<const Ciphertext *> &cts, int steps) {
+            py::gil_scoped_release release;
+            return self.rotate(cts, steps);
+        }, py::arg("cts"), py::arg("steps"), "Rotates every ciphertext (rotate_vector for CKKS, rotate_rows "
+            "for BFV/BGV).")
+        .def("apply_galois", [](const NumaWorkerPool &self, const std::vector<const Ciphertext *> &cts,
+                                std::uint32_t galois_elt) {
+            py::gil_scoped_release release;
+            return self.apply_galois(cts, galois_elt);
+        }, py::arg("cts"), py::arg("galois_elt"))
+
+        .def("stats", [](const NumaWorkerPool &self) {
+            auto stats = self.stats();
+            py::list result;
+            for (std::size_t i = 0; i < stats.size(); i++) {
+                auto &node = stats[i];
+                py::dict entry;
+                entry["node"] = self.node(i).id;
+                entry["batches"] = node.batches;
+                entry["items"] = node.items;
+                entry["local_items"] = node.local_items;
+                entry["seconds"] = node.seconds;
+                entry["busy_seconds"] = node.busy_seconds;
+                entry["items_per_second"] = node.seconds > 0 ? static_cast<double>(node.items) / node.seconds : 0.0;
+                result.append(entry);
+            }
+            return result;
+        }, "Returns per-node batches, items, items whose input was local, wall-clock and worker seconds, and "
+           "throughput in items per wall-clock second.")
+        .def("reset_stats", &NumaWorkerPool::reset_stats);
+}
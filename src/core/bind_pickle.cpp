@@ -0,0 +1,73 @@
+#include "bind_pickle.h"
+#include "context_registry.h"
+#include <seal/ciphertext.h>
+#include <seal/plaintext.h>
+#include <seal/publickey.h>
+#include <seal/relinkeys.h>
+#include <seal/galoiskeys.h>
+#include <seal/encryptionparams.h>
+#include <seal/context.h>
+
+using namespace seal;
+
+void bind_pickle(py::module &m) {
+    // Reconstructors used by __reduce_ex__. Objects bound to a context look the
+    // context up by parms_id in the registry, so a worker process only needs to
+    // create a SEALContext with the same parameters before unpickling.
+    m.def("_unpickle_ciphertext", [](const py::bytes &parms_id, const py::buffer &payload) {
+        auto context = require_context(parms_id_from_bytes(parms_id));
+        Ciphertext ct;
+        load_pickle_payload(ct, payload, *context);
+        return ct;
+    }, py::arg("parms_id"), py::arg("payload"));
+
+    m.def("_unpickle_plaintext", [](const py::bytes &parms_id, const py::buffer &payload) {
+        auto context = require_context(parms_id_from_bytes(parms_id));
+        Plaintext pt;
+        load_pickle_payload(pt, payload, *context);
+        return pt;
+    }, py::arg("parms_id"), py::arg("payload"));
+
+    m.def("_unpickle_public_key", [](const py::bytes &parms_id, const py::buffer &payload) {
+        auto context = require_context(parms_id_from_bytes(parms_id));
+        PublicKey key;
+        load_pickle_payload(key, payload, *context);
+        return key;
+    }, py::arg("parms_id"), py::arg("payload"));
+
+    m.def("_unpickle_relin_keys", [](const py::bytes &parms_id, const py::buffer &payload) {
+        auto context = require_context(parms_id_from_bytes(parms_id));
+        RelinKeys keys;
+        load_pickle_payload(keys, payload, *context);
+        return keys;
+    }, py::arg("parms_id"), py::arg("payload"));
+
+    m.def("_unpickle_galois_keys", [](const py::bytes &parms_id, const py::buffer &payload) {
+        auto context = require_context(parms_id_from_bytes(parms_id));
+        GaloisKeys keys;
+        load_pickle_payload(keys, payload, *context);
+        return keys;
+    }, py::arg("parms_id"), py::arg("payload"));
+
+    m.def("_unpickle_encryption_parameters", [](const py::buffer &payload) {
+        EncryptionParameters parms;
+        load_pickle_payload(parms, payload);
+        return parms;
+    }, py::arg("payload"));
+
+    // Reuses a live context with identical parameters and flags; only builds a
+    // new one (and registers it) when the receiving process has none yet.
+    m.def("_unpickle_context", [](const py::buffer &payload, bool expand_mod_chain, int sec_level) {
+        EncryptionParameters parms;
+        load_pickle_payload(parms, payload);
+        auto level = static_cast<sec_level_type>(sec_level);
+        auto context = find_context(parms.parms_id());
+        if (context && context->key_parms_id() == parms.parms_id() &&
+            context_expand_mod_chain(*context) == expand_mod_chain && context_sec_level(*context) == level) {
+            return context;
+        }
+        context = std::make_shared<SEALContext>(parms, expand_mod_chain, level);
+        register_context(context, expand_mod_chain, level);
+        return context;
+    }, py::arg("payload"), py::arg("expand_mod_chain"), py::arg("sec_level"));
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <seal/serialization.h>
+#include <pybind11/pybind11.h>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+// Serializes a SEAL object in its uncompressed binary format into a fresh
+// bytearray. For pickle protocol 5 and above the bytearray is wrapped in a
+// pickle.PickleBuffer so it can be shipped out-of-band instead of being copied
+// into the pickle stream.
+template <class T>
+py::object pickle_payload(const T &obj, int protocol) {
+    auto size = static_cast<std::size_t>(obj.save_size(seal::compr_mode_type::none));
+    auto buffer = py::reinterpret_steal<py::object>(PyByteArray_FromStringAndSize(nullptr, static_cast<py::ssize_t>(size)));
+    if (!buffer) throw py::error_already_set();
+
+    auto out = reinterpret_cast<seal::seal_byte*>(PyByteArray_AsString(buffer.ptr()));
+    auto written = obj.save(out, size, seal::compr_mode_type::none);
+    if (PyByteArray_Resize(buffer.ptr(), static_cast<py::ssize_t>(written)) != 0) throw py::error_already_set();
+
+    if (protocol >= 5) {
+        return py::module_::import("pickle").attr("PickleBuffer")(buffer);
+    }
+    return buffer;
+}
+
+// Loads a SEAL object previously written by pickle_payload from any object
+// exposing the buffer protocol (bytearray, PickleBuffer, memoryview, mmap).
+template <class T, class... Context>
+void load_pickle_payload(T &obj, const py::buffer &payload, const Context &... context) {
+    py::buffer_info info = payload.request();
+    if (info.ndim != 1 && info.ndim != 0) throw std::invalid_argument("pickle payload must be a contiguous byte buffer");
+    auto size = static_cast<std::size_t>(info.size * info.itemsize);
+    obj.load(context..., reinterpret_cast<const seal::seal_byte*>(info.ptr), size);
+}
+
+// Looks up a reconstructor registered by bind_pickle in the module that owns type.
+inline py::object pickle_reconstructor(const py::handle &type, const char *name) {
+    auto module_name = type.attr("__module__").cast<std::string>();
+    return py::module_::import(module_name.c_str()).attr(name);
+}
+
+// Registers the module-level reconstructors referenced by __reduce_ex__.
+void bind_pickle(py::module &m);
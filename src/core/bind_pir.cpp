@@ -0,0 +1,101 @@
+#include "bind_pir.h"
+#include "pir.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    py::bytes to_bytes(const std::vector<seal_byte> &data) {
+        return py::bytes(reinterpret_cast<const char *>(data.data()), data.size());
+    }
+}
+
+void bind_pir(py::module &m) {
+    py::class_<PIRServer, std::shared_ptr<PIRServer>>(m, "PIRServer")
+        .def(py::init<std::shared_ptr<SEALContext>, std::size_t>(), py::arg("context"), py::arg("threads") = 0,
+            "Creates a PIR server for a BFV/BGV batching context; threads=0 shares the process-wide pool.")
+
+        .def("set_database", [](PIRServer &self, const std::vector<std::vector<std::uint64_t>> &rows) {
+            py::gil_scoped_release release;
+            self.set_database(rows);
+        }, py::arg("rows"),
+            "Preprocesses rows (lists of at most slot_count values below the plain modulus) into NTT-form plaintexts.")
+        .def("save_database", &PIRServer::save_database, py::arg("path"),
+            "Writes the preprocessed database to a file that load_database can memory-map.")
+        .def("load_database", [](PIRServer &self, const std::string &path) {
+            py::gil_scoped_release release;
+            self.load_database(path);
+        }, py::arg("path"),
+            "Memory-maps a database written by save_database for the same encryption parameters.")
+
+        .def("item_count", &PIRServer::item_count)
+        .def("database_bytes", &PIRServer::database_bytes,
+            "Returns the size of the preprocessed rows in bytes.")
+        .def("mapped", &PIRServer::mapped,
+            "Returns True when the database is served from a memory-mapped file.")
+
+        .def("answer", [](const PIRServer &self, const std::vector<Ciphertext> &query, const GaloisKeys &galois_keys,
+                          bool compress_response) {
+            py::gil_scoped_release release;
+            return self.answer(query, galois_keys, compress_response);
+        }, py::arg("query"), py::arg("galois_keys"), py::arg("compress_response") = true,
+            "Expands the query ciphertexts and returns an encryption of the selected row.")
+        .def("process_query", [](const PIRServer &self, const std::vector<py::bytes> &query, const GaloisKeys &galois_keys,
+                                 bool compress_response) {
+            std::vector<std::string> blobs(query.begin(), query.end());
+            std::vector<seal_byte> response;
+            {
+                py::gil_scoped_release release;
+                response = self.process_query(blobs, galois_keys, compress_response);
+            }
+            return to_bytes(response);
+        }, py::arg("query"), py::arg("galois_keys"), py::arg("compress_response") = true,
+            "Answers a serialized query (as returned by PIRClient.query) and returns the serialized response.")
+
+        .def("stats", [](const PIRServer &self) {
+            auto stats = self.stats();
+            py::dict result;
+            result["queries"] = stats.queries;
+            result["last_query_seconds"] = stats.last_query_seconds;
+            result["total_query_seconds"] = stats.total_query_seconds;
+            result["qps"] = stats.total_query_seconds > 0 ? static_cast<double>(stats.queries) / stats.total_query_seconds : 0.0;
+            result["last_query_bytes"] = stats.last_query_bytes;
+            result["last_response_bytes"] = stats.last_response_bytes;
+            result["item_count"] = self.item_count();
+            result["database_bytes"] = self.database_bytes();
+            return result;
+        }, "Returns query count, latency, queries per second and query/response sizes.")
+        .def("reset_stats", &PIRServer::reset_stats);
+
+    py::class_<PIRClient, std::shared_ptr<PIRClient>>(m, "PIRClient")
+        .def(py::init<std::shared_ptr<SEALContext>, const SecretKey &>(), py::arg("context"), py::arg("secret_key"))
+
+        .def_static("galois_elts", [](std::shared_ptr<SEALContext> context, std::size_t item_count) {
+            return PIRClient::galois_elts(*context, item_count);
+        }, py::arg("context"), py::arg("item_count"),
+            "Returns the Galois elements the server needs; pass them to KeyGenerator.create_galois_keys_from_elts.")
+
+        .def("query", [](const PIRClient &self, std::size_t index, std::size_t item_count) {
+            std::vector<std::vector<seal_byte>> blobs;
+            {
+                py::gil_scoped_release release;
+                blobs = self.query(index, item_count);
+            }
+            py::list result;
+            for (auto &blob : blobs) result.append(to_bytes(blob));
+            return result;
+        }, py::arg("index"), py::arg("item_count"),
+            "Builds a compressed query for row index; returns one bytes object per block of poly_modulus_degree rows.")
+
+        .def("decode", [](const PIRClient &self, const Ciphertext &answer) {
+            return self.decode(answer);
+        }, py::arg("answer"))
+        .def("decode", [](const PIRClient &self, const py::bytes &response) {
+            std::string blob = response;
+            return self.decode(reinterpret_cast<const seal_byte *>(blob.data()), blob.size());
+        }, py::arg("response"),
+            "Decrypts a serialized response into the row values.")
+        .def("noise_budget", &PIRClient::noise_budget, py::arg("answer"));
+}
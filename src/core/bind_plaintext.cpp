@@ -1,5 +1,8 @@
 
 #include "bind_plaintext.h"
+#include "bind_pickle.h"
+#include "context_registry.h"
+#include "bind_memo.h"
 #include <seal/plaintext.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -77,5 +80,17 @@ void bind_plaintext(py::module &m) {
         // Comparison
         .def("__eq__", [](const Plaintext &a, const Plaintext &b) { return a == b; })
         .def("__ne__", [](const Plaintext &a, const Plaintext &b) { return a != b; })
+
+        // Content hash over parms_id, scale and data (not cryptographic)
+        .def("content_hash", [](const Plaintext &self) { return content_hash_to_int(content_hash(self)); },
+            "Returns a 128-bit hash of the parms_id, scale and data as an int.")
+
+        // Pickle support; plaintexts without a parms_id (BFV/BGV, non-NTT) are
+        // re-attached to the newest live context when unpickled
+        .def("__reduce_ex__", [](const Plaintext &self, int protocol) {
+            return py::make_tuple(
+                pickle_reconstructor(py::type::of<Plaintext>(), "_unpickle_plaintext"),
+                py::make_tuple(parms_id_to_bytes(self.parms_id()), pickle_payload(self, protocol)));
+        }, py::arg("protocol"))
         ;
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "bind_pool.h"
+#include "object_pool.h"
+#include "context_registry.h"
+#include <pybind11/pybind11.h>
+#include <algorithm>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    py::dict pool_stats_to_dict(const PoolStats &stats) {
+        py::dict result;
+        result["created"] = stats.created;
+        result["acquires"] = stats.acquires;
+        result["releases"] = stats.releases;
+        result["reuses"] = stats.acquires - std::min(stats.acquires, stats.created);
+        result["reallocations"] = stats.reallocations;
+        result["outstanding"] = stats.outstanding;
+        result["free"] = stats.free;
+        return result;
+    }
+
+    parms_id_type optional_parms_id(const py::object &parms_id) {
+        return parms_id.is_none() ? parms_id_zero : parms_id_from_bytes(parms_id.cast<py::bytes>());
+    }
+}
+
+void bind_pool(py::module &m) {
+    py::class_<CiphertextPool, std::shared_ptr<CiphertextPool>>(m, "CiphertextPool")
+        .def(py::init([](std::shared_ptr<SEALContext> context, const py::object &parms_id, std::size_t size_capacity,
+                         std::size_t preallocate) {
+            return std::make_shared<CiphertextPool>(context, optional_parms_id(parms_id), size_capacity, preallocate);
+        }), py::arg("context"), py::arg("parms_id") = py::none(), py::arg("size_capacity") = 3,
+            py::arg("preallocate") = 0,
+            "Creates a pool of ciphertexts reserved (reserve_with_context) for parms_id (bytes; the first data level "
+            "by default) with room for size_capacity polynomials.")
+        .def("acquire", &CiphertextPool::acquire, py::return_value_policy::reference_internal,
+            "Returns a reserved Ciphertext owned by the pool; hand it back with release.")
+        .def("release", &CiphertextPool::release, py::arg("ciphertext"),
+            "Returns a ciphertext to the pool. It must not be used afterwards.")
+        .def("preallocate", &CiphertextPool::preallocate, py::arg("count"))
+        .def("shrink", &CiphertextPool::shrink, "Frees the released ciphertexts.")
+        .def("parms_id", [](const CiphertextPool &self) { return parms_id_to_bytes(self.parms_id()); })
+        .def_property_readonly("size_capacity", &CiphertextPool::size_capacity)
+        .def("stats", [](const CiphertextPool &self) { return pool_stats_to_dict(self.stats()); },
+            "Returns objects created, acquires, releases, reuses, buffer reallocations seen on release, and the "
+            "outstanding and free counts.")
+        .def("reset_stats", &CiphertextPool::reset_stats);
+
+    py::class_<PlaintextPool, std::shared_ptr<PlaintextPool>>(m, "PlaintextPool")
+        .def(py::init([](std::shared_ptr<SEALContext> context, const py::object &parms_id, std::size_t preallocate) {
+            return std::make_shared<PlaintextPool>(context, optional_parms_id(parms_id), preallocate);
+        }), py::arg("context"), py::arg("parms_id") = py::none(), py::arg("preallocate") = 0,
+            "Creates a pool of plaintexts with room for one polynomial at parms_id (bytes; the first data level "
+            "by default).")
+        .def("acquire", &PlaintextPool::acquire, py::return_value_policy::reference_internal,
+            "Returns a reserved Plaintext owned by the pool; hand it back with release.")
+        .def("release", &PlaintextPool::release, py::arg("plaintext"),
+            "Returns a plaintext to the pool. It must not be used afterwards.")
+        .def("preallocate", &PlaintextPool::preallocate, py::arg("count"))
+        .def("shrink", &PlaintextPool::shrink, "Frees the released plaintexts.")
+        .def("parms_id", [](const PlaintextPool &self) { return parms_id_to_bytes(self.parms_id()); })
+        .def_property_readonly("coeff_capacity", &PlaintextPool::coeff_capacity)
+        .def("stats", [](const PlaintextPool &self) { return pool_stats_to_dict(self.stats()); },
+            "Returns objects created, acquires, releases, reuses, buffer reallocations seen on release, and the "
+            "outstanding and free counts.")
+        .def("reset_stats", &PlaintextPool::reset_stats);
+}
@@ -0,0 +1,90 @@
+#include "bind_psi.h"
+#include "psi.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    PSIParams make_params(std::size_t hash_count, std::size_t partition_size, std::size_t window,
+                          std::uint64_t seed) {
+        PSIParams params;
+        params.hash_count = hash_count;
+        params.partition_size = partition_size;
+        params.window = window;
+        params.seed = seed;
+        return params;
+    }
+}
+
+void bind_psi(py::module &m) {
+    py::class_<PSIQuery, std::shared_ptr<PSIQuery>>(m, "PSIQuery")
+        .def_property_readonly("ciphertexts", [](const PSIQuery &self) { return self.ciphertexts; },
+            "The ciphertexts to send to the sender.")
+        .def_property_readonly("items", [](const PSIQuery &self) { return self.items; },
+            "The distinct query items, in query order.");
+
+    py::class_<PSISender, std::shared_ptr<PSISender>>(m, "PSISender")
+        .def(py::init([](std::shared_ptr<SEALContext> context, std::size_t hash_count, std::size_t partition_size,
+                         std::size_t window, std::uint64_t seed, std::size_t threads) {
+            return std::make_shared<PSISender>(context, make_params(hash_count, partition_size, window, seed),
+                                               threads);
+        }), py::arg("context"), py::arg("hash_count") = 3, py::arg("partition_size") = 32, py::arg("window") = 3,
+            py::arg("seed") = 0, py::arg("threads") = 0,
+            "Creates the sender side of PSI for a BFV batching context. hash_count, partition_size, window and seed "
+            "must match the receiver's; threads=0 shares the process-wide pool.")
+
+        .def("set_items", [](PSISender &self, const std::vector<std::uint64_t> &items) {
+            py::gil_scoped_release release;
+            self.set_items(items);
+        }, py::arg("items"),
+            "Hashes the set into bins and encodes every partition's polynomial coefficients as NTT-form plaintexts.")
+        .def_property_readonly("item_count", &PSISender::item_count)
+        .def_property_readonly("bin_load", &PSISender::bin_load, "Largest number of values in one bin.")
+        .def_property_readonly("partition_count", &PSISender::partition_count,
+            "Upper bound on the response ciphertexts per query; 0 for an empty set.")
+
+        .def("respond", [](const PSISender &self, const std::vector<Ciphertext> &query, const RelinKeys &relin_keys) {
+            py::gil_scoped_release release;
+            return self.respond(query, relin_keys);
+        }, py::arg("query"), py::arg("relin_keys"),
+            "Evaluates every partition's polynomial on the query and returns one ciphertext per partition.")
+
+        .def("stats", [](const PSISender &self) {
+            auto stats = self.stats();
+            py::dict result;
+            result["queries"] = stats.queries;
+            result["preprocess_seconds"] = stats.preprocess_seconds;
+            result["last_query_seconds"] = stats.last_query_seconds;
+            result["total_query_seconds"] = stats.total_query_seconds;
+            result["item_count"] = self.item_count();
+            result["items_per_second"] = stats.last_query_seconds > 0
+                ? static_cast<double>(self.item_count()) / stats.last_query_seconds : 0.0;
+            return result;
+        }, "Returns preprocessing time, query count and latency, and sender items matched per second.")
+        .def("reset_stats", &PSISender::reset_stats);
+
+    py::class_<PSIReceiver, std::shared_ptr<PSIReceiver>>(m, "PSIReceiver")
+        .def(py::init([](std::shared_ptr<SEALContext> context, const SecretKey &secret_key, std::size_t hash_count,
+                         std::size_t partition_size, std::size_t window, std::uint64_t seed) {
+            return std::make_shared<PSIReceiver>(context, secret_key,
+                                                 make_params(hash_count, partition_size, window, seed));
+        }), py::arg("context"), py::arg("secret_key"), py::arg("hash_count") = 3, py::arg("partition_size") = 32,
+            py::arg("window") = 3, py::arg("seed") = 0)
+        .def_property_readonly("query_size", &PSIReceiver::query_size, "Ciphertexts per query.")
+        .def_property_readonly("depth", &PSIReceiver::depth,
+            "Ciphertext multiplications the sender's power computation stacks.")
+
+        .def("query", [](const PSIReceiver &self, const std::vector<std::uint64_t> &items) {
+            py::gil_scoped_release release;
+            return std::make_shared<PSIQuery>(self.query(items));
+        }, py::arg("items"),
+            "Cuckoo-hashes at most slot_count distinct items into bins and encrypts their windowed powers.")
+        .def("intersect", [](const PSIReceiver &self, const PSIQuery &query, const std::vector<Ciphertext> &response) {
+            py::gil_scoped_release release;
+            return self.intersect(query, response);
+        }, py::arg("query"), py::arg("response"),
+            "Decrypts the sender's response and returns the query items in the intersection.")
+        .def("noise_budget", &PSIReceiver::noise_budget, py::arg("response"));
+}
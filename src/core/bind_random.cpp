@@ -1,6 +1,7 @@
 #include <seal/randomgen.h>
 #include <pybind11/pybind11.h>
 #include "bind_random.h"
+#include "prng_pool.h"
 #include <random>
 #include <fstream>
 
@@ -64,6 +65,58 @@ void bind_random(py::module &m) {
         .def(py::init<>())
         .def(py::init<prng_seed_type>());
 
+    // Factory with per-thread seed streams; install with
+    // EncryptionParameters.set_random_generator before creating the context
+    py::class_<PooledPRNGFactory, UniformRandomGeneratorFactory, std::shared_ptr<PooledPRNGFactory>>(m, "PooledPRNGFactory")
+        .def(py::init([](prng_type backend, std::size_t buffer_size, const prng_seed_type *seed) {
+            if (seed) return std::make_shared<PooledPRNGFactory>(backend, buffer_size, *seed);
+            return std::make_shared<PooledPRNGFactory>(backend, buffer_size);
+        }), py::arg("backend") = prng_type::blake2xb, py::arg("buffer_size") = 4096, py::arg("seed") = nullptr,
+            "Creates a factory whose generators are seeded from a per-thread stream instead of the OS. With a seed, "
+            "the n-th thread to use it gets a stream derived from seed and n, so single-threaded runs repeat exactly.")
+        .def("set_thread_seed", &PooledPRNGFactory::set_thread_seed, py::arg("seed"),
+            "Restarts the calling thread's seed stream from seed.")
+        .def_property_readonly("backend", &PooledPRNGFactory::backend)
+        .def_property_readonly("buffer_size", &PooledPRNGFactory::buffer_size)
+        .def("stats", [](const PooledPRNGFactory &self) {
+            auto stats = self.stats();
+            py::dict result;
+            result["generators"] = stats.generators;
+            result["threads"] = stats.threads;
+            return result;
+        }, "Returns the number of generators created and of threads holding a seed stream.");
+
+    m.def("benchmark_prng", [](UniformRandomGeneratorFactory &factory, std::size_t count, std::size_t bytes_per_generator,
+                               std::size_t threads) {
+        ThroughputResult run;
+        {
+            py::gil_scoped_release release;
+            run = benchmark_prng(factory, count, bytes_per_generator, threads);
+        }
+        py::dict result;
+        result["seconds"] = run.seconds;
+        result["generators_per_second"] = run.seconds > 0 ? static_cast<double>(run.count) / run.seconds : 0.0;
+        result["mb_per_second"] = run.seconds > 0 ? static_cast<double>(run.bytes) / run.seconds / 1e6 : 0.0;
+        return result;
+    }, py::arg("factory"), py::arg("count") = 10000, py::arg("bytes_per_generator") = 4096, py::arg("threads") = 0,
+        "Times creating count generators and drawing bytes_per_generator from each, on threads workers.");
+
+    m.def("benchmark_encryption", [](const SEALContext &context, const PublicKey &public_key, const Plaintext &plain,
+                                     std::size_t count, std::size_t threads, const SecretKey *secret_key) {
+        ThroughputResult run;
+        {
+            py::gil_scoped_release release;
+            run = benchmark_encryption(context, public_key, plain, count, threads, secret_key);
+        }
+        py::dict result;
+        result["seconds"] = run.seconds;
+        result["encryptions_per_second"] = run.seconds > 0 ? static_cast<double>(run.count) / run.seconds : 0.0;
+        return result;
+    }, py::arg("context"), py::arg("public_key"), py::arg("plain"), py::arg("count") = 1000, py::arg("threads") = 0,
+        py::arg("secret_key") = nullptr,
+        "Times count encryptions of plain on threads workers sharing one Encryptor (symmetric when secret_key is "
+        "given), using the PRNG factory of the context's parameters.");
+
     // Expose prng_seed_type as a Python list of 8 uint64_t
     py::class_<prng_seed_type>(m, "prng_seed_type")
         .def(py::init<>())
@@ -0,0 +1,58 @@
+#include "bind_rotation.h"
+#include "rotation_planner.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+void bind_rotation(py::module &m) {
+    py::class_<RotationPlanner, std::shared_ptr<RotationPlanner>>(m, "RotationPlanner")
+        .def(py::init<std::shared_ptr<SEALContext>, const GaloisKeys &, std::size_t>(), py::arg("context"),
+            py::arg("galois_keys"), py::arg("threads") = 0, py::keep_alive<1, 3>(),
+            "Creates a planner over the rotation steps galois_keys holds keys for (rotate_vector steps for CKKS, "
+            "rotate_rows steps for BFV/BGV).")
+        .def_static("from_steps", [](std::shared_ptr<SEALContext> context, const std::vector<int> &key_steps) {
+            return std::make_shared<RotationPlanner>(context, key_steps);
+        }, py::arg("context"), py::arg("key_steps"),
+            "Creates a planning-only planner for a hypothetical key set; rotate and rotate_many raise.")
+        .def_static("galois_key_steps", py::overload_cast<const SEALContext &, const GaloisKeys &>(
+            &RotationPlanner::key_steps), py::arg("context"), py::arg("galois_keys"),
+            "Returns the rotation steps galois_keys holds a key for.")
+
+        .def("key_steps", py::overload_cast<>(&RotationPlanner::key_steps, py::const_))
+        .def_property_readonly("slots", &RotationPlanner::slots)
+        .def("decompose", &RotationPlanner::decompose, py::arg("step"),
+            "Returns key steps summing to step with the fewest key switches. Raises ValueError when unreachable.")
+        .def("cost", &RotationPlanner::cost, py::arg("step"), "Returns the key switches needed for step.")
+        .def("plan", [](const RotationPlanner &self, const std::vector<int> &steps) {
+            auto plan = self.plan(steps);
+            py::list tree;
+            for (auto &step : plan.steps) {
+                tree.append(py::make_tuple(step.target, step.parent, step.key_step, step.depth));
+            }
+            py::dict result;
+            result["steps"] = tree;
+            result["keyswitches"] = plan.keyswitches;
+            result["independent_keyswitches"] = plan.independent_keyswitches;
+            result["depth"] = plan.depth;
+            return result;
+        }, py::arg("steps"),
+            "Returns the shared rotation tree for steps as (target, parent, key_step, depth) tuples, with its key "
+            "switch count and the count without sharing.")
+
+        .def("rotate", &RotationPlanner::rotate, py::arg("encrypted"), py::arg("step"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("rotate_many", &RotationPlanner::rotate_many, py::arg("encrypted"), py::arg("steps"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Returns encrypted rotated by every step, sharing intermediate rotations and running each tree level "
+            "in parallel.")
+
+        .def_static("recommend_keys", [](const SEALContext &context, const std::vector<int> &steps,
+                                         std::size_t max_keys, const std::vector<double> &weights) {
+            py::gil_scoped_release release;
+            return RotationPlanner::recommend_keys(context, steps, weights, max_keys);
+        }, py::arg("context"), py::arg("steps"), py::arg("max_keys"), py::arg("weights") = std::vector<double>(),
+            "Returns at most max_keys rotation steps to generate Galois keys for, chosen greedily to minimize the "
+            "(weighted) total key switches of the workload.");
+}
@@ -10,6 +10,7 @@
 #include <seal/context.h>
 #include <fstream>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 
 namespace py = pybind11;
@@ -98,6 +99,24 @@ void bind_serialization(py::module &m) {
         return ct;
     }, py::arg("context"), py::arg("path"));
 
+    // Several ciphertexts back to back in one file, e.g. for StreamingReducer
+    m.def("save_ciphertexts", [](const std::vector<const Ciphertext *> &cts, const std::string &path, bool append) {
+        std::ofstream out(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+        if (!out.is_open()) throw std::runtime_error("Cannot open file: " + path);
+        for (auto ct : cts) ct->save(out);
+    }, py::arg("cts"), py::arg("path"), py::arg("append") = false);
+
+    m.def("load_ciphertexts", [](const SEALContext &context, const std::string &path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) throw std::runtime_error("Cannot open file: " + path);
+        std::vector<Ciphertext> cts;
+        while (in.peek() != std::ifstream::traits_type::eof()) {
+            cts.emplace_back();
+            cts.back().load(context, in);
+        }
+        return cts;
+    }, py::arg("context"), py::arg("path"));
+
     // Load plaintext
     m.def("load_plaintext", [](const SEALContext &context, const std::string &path) {
         std::ifstream in(path, std::ios::binary);
@@ -0,0 +1,49 @@
+#include "bind_stream.h"
+#include "stream_reducer.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+void bind_stream(py::module &m) {
+    py::class_<StreamingReducer, std::shared_ptr<StreamingReducer>>(m, "StreamingReducer")
+        .def(py::init<std::shared_ptr<SEALContext>, std::size_t, std::size_t, std::size_t>(), py::arg("context"),
+            py::arg("readers") = 2, py::arg("workers") = 0, py::arg("queue_capacity") = 64,
+            "Creates a three-stage reducer: reader threads, compute workers (0 = one per core) and a tree merge, "
+            "connected by a queue holding at most queue_capacity ciphertexts.")
+
+        .def("sum", [](StreamingReducer &self, const std::vector<std::string> &paths) {
+            py::gil_scoped_release release;
+            return self.reduce(paths, StreamingReducer::Mode::sum);
+        }, py::arg("paths"),
+            "Returns the sum of every ciphertext stored in the files (each may hold many, see save_ciphertexts).")
+        .def("sum_of_squares", [](StreamingReducer &self, const std::vector<std::string> &paths,
+                                  const RelinKeys *relin_keys, bool rescale) {
+            py::gil_scoped_release release;
+            return self.reduce(paths, StreamingReducer::Mode::sum_of_squares, relin_keys, rescale);
+        }, py::arg("paths"), py::arg("relin_keys") = nullptr, py::arg("rescale") = true,
+            "Returns the sum of squares, relinearized once when relin_keys is given and, for CKKS, rescaled once.")
+
+        .def("stats", [](const StreamingReducer &self) {
+            auto stats = self.stats();
+            py::dict result;
+            result["items"] = stats.items;
+            result["bytes"] = stats.bytes;
+            result["seconds"] = stats.seconds;
+            result["items_per_second"] = stats.seconds > 0 ? static_cast<double>(stats.items) / stats.seconds : 0.0;
+            result["mb_per_second"] = stats.seconds > 0 ? static_cast<double>(stats.bytes) / stats.seconds / 1e6 : 0.0;
+            result["reader_busy_seconds"] = stats.reader_busy_seconds;
+            result["reader_stall_seconds"] = stats.reader_stall_seconds;
+            result["worker_busy_seconds"] = stats.worker_busy_seconds;
+            result["worker_stall_seconds"] = stats.worker_stall_seconds;
+            result["merge_seconds"] = stats.merge_seconds;
+            result["queue_high_water"] = stats.queue_high_water;
+            return result;
+        }, "Returns throughput and per-stage busy/stall seconds of the last reduction. Reader stalls mean compute "
+           "is the bottleneck; worker stalls mean I/O is.")
+
+        .def_property_readonly("readers", &StreamingReducer::readers)
+        .def_property_readonly("workers", &StreamingReducer::workers)
+        .def_property_readonly("queue_capacity", &StreamingReducer::queue_capacity);
+}
@@ -0,0 +1,101 @@
+#include "bind_trusted.h"
+#include "trusted_store.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    py::dict load_stats_to_dict(const LoadStats &stats) {
+        py::dict result;
+        result["objects"] = stats.objects;
+        result["bytes"] = stats.bytes;
+        result["seconds"] = stats.seconds;
+        result["verify_seconds"] = stats.verify_seconds;
+        result["objects_per_second"] = stats.seconds > 0 ? static_cast<double>(stats.objects) / stats.seconds : 0.0;
+        result["mb_per_second"] = stats.seconds > 0 ? static_cast<double>(stats.bytes) / stats.seconds / 1e6 : 0.0;
+        return result;
+    }
+
+    template <class T>
+    void save_one(const TrustedStore &self, const T &obj, const std::string &path, bool compress) {
+        py::gil_scoped_release release;
+        self.save(std::vector<const T *>{ &obj }, path, compress);
+    }
+
+    template <class T>
+    T load_one(TrustedStore &self, const SEALContext &context, const std::string &path) {
+        py::gil_scoped_release release;
+        auto objects = self.load<T>(context, path);
+        if (objects.size() != 1) throw std::invalid_argument(path + " does not hold exactly one object");
+        return std::move(objects.front());
+    }
+}
+
+void bind_trusted(py::module &m) {
+    py::enum_<Integrity>(m, "Integrity")
+        .value("none", Integrity::none)
+        .value("hash", Integrity::hash)
+        .value("mac", Integrity::mac);
+
+    py::class_<TrustedStore, std::shared_ptr<TrustedStore>>(m, "TrustedStore")
+        .def(py::init([](const std::string &key, Integrity integrity, std::size_t threads) {
+            return std::make_shared<TrustedStore>(integrity, std::vector<unsigned char>(key.begin(), key.end()), threads);
+        }), py::arg("key") = std::string(), py::arg("integrity") = Integrity::mac, py::arg("threads") = 0,
+            "Creates a store for files we wrote ourselves. Loads verify each object's tag (keyed BLAKE2b for mac, "
+            "a 128-bit content hash for hash, nothing for none) and then skip SEAL's per-coefficient validation. "
+            "key (1 to 64 bytes) is required for mac.")
+
+        .def("save", [](const TrustedStore &self, const std::vector<const Ciphertext *> &cts, const std::string &path,
+                        bool compress) {
+            py::gil_scoped_release release;
+            self.save(cts, path, compress);
+        }, py::arg("cts"), py::arg("path"), py::arg("compress") = true)
+        .def("save", [](const TrustedStore &self, const std::vector<const Plaintext *> &plains, const std::string &path,
+                        bool compress) {
+            py::gil_scoped_release release;
+            self.save(plains, path, compress);
+        }, py::arg("plains"), py::arg("path"), py::arg("compress") = true)
+        .def("save", &save_one<PublicKey>, py::arg("obj"), py::arg("path"), py::arg("compress") = true)
+        .def("save", &save_one<SecretKey>, py::arg("obj"), py::arg("path"), py::arg("compress") = true)
+        .def("save", &save_one<RelinKeys>, py::arg("obj"), py::arg("path"), py::arg("compress") = true)
+        .def("save", &save_one<GaloisKeys>, py::arg("obj"), py::arg("path"), py::arg("compress") = true,
+            "Writes the objects with their integrity tags. compress=False makes larger files that load faster.")
+
+        .def("load_ciphertexts", &TrustedStore::load<Ciphertext>, py::arg("context"), py::arg("path"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("load_plaintexts", &TrustedStore::load<Plaintext>, py::arg("context"), py::arg("path"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("load_public_key", &load_one<PublicKey>, py::arg("context"), py::arg("path"))
+        .def("load_secret_key", &load_one<SecretKey>, py::arg("context"), py::arg("path"))
+        .def("load_relin_keys", &load_one<RelinKeys>, py::arg("context"), py::arg("path"))
+        .def("load_galois_keys", &load_one<GaloisKeys>, py::arg("context"), py::arg("path"),
+            "Loads objects saved by a store with the same integrity mode and key. Raises RuntimeError when a tag "
+            "does not match.")
+
+        .def("stats", [](const TrustedStore &self) { return load_stats_to_dict(self.stats()); },
+            "Returns objects, bytes, seconds and tag verification seconds (summed over threads) of the last load.")
+        .def_property_readonly("integrity", &TrustedStore::integrity)
+        .def_property_readonly("threads", &TrustedStore::threads);
+
+    py::class_<BulkLoader, std::shared_ptr<BulkLoader>>(m, "BulkLoader")
+        .def(py::init<std::shared_ptr<SEALContext>, std::size_t>(), py::arg("context"), py::arg("threads") = 0,
+            "Creates a loader that fully validates untrusted objects, one task per object.")
+
+        .def("load_ciphertexts", py::overload_cast<const std::string &>(&BulkLoader::load<Ciphertext>),
+            py::arg("path"), py::call_guard<py::gil_scoped_release>(),
+            "Loads every ciphertext of a file written by save_ciphertexts.")
+        .def("load_ciphertexts_from_bytes",
+            py::overload_cast<const std::vector<std::string> &>(&BulkLoader::load<Ciphertext>), py::arg("buffers"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("load_plaintexts", py::overload_cast<const std::string &>(&BulkLoader::load<Plaintext>),
+            py::arg("path"), py::call_guard<py::gil_scoped_release>())
+        .def("load_plaintexts_from_bytes",
+            py::overload_cast<const std::vector<std::string> &>(&BulkLoader::load<Plaintext>), py::arg("buffers"),
+            py::call_guard<py::gil_scoped_release>())
+
+        .def("stats", [](const BulkLoader &self) { return load_stats_to_dict(self.stats()); },
+            "Returns objects, bytes and seconds of the last load.")
+        .def_property_readonly("threads", &BulkLoader::threads);
+}
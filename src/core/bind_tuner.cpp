@@ -0,0 +1,108 @@
+#include "bind_tuner.h"
+#include "tuner.h"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <sstream>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    TuningRequest make_request(scheme_type scheme, int depth, int precision_bits, int integer_bits, int plain_modulus_bits,
+                               std::size_t slots, std::size_t rotations, sec_level_type sec_level, std::size_t trials) {
+        TuningRequest request;
+        request.scheme = scheme;
+        request.depth = depth;
+        request.precision_bits = precision_bits;
+        request.integer_bits = integer_bits;
+        request.plain_modulus_bits = plain_modulus_bits;
+        request.slots = slots;
+        request.rotations = rotations;
+        request.sec_level = sec_level;
+        request.trials = trials;
+        return request;
+    }
+
+    std::string format_report(const TuningResult &result) {
+        std::ostringstream out;
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        for (std::size_t i = 0; i < result.candidates.size(); i++) {
+            auto &c = result.candidates[i];
+            out << (i == result.best ? "* " : "  ") << "N=" << c.poly_modulus_degree << " bits=[";
+            for (std::size_t j = 0; j < c.bit_sizes.size(); j++) out << (j ? "," : "") << c.bit_sizes[j];
+            out << "] " << c.total_bits << "/" << c.max_bits << " ";
+            if (c.passed) {
+                out << "circuit=" << c.circuit_ms << "ms mul=" << c.multiply_ms << "ms rot=" << c.rotate_ms
+                    << "ms ct=" << c.ciphertext_bytes << "B keys=" << (c.relin_key_bytes + c.galois_key_bytes) << "B";
+            } else {
+                out << "FAILED: " << c.failure;
+            }
+            out << "\n";
+        }
+        return out.str();
+    }
+}
+
+void bind_tuner(py::module &m) {
+    py::class_<CandidateReport>(m, "CandidateReport")
+        .def_readonly("parms", &CandidateReport::parms)
+        .def_readonly("poly_modulus_degree", &CandidateReport::poly_modulus_degree)
+        .def_readonly("bit_sizes", &CandidateReport::bit_sizes)
+        .def_readonly("total_bits", &CandidateReport::total_bits)
+        .def_readonly("max_bits", &CandidateReport::max_bits)
+        .def_readonly("scale", &CandidateReport::scale)
+        .def_readonly("passed", &CandidateReport::passed)
+        .def_readonly("failure", &CandidateReport::failure)
+        .def_readonly("keygen_ms", &CandidateReport::keygen_ms)
+        .def_readonly("encrypt_ms", &CandidateReport::encrypt_ms)
+        .def_readonly("multiply_ms", &CandidateReport::multiply_ms)
+        .def_readonly("rescale_ms", &CandidateReport::rescale_ms)
+        .def_readonly("rotate_ms", &CandidateReport::rotate_ms)
+        .def_readonly("decrypt_ms", &CandidateReport::decrypt_ms)
+        .def_readonly("circuit_ms", &CandidateReport::circuit_ms)
+        .def_readonly("ciphertext_bytes", &CandidateReport::ciphertext_bytes)
+        .def_readonly("relin_key_bytes", &CandidateReport::relin_key_bytes)
+        .def_readonly("galois_key_bytes", &CandidateReport::galois_key_bytes)
+        .def_readonly("precision_bits", &CandidateReport::precision_bits)
+        .def_readonly("noise_budget", &CandidateReport::noise_budget)
+        .def("__repr__", [](const CandidateReport &self) {
+            return "<CandidateReport N=" + std::to_string(self.poly_modulus_degree) + " total_bits=" +
+                   std::to_string(self.total_bits) + (self.passed ? " passed" : " failed") + ">";
+        });
+
+    py::class_<TuningResult>(m, "TuningResult")
+        .def_readonly("candidates", &TuningResult::candidates)
+        .def_readonly("best_index", &TuningResult::best)
+        .def_property_readonly("best", &TuningResult::best_candidate)
+        .def_property_readonly("parms", [](const TuningResult &self) { return self.best_candidate().parms; },
+            "The fastest passing EncryptionParameters.")
+        .def_property_readonly("scale", [](const TuningResult &self) { return self.best_candidate().scale; },
+            "CKKS scale the best candidate was validated with (0 for BFV/BGV).")
+        .def("report", &format_report,
+            "Returns a table of every candidate with its cost; the chosen one is marked with '*'.");
+
+    py::class_<ParameterTuner>(m, "ParameterTuner")
+        .def_static("candidates", [](scheme_type scheme, int depth, int precision_bits, int integer_bits,
+                                     int plain_modulus_bits, std::size_t slots, std::size_t rotations,
+                                     sec_level_type sec_level) {
+            return ParameterTuner::candidates(make_request(scheme, depth, precision_bits, integer_bits,
+                                                           plain_modulus_bits, slots, rotations, sec_level, 1));
+        }, py::arg("scheme"), py::arg("depth"), py::arg("precision_bits") = 20, py::arg("integer_bits") = 10,
+            py::arg("plain_modulus_bits") = 20, py::arg("slots") = 0, py::arg("rotations") = 0,
+            py::arg("sec_level") = sec_level_type::tc128,
+            "Lists EncryptionParameters within the security bound that may satisfy the request.")
+
+        .def_static("tune", [](scheme_type scheme, int depth, int precision_bits, int integer_bits,
+                               int plain_modulus_bits, std::size_t slots, std::size_t rotations,
+                               sec_level_type sec_level, std::size_t trials) {
+            auto request = make_request(scheme, depth, precision_bits, integer_bits, plain_modulus_bits, slots,
+                                        rotations, sec_level, trials);
+            py::gil_scoped_release release;
+            return ParameterTuner::tune(request);
+        }, py::arg("scheme"), py::arg("depth"), py::arg("precision_bits") = 20, py::arg("integer_bits") = 10,
+            py::arg("plain_modulus_bits") = 20, py::arg("slots") = 0, py::arg("rotations") = 0,
+            py::arg("sec_level") = sec_level_type::tc128, py::arg("trials") = 5,
+            "Benchmarks every candidate on this machine and returns the fastest one that passes the circuit check. "
+            "Raises RuntimeError when none passes.");
+}
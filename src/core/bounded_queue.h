@@ -0,0 +1,85 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+// Multi-producer, multi-consumer FIFO with a fixed capacity. push blocks while
+// the queue is full and pop while it is empty; the time spent blocked is
+// added to the caller's stall counter so pipeline stages can report it.
+template <class T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity ? capacity : 1) {}
+
+    // Returns false (dropping item) once the queue is closed
+    bool push(T item, double &stall_seconds) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (items_.size() >= capacity_ && !closed_) {
+            auto start = std::chrono::steady_clock::now();
+            not_full_.wait(lock, [this]() { return closed_ || items_.size() < capacity_; });
+            stall_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (closed_) return false;
+        items_.push_back(std::move(item));
+        if (items_.size() > high_water_) high_water_ = items_.size();
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Returns false when the queue is closed and drained
+    bool pop(T &item, double &stall_seconds) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (items_.empty() && !closed_) {
+            auto start = std::chrono::steady_clock::now();
+            not_empty_.wait(lock, [this]() { return closed_ || !items_.empty(); });
+            stall_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (items_.empty()) return false;
+        item = std::move(items_.front());
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    // Wakes every waiter; queued items can still be popped
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    // Drops queued items, e.g. after a stage failed
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.clear();
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    // Largest number of items queued at once
+    std::size_t high_water() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return high_water_;
+    }
+
+private:
+    std::size_t capacity_;
+    std::deque<T> items_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::size_t high_water_ = 0;
+    bool closed_ = false;
+};
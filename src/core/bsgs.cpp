@@ -0,0 +1,219 @@
+#include "bsgs.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+using namespace seal;
+
+int signed_step(long long step, std::size_t period) {
+    auto n = static_cast<long long>(period);
+    step %= n;
+    if (step < 0) step += n;
+    return static_cast<int>(step > n / 2 ? step - n : step);
+}
+
+template <class T>
+void DiagonalTransform::plan(const DiagonalMaps<T> &maps, std::size_t period) {
+    if (maps.empty() || maps.front().empty()) {
+        throw std::invalid_argument("a linear transform needs inputs and outputs");
+    }
+    if (!period) throw std::invalid_argument("period must be positive");
+    period_ = period;
+    outputs_ = maps.size();
+    inputs_ = maps.front().size();
+
+    long long stride = 0, low = 0, high = 0;
+    bool any = false;
+    for (auto &row : maps) {
+        if (row.size() != inputs_) throw std::invalid_argument("every output must take the same inputs");
+        for (auto &diagonals : row) {
+            for (auto &entry : diagonals) {
+                stride = std::gcd(stride, std::llabs(entry.first));
+                low = any ? std::min(low, entry.first) : entry.first;
+                high = any ? std::max(high, entry.first) : entry.first;
+                any = true;
+            }
+        }
+    }
+    stride_ = stride ? stride : 1;
+    kmin_ = low / stride_;
+    auto span = static_cast<std::size_t>(high / stride_ - kmin_ + 1);
+    while (baby_ * baby_ < span) baby_ *= 2;
+    giants_ = (span + baby_ - 1) / baby_;
+    present_.assign(outputs_ * inputs_ * giants_ * baby_, 0);
+}
+
+template <class T>
+void DiagonalTransform::encode(const DiagonalMaps<T> &maps, const BatchEvaluator &batch, const CKKSEncoder &encoder,
+                               parms_id_type parms_id, double scale) {
+    std::size_t slots = encoder.slot_count();
+    if (slots % period_) throw std::invalid_argument("period must divide the slot count");
+    plain_.resize(present_.size());
+
+    std::vector<std::pair<std::size_t, std::vector<T>>> work;
+    for (std::size_t o = 0; o < outputs_; o++) {
+        for (std::size_t i = 0; i < inputs_; i++) {
+            for (auto &[offset, diagonal] : maps[o][i]) {
+                if (diagonal.size() != period_) throw std::invalid_argument("diagonals must hold period values");
+                bool nonzero = std::any_of(diagonal.begin(), diagonal.end(),
+                                           [scale](const T &v) { return std::abs(v) * scale >= 0.5; });
+                if (!nonzero) continue;
+                std::size_t entry = index(o, i, offset);
+
+                // Pre-rotate by -giant so the giant-step rotation happens once per sum
+                auto n = static_cast<long long>(period_);
+                auto shift = static_cast<std::size_t>(giant_step((entry / baby_) % giants_) + n) % period_;
+                std::vector<T> rotated(slots);
+                for (std::size_t s = 0; s < slots; s++) rotated[s] = diagonal[(s + period_ - shift) % period_];
+                work.emplace_back(entry, std::move(rotated));
+            }
+        }
+    }
+    batch.pool().parallel_for(work.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t w = begin; w < end; w++) {
+            encoder.encode(work[w].second, parms_id, scale, plain_[work[w].first]);
+        }
+    });
+    for (auto &item : work) present_[item.first] = 1;
+}
+
+DiagonalTransform::DiagonalTransform(const DiagonalMaps<double> &maps, std::size_t period) {
+    plan(maps, period);
+    for (std::size_t o = 0; o < outputs_; o++) {
+        for (std::size_t i = 0; i < inputs_; i++) {
+            for (auto &entry : maps[o][i]) present_[index(o, i, entry.first)] = 1;
+        }
+    }
+}
+
+DiagonalTransform::DiagonalTransform(const DiagonalMaps<double> &maps, std::size_t period, const BatchEvaluator &batch,
+                                     const CKKSEncoder &encoder, parms_id_type parms_id, double scale) {
+    plan(maps, period);
+    encode(maps, batch, encoder, parms_id, scale);
+}
+
+DiagonalTransform::DiagonalTransform(const DiagonalMaps<std::complex<double>> &maps, std::size_t period,
+                                     const BatchEvaluator &batch, const CKKSEncoder &encoder, parms_id_type parms_id,
+                                     double scale) {
+    plan(maps, period);
+    encode(maps, batch, encoder, parms_id, scale);
+}
+
+std::size_t DiagonalTransform::index(std::size_t o, std::size_t i, long long offset) const {
+    return (o * inputs_ + i) * giants_ * baby_ + static_cast<std::size_t>(offset / stride_ - kmin_);
+}
+
+int DiagonalTransform::baby_step(std::size_t b) const {
+    return signed_step(stride_ * static_cast<long long>(b), period_);
+}
+
+int DiagonalTransform::giant_step(std::size_t j) const {
+    return signed_step(stride_ * (kmin_ + static_cast<long long>(j * baby_)), period_);
+}
+
+std::size_t DiagonalTransform::plaintexts() const {
+    return static_cast<std::size_t>(std::count(present_.begin(), present_.end(), 1));
+}
+
+std::size_t DiagonalTransform::rotations() const {
+    // Baby steps rotate every input, giant steps every output's sum
+    std::set<std::size_t> babies, giants;
+    for (std::size_t entry = 0; entry < present_.size(); entry++) {
+        if (!present_[entry]) continue;
+        std::size_t b = entry % baby_, j = (entry / baby_) % giants_, pair = entry / (baby_ * giants_);
+        if (baby_step(b)) babies.insert((pair % inputs_) * baby_ + b);
+        if (giant_step(j)) giants.insert((pair / inputs_) * giants_ + j);
+    }
+    return babies.size() + giants.size();
+}
+
+std::vector<int> DiagonalTransform::steps() const {
+    std::set<int> steps;
+    for (std::size_t entry = 0; entry < present_.size(); entry++) {
+        if (!present_[entry]) continue;
+        steps.insert(baby_step(entry % baby_));
+        steps.insert(giant_step((entry / baby_) % giants_));
+    }
+    steps.erase(0);
+    return { steps.begin(), steps.end() };
+}
+
+std::vector<Ciphertext> DiagonalTransform::apply(const BatchEvaluator &batch,
+                                                 const std::vector<const Ciphertext *> &inputs,
+                                                 const GaloisKeys &galois_keys) const {
+    if (inputs.size() != inputs_) throw std::invalid_argument("wrong number of inputs for the linear transform");
+    if (plain_.empty()) throw std::logic_error("linear transform has no encoded diagonals");
+    auto &evaluator = batch.evaluator();
+    std::vector<char> used(inputs_ * baby_, 0);
+    for (std::size_t entry = 0; entry < present_.size(); entry++) {
+        if (!present_[entry]) continue;
+        std::size_t i = (entry / (baby_ * giants_)) % inputs_;
+        used[i * baby_ + entry % baby_] = 1;
+    }
+
+    // Baby-step rotations of every input, shared by all giant steps
+    std::vector<Ciphertext> babies(inputs_ * baby_);
+    batch.pool().parallel_for(babies.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; t++) {
+            if (!used[t]) continue;
+            std::size_t i = t / baby_;
+            int step = baby_step(t % baby_);
+            if (!step) {
+                babies[t] = *inputs[i];
+            } else {
+                evaluator.rotate_vector(*inputs[i], step, galois_keys, babies[t]);
+            }
+        }
+    });
+
+    // One plaintext dot product and one rotation per output and giant step
+    std::vector<Ciphertext> partials(outputs_ * giants_);
+    std::vector<char> filled(partials.size(), 0);
+    batch.pool().parallel_for(partials.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; t++) {
+            std::size_t o = t / giants_, j = t % giants_;
+            std::vector<const Ciphertext *> cts;
+            std::vector<const Plaintext *> pts;
+            for (std::size_t i = 0; i < inputs_; i++) {
+                for (std::size_t b = 0; b < baby_; b++) {
+                    std::size_t entry = ((o * inputs_ + i) * giants_ + j) * baby_ + b;
+                    if (!present_[entry]) continue;
+                    cts.push_back(&babies[i * baby_ + b]);
+                    pts.push_back(&plain_[entry]);
+                }
+            }
+            if (cts.empty()) continue;
+            partials[t] = batch.dot_plain(cts, pts, false);
+            int giant = giant_step(j);
+            if (giant) evaluator.rotate_vector_inplace(partials[t], giant, galois_keys);
+            filled[t] = 1;
+        }
+    });
+
+    std::vector<Ciphertext> outputs(outputs_);
+    for (std::size_t o = 0; o < outputs_; o++) {
+        bool first = true;
+        for (std::size_t j = 0; j < giants_; j++) {
+            std::size_t t = o * giants_ + j;
+            if (!filled[t]) continue;
+            if (first) {
+                outputs[o] = std::move(partials[t]);
+                first = false;
+            } else {
+                evaluator.add_inplace(outputs[o], partials[t]);
+            }
+        }
+        if (first) throw std::logic_error("linear transform output has no diagonals");
+        evaluator.rescale_to_next_inplace(outputs[o]);
+    }
+    return outputs;
+}
+
+Ciphertext DiagonalTransform::apply(const BatchEvaluator &batch, const Ciphertext &input,
+                                    const GaloisKeys &galois_keys) const {
+    return std::move(apply(batch, std::vector<const Ciphertext *>{ &input }, galois_keys).front());
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "batch_evaluator.h"
+#include <seal/ckks.h>
+#include <seal/ciphertext.h>
+#include <seal/galoiskeys.h>
+#include <seal/plaintext.h>
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+// Rotation by step reduced modulo period into (-period / 2, period / 2]
+int signed_step(long long step, std::size_t period);
+
+// y = sum over d of diagonal_d * rotate(x, d), keyed by offset d
+template <class T>
+using DiagonalSet = std::map<long long, std::vector<T>>;
+
+// maps[o][i] takes input i to output o
+template <class T>
+using DiagonalMaps = std::vector<std::vector<DiagonalSet<T>>>;
+
+// A linear map on CKKS slot vectors, one plaintext multiply deep, evaluated
+// baby-step giant-step. Offsets are written stride * (kmin + j * baby + b);
+// diagonal d of the map from input i to output o is stored pre-rotated by the
+// giant step at plain[((o * inputs + i) * giants + j) * baby + b], so the
+// baby-step rotations of every input are computed once and shared by all
+// giant steps, and each giant step rotates one sum.
+//
+// Diagonals hold period values and rotations are taken modulo period, which
+// must divide the slot count; the slots then hold copies of a period-long
+// vector.
+class DiagonalTransform {
+public:
+    DiagonalTransform() = default;
+
+    // Layout only: every diagonal of maps counts as present and nothing is
+    // encoded, for listing steps before the plaintexts are needed
+    DiagonalTransform(const DiagonalMaps<double> &maps, std::size_t period);
+
+    // Encodes the diagonals at parms_id with the given scale; diagonals that
+    // round to zero at that scale are dropped
+    DiagonalTransform(const DiagonalMaps<double> &maps, std::size_t period, const BatchEvaluator &batch,
+                      const seal::CKKSEncoder &encoder, seal::parms_id_type parms_id, double scale);
+    DiagonalTransform(const DiagonalMaps<std::complex<double>> &maps, std::size_t period,
+                      const BatchEvaluator &batch, const seal::CKKSEncoder &encoder, seal::parms_id_type parms_id,
+                      double scale);
+
+    std::size_t inputs() const noexcept { return inputs_; }
+    std::size_t outputs() const noexcept { return outputs_; }
+
+    // Plaintext multiplies per apply()
+    std::size_t plaintexts() const;
+
+    // Key switches per apply()
+    std::size_t rotations() const;
+
+    // Nonzero rotation steps apply() uses, sorted
+    std::vector<int> steps() const;
+
+    // One output per row of the map, rescaled once. The scale is left as
+    // the rescale sets it, for the caller to declare.
+    std::vector<seal::Ciphertext> apply(const BatchEvaluator &batch,
+                                        const std::vector<const seal::Ciphertext *> &inputs,
+                                        const seal::GaloisKeys &galois_keys) const;
+    seal::Ciphertext apply(const BatchEvaluator &batch, const seal::Ciphertext &input,
+                           const seal::GaloisKeys &galois_keys) const;
+
+private:
+    template <class T>
+    void plan(const DiagonalMaps<T> &maps, std::size_t period);
+
+    template <class T>
+    void encode(const DiagonalMaps<T> &maps, const BatchEvaluator &batch, const seal::CKKSEncoder &encoder,
+                seal::parms_id_type parms_id, double scale);
+
+    std::size_t index(std::size_t o, std::size_t i, long long offset) const;
+    int baby_step(std::size_t b) const;
+    int giant_step(std::size_t j) const;
+
+    std::size_t period_ = 1;
+    std::size_t inputs_ = 1, outputs_ = 1;
+    long long stride_ = 1, kmin_ = 0;
+    std::size_t baby_ = 1, giants_ = 1;
+    std::vector<seal::Plaintext> plain_;
+    std::vector<char> present_;
+};
@@ -0,0 +1,601 @@
+#include "ckks_bootstrap.h"
+#include <seal/randomgen.h>
+#include <seal/util/galois.h>
+#include <seal/util/ntt.h>
+#include <seal/util/uintarithsmallmod.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace seal;
+using namespace seal::util;
+
+namespace {
+    using Complex = std::complex<double>;
+
+    constexpr double pi = 3.14159265358979323846;
+
+    // Keyed by offsets in (-n/2, n/2]
+    using Diagonals = DiagonalSet<Complex>;
+    using LinearMap = DiagonalMaps<Complex>;
+
+    std::vector<Complex> rotated(const std::vector<Complex> &values, long long offset) {
+        std::size_t n = values.size();
+        auto shift = static_cast<std::size_t>(signed_step(offset, n) + static_cast<long long>(n)) % n;
+        std::vector<Complex> result(n);
+        for (std::size_t i = 0; i < n; i++) result[i] = values[(i + shift) % n];
+        return result;
+    }
+
+    void accumulate(Diagonals &diagonals, long long offset, std::size_t position, Complex value, std::size_t slots) {
+        auto &diagonal = diagonals[signed_step(offset, slots)];
+        if (diagonal.empty()) diagonal.assign(slots, Complex(0));
+        diagonal[position] += value;
+    }
+
+    // later(earlier(x)): rotating a product by d rotates both factors
+    Diagonals compose(const Diagonals &later, const Diagonals &earlier, std::size_t slots) {
+        Diagonals result;
+        for (auto &[first_offset, first] : earlier) {
+            for (auto &[second_offset, second] : later) {
+                auto shifted = rotated(first, second_offset);
+                auto &diagonal = result[signed_step(first_offset + second_offset, slots)];
+                if (diagonal.empty()) diagonal.assign(slots, Complex(0));
+                for (std::size_t i = 0; i < slots; i++) diagonal[i] += second[i] * shifted[i];
+            }
+        }
+        return result;
+    }
+
+    LinearMap compose(const LinearMap &later, const LinearMap &earlier, std::size_t slots) {
+        LinearMap result(later.size(), std::vector<Diagonals>(earlier.front().size()));
+        for (std::size_t o = 0; o < later.size(); o++) {
+            for (std::size_t i = 0; i < earlier.front().size(); i++) {
+                for (std::size_t m = 0; m < earlier.size(); m++) {
+                    for (auto &[offset, diagonal] : compose(later[o][m], earlier[m][i], slots)) {
+                        auto &sum = result[o][i][offset];
+                        if (sum.empty()) sum.assign(slots, Complex(0));
+                        for (std::size_t p = 0; p < slots; p++) sum[p] += diagonal[p];
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    // Primitive (2 * degree)-th root of unity raised to power
+    Complex root(std::size_t degree, std::uint64_t power) {
+        return std::polar(1.0, pi * static_cast<double>(power) / static_cast<double>(degree));
+    }
+
+    // Decoding evaluates the plaintext at w^(3^j) for slot j. Split evenly
+    // and oddly, a block of s slots holds the evaluations E of the even part
+    // in its first half and O of the odd part in its second, and the next
+    // block size combines them as E_j +- zeta_j * O_j. Blocks of sub-problems
+    // sit in bit-reversed order, so every butterfly layer has diagonals at 0
+    // and +-s/2 only.
+    LinearMap fft_layer(std::size_t block, std::size_t slots) {
+        std::size_t half = block / 2;
+        auto h = static_cast<long long>(half);
+        LinearMap layer(1, std::vector<Diagonals>(1));
+        auto &diagonals = layer[0][0];
+        std::vector<Complex> zeta(half);
+        std::uint64_t power = 1;
+        for (std::size_t j = 0; j < half; j++) {
+            zeta[j] = root(2 * block, power);
+            power = (power * 3) % (4 * block);
+        }
+        for (std::size_t p = 0; p < slots; p++) {
+            std::size_t j = p % block;
+            if (j < half) {
+                accumulate(diagonals, 0, p, 1.0, slots);
+                accumulate(diagonals, h, p, zeta[j], slots);
+            } else {
+                accumulate(diagonals, -h, p, 1.0, slots);
+                accumulate(diagonals, 0, p, -zeta[j - half], slots);
+            }
+        }
+        return layer;
+    }
+
+    LinearMap inverse_fft_layer(std::size_t block, std::size_t slots) {
+        std::size_t half = block / 2;
+        auto h = static_cast<long long>(half);
+        LinearMap layer(1, std::vector<Diagonals>(1));
+        auto &diagonals = layer[0][0];
+        std::vector<Complex> zeta(half);
+        std::uint64_t power = 1;
+        for (std::size_t j = 0; j < half; j++) {
+            zeta[j] = root(2 * block, power);
+            power = (power * 3) % (4 * block);
+        }
+        for (std::size_t p = 0; p < slots; p++) {
+            std::size_t j = p % block;
+            if (j < half) {
+                accumulate(diagonals, 0, p, 0.5, slots);
+                accumulate(diagonals, h, p, 0.5, slots);
+            } else {
+                Complex inverse = 0.5 / zeta[j - half];
+                accumulate(diagonals, -h, p, inverse, slots);
+                accumulate(diagonals, 0, p, -inverse, slots);
+            }
+        }
+        return layer;
+    }
+
+    // The smallest blocks are polynomials of degree 4 evaluated at w and w^3,
+    // where X^2 is i and -i: with a = t0 + i*t2 and b = t1 + i*t3 the block is
+    // (a + w*b, conj(a - w*b)). The coefficient slots keep a and b, in that
+    // order, as the real coefficients a and b pack into ciphertexts A and B:
+    // slots 2q and 2q + 1 of A hold t0 and t1, those of B hold t2 and t3.
+    //
+    // From A and B to the blocks
+    LinearMap slot_to_coeff_base(std::size_t slots) {
+        Complex w = std::polar(1.0, pi / 4);
+        Complex i(0, 1);
+        LinearMap layer(1, std::vector<Diagonals>(2));
+        auto &a = layer[0][0];
+        auto &b = layer[0][1];
+        for (std::size_t p = 0; p < slots; p++) {
+            if (p % 2 == 0) {
+                accumulate(a, 0, p, 1.0, slots);
+                accumulate(a, 1, p, w, slots);
+                accumulate(b, 0, p, i, slots);
+                accumulate(b, 1, p, i * w, slots);
+            } else {
+                accumulate(a, 0, p, -std::conj(w), slots);
+                accumulate(a, -1, p, 1.0, slots);
+                accumulate(b, 0, p, i * std::conj(w), slots);
+                accumulate(b, -1, p, -i, slots);
+            }
+        }
+        return layer;
+    }
+
+    // From the blocks c back to W = A + i*B, which needs conj(c):
+    // W = L(c) + M(conj(c)). Outputs G and H satisfy A = G + conj(G) and
+    // B = H + conj(H), so a conjugation per output finishes the split.
+    LinearMap coeff_to_slot_base(std::size_t slots) {
+        Complex w_bar = std::conj(std::polar(1.0, pi / 4));
+        Diagonals l, m;
+        for (std::size_t p = 0; p < slots; p++) {
+            if (p % 2 == 0) {
+                accumulate(l, 0, p, 0.5, slots);
+                accumulate(m, 1, p, 0.5, slots);
+            } else {
+                accumulate(l, -1, p, 0.5 * w_bar, slots);
+                accumulate(m, 0, p, -0.5 * w_bar, slots);
+            }
+        }
+        LinearMap layer(2, std::vector<Diagonals>(1));
+        std::set<long long> offsets;
+        for (auto &entry : l) offsets.insert(entry.first);
+        for (auto &entry : m) offsets.insert(entry.first);
+        std::vector<Complex> zero(slots, Complex(0));
+        for (long long offset : offsets) {
+            auto &lv = l.count(offset) ? l[offset] : zero;
+            auto &mv = m.count(offset) ? m[offset] : zero;
+            auto &g = layer[0][0][offset];
+            auto &h = layer[1][0][offset];
+            g.resize(slots);
+            h.resize(slots);
+            for (std::size_t p = 0; p < slots; p++) {
+                g[p] = (lv[p] + std::conj(mv[p])) / 2.0;
+                h[p] = (lv[p] - std::conj(mv[p])) / Complex(0, 2);
+            }
+        }
+        return layer;
+    }
+
+    // Splits layers into count groups of consecutive layers, sizes differing
+    // by at most one, and merges each group into one map
+    std::vector<LinearMap> merge_layers(const std::vector<LinearMap> &layers, std::size_t count, std::size_t slots) {
+        std::vector<LinearMap> groups;
+        std::size_t begin = 0;
+        for (std::size_t g = 0; g < count; g++) {
+            std::size_t size = layers.size() / count + (g < layers.size() % count ? 1 : 0);
+            LinearMap merged = layers[begin];
+            for (std::size_t k = begin + 1; k < begin + size; k++) merged = compose(layers[k], merged, slots);
+            groups.push_back(std::move(merged));
+            begin += size;
+        }
+        return groups;
+    }
+
+    // Chebyshev coefficients of f on [-1, 1] interpolated at 256 (or more)
+    // nodes; degree == 0 keeps everything up to the last coefficient above
+    // tolerance
+    std::vector<double> chebyshev_coefficients(const std::function<double(double)> &f, std::size_t degree,
+                                               double tolerance) {
+        std::size_t nodes = std::max<std::size_t>(256, degree + 1);
+        std::vector<double> values(nodes);
+        for (std::size_t j = 0; j < nodes; j++) {
+            values[j] = f(std::cos(pi * (static_cast<double>(j) + 0.5) / static_cast<double>(nodes)));
+        }
+        std::vector<double> coeffs(nodes);
+        for (std::size_t k = 0; k < nodes; k++) {
+            double sum = 0;
+            for (std::size_t j = 0; j < nodes; j++) {
+                sum += values[j] * std::cos(pi * static_cast<double>(k) * (static_cast<double>(j) + 0.5) /
+                                            static_cast<double>(nodes));
+            }
+            coeffs[k] = 2 * sum / static_cast<double>(nodes);
+        }
+        coeffs[0] /= 2;
+        if (!degree) {
+            degree = 1;
+            for (std::size_t k = 1; k < nodes; k++) {
+                if (std::fabs(coeffs[k]) > tolerance) degree = k;
+            }
+        }
+        coeffs.resize(degree + 1);
+        return coeffs;
+    }
+
+    std::size_t ceil_log2(std::size_t value) {
+        std::size_t bits = 0;
+        while ((std::size_t(1) << bits) < value) bits++;
+        return bits;
+    }
+
+    std::uint32_t uniform_below(UniformRandomGenerator &random, std::uint32_t bound) {
+        std::uint64_t limit = ((std::uint64_t(1) << 32) / bound) * bound;
+        std::uint32_t value;
+        do {
+            value = random.generate();
+        } while (value >= limit);
+        return value % bound;
+    }
+
+    double seconds_since(std::chrono::steady_clock::time_point &mark) {
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - mark).count();
+        mark = now;
+        return elapsed;
+    }
+
+    void add_timings(CKKSBootstrapper::Timings &sum, const CKKSBootstrapper::Timings &timings) {
+        sum.mod_raise += timings.mod_raise;
+        sum.coeff_to_slot += timings.coeff_to_slot;
+        sum.eval_mod += timings.eval_mod;
+        sum.slot_to_coeff += timings.slot_to_coeff;
+        sum.total += timings.total;
+    }
+}
+
+SecretKey sparse_secret_key(const SEALContext &context, std::size_t hamming_weight) {
+    if (!context.parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+    auto &key_data = *context.key_context_data();
+    auto &parms = key_data.parms();
+    auto &coeff_modulus = parms.coeff_modulus();
+    std::size_t coeff_count = parms.poly_modulus_degree();
+    if (!hamming_weight || hamming_weight > coeff_count) {
+        throw std::invalid_argument("hamming_weight must be between 1 and poly_modulus_degree");
+    }
+
+    auto factory = parms.random_generator() ? parms.random_generator() : UniformRandomGeneratorFactory::DefaultFactory();
+    auto random = factory->create();
+
+    // A partial Fisher-Yates shuffle picks the support, one random bit the sign
+    std::vector<std::uint32_t> positions(coeff_count);
+    std::iota(positions.begin(), positions.end(), std::uint32_t(0));
+    std::vector<int> coeffs(coeff_count, 0);
+    for (std::size_t i = 0; i < hamming_weight; i++) {
+        std::size_t j = i + uniform_below(*random, static_cast<std::uint32_t>(coeff_count - i));
+        std::swap(positions[i], positions[j]);
+        coeffs[positions[i]] = (random->generate() & 1) ? 1 : -1;
+    }
+
+    SecretKey secret_key;
+    auto &data = secret_key.data();
+    data.resize(coeff_count * coeff_modulus.size());
+    auto ntt_tables = key_data.small_ntt_tables();
+    for (std::size_t j = 0; j < coeff_modulus.size(); j++) {
+        std::uint64_t *limb = data.data() + j * coeff_count;
+        for (std::size_t c = 0; c < coeff_count; c++) {
+            limb[c] = coeffs[c] > 0 ? 1 : coeffs[c] < 0 ? coeff_modulus[j].value() - 1 : 0;
+        }
+        ntt_negacyclic_harvey(limb, ntt_tables[j]);
+    }
+    std::fill(coeffs.begin(), coeffs.end(), 0);
+    secret_key.parms_id() = key_data.parms_id();
+    return secret_key;
+}
+
+CKKSBootstrapper::CKKSBootstrapper(std::shared_ptr<SEALContext> context, const Config &config, std::size_t threads)
+    : context_(std::move(context)), batch_(context_, threads), encoder_(*context_), config_(config),
+      slots_(encoder_.slot_count()) {
+    auto &first = *context_->first_context_data();
+    if (first.parms().scheme() != scheme_type::ckks) throw std::invalid_argument("bootstrapping requires CKKS");
+    std::size_t log_slots = ceil_log2(slots_);
+    if (slots_ < 4) throw std::invalid_argument("poly_modulus_degree is too small to bootstrap");
+    if (!config_.cts_levels || config_.cts_levels > log_slots || !config_.stc_levels ||
+        config_.stc_levels > log_slots) {
+        throw std::invalid_argument("cts_levels and stc_levels must be between 1 and log2(slots)");
+    }
+    if (!(config_.k_range >= 1)) throw std::invalid_argument("k_range must be at least 1");
+
+    std::size_t top = first.chain_index();
+    level_parms_.resize(top + 1);
+    primes_.resize(top + 1);
+    for (auto data = context_->first_context_data(); data; data = data->next_context_data()) {
+        level_parms_[data->chain_index()] = data->parms_id();
+    }
+    auto &coeff_modulus = first.parms().coeff_modulus();
+    for (std::size_t level = 0; level <= top; level++) primes_[level] = static_cast<double>(coeff_modulus[level].value());
+
+    // EvalMod: x = y * k lies within k of an integer; cos(2 pi (x - 1/4) / 2^r)
+    // followed by r double-angle steps is sin(2 pi x)
+    double k = config_.k_range + 1;
+    double angle = 2 * pi / std::ldexp(1.0, static_cast<int>(config_.double_angle));
+    coeffs_ = chebyshev_coefficients([k, angle](double y) { return std::cos(angle * (k * y - 0.25)); },
+                                     config_.degree, 1e-14);
+    std::size_t power_depth = ceil_log2(eval_mod_degree());
+    eval_mod_depth_ = power_depth + 1 + config_.double_angle;
+
+    std::size_t needed = config_.cts_levels + eval_mod_depth_ + config_.stc_levels;
+    if (needed > top) {
+        throw std::invalid_argument("bootstrapping needs " + std::to_string(needed) +
+                                    " levels but the modulus chain has " + std::to_string(top));
+    }
+    eval_mod_level_ = top - config_.cts_levels;
+    output_level_ = top - needed;
+
+    // ModRaise declares the scale q0 * k so the slots CoeffToSlot produces
+    // are y = t / (q0 * k). EvalMod starts at the scale of its first prime
+    // and squaring keeps every level at scales_[level] exactly.
+    double q0 = primes_[0];
+    raise_scale_ = q0 * k;
+    scales_.assign(top + 1, 0.0);
+    scales_[eval_mod_level_] = primes_[eval_mod_level_];
+    std::size_t stc_level = eval_mod_level_ - eval_mod_depth_;
+    for (std::size_t level = eval_mod_level_; level > stc_level; level--) {
+        scales_[level - 1] = scales_[level] * scales_[level] / primes_[level];
+    }
+
+    // Coefficients too small to survive rounding at their scale are dropped
+    std::size_t sum_level = eval_mod_level_ - power_depth - 1;
+    for (std::size_t term = 1; term < coeffs_.size(); term++) {
+        std::size_t level = eval_mod_level_ - ceil_log2(term);
+        double factor = scales_[sum_level] * primes_[sum_level + 1] / scales_[level];
+        if (std::fabs(coeffs_[term] * factor) < 0.5) coeffs_[term] = 0;
+    }
+
+    std::vector<LinearMap> cts_layers, stc_layers;
+    for (std::size_t block = slots_; block >= 4; block /= 2) cts_layers.push_back(inverse_fft_layer(block, slots_));
+    cts_layers.push_back(coeff_to_slot_base(slots_));
+    stc_layers.push_back(slot_to_coeff_base(slots_));
+    for (std::size_t block = 4; block <= slots_; block *= 2) stc_layers.push_back(fft_layer(block, slots_));
+
+    // Plaintext scales are the prime each group rescales by, times an even
+    // share of the scale change across the transform: raise_scale_ to the
+    // EvalMod scale, then to q0 / (2 pi) so that declaring the input scale
+    // on the result undoes the sin(2 pi x) ~ 2 pi m / q0 of EvalMod
+    auto build = [this](const std::vector<LinearMap> &maps, std::size_t first_level, double scale_ratio,
+                        std::vector<DiagonalTransform> &groups) {
+        double share = std::pow(scale_ratio, 1.0 / static_cast<double>(maps.size()));
+        for (std::size_t g = 0; g < maps.size(); g++) {
+            std::size_t level = first_level - g;
+            groups.emplace_back(maps[g], slots_, batch_, encoder_, level_parms_[level], primes_[level] * share);
+        }
+    };
+    build(merge_layers(cts_layers, config_.cts_levels, slots_), top, scales_[eval_mod_level_] / raise_scale_,
+          coeff_to_slot_);
+    build(merge_layers(stc_layers, config_.stc_levels, slots_), stc_level, q0 / (2 * pi) / scales_[stc_level],
+          slot_to_coeff_);
+}
+
+std::size_t CKKSBootstrapper::level_of(const Ciphertext &encrypted) const {
+    auto context_data = context_->get_context_data(encrypted.parms_id());
+    if (!context_data) throw std::invalid_argument("encrypted is not valid for the context");
+    return context_data->chain_index();
+}
+
+std::vector<int> CKKSBootstrapper::galois_steps() const {
+    std::set<int> steps;
+    for (auto *groups : { &coeff_to_slot_, &slot_to_coeff_ }) {
+        for (auto &group : *groups) {
+            for (int step : group.steps()) steps.insert(step);
+        }
+    }
+    return { steps.begin(), steps.end() };
+}
+
+std::vector<std::uint32_t> CKKSBootstrapper::galois_elements() const {
+    auto galois_tool = context_->key_context_data()->galois_tool();
+    auto elements = galois_tool->get_elts_from_steps(galois_steps());
+    elements.push_back(galois_tool->get_elt_from_step(0));
+    return elements;
+}
+
+void CKKSBootstrapper::mod_raise(const Ciphertext &encrypted, Ciphertext &destination) const {
+    Ciphertext low;
+    batch_.evaluator().mod_switch_to(encrypted, context_->last_parms_id(), low);
+    auto &last = *context_->last_context_data();
+    auto &first = *context_->first_context_data();
+    std::size_t coeff_count = first.parms().poly_modulus_degree();
+    const Modulus &q0 = last.parms().coeff_modulus()[0];
+    for (std::size_t i = 0; i < low.size(); i++) inverse_ntt_negacyclic_harvey(low.data(i), last.small_ntt_tables()[0]);
+
+    // Lift the centered residues modulo q0 to every prime of the first level
+    auto &coeff_modulus = first.parms().coeff_modulus();
+    auto ntt_tables = first.small_ntt_tables();
+    destination.resize(*context_, first.parms_id(), low.size());
+    std::uint64_t half = q0.value() >> 1;
+    batch_.pool().parallel_for(low.size() * coeff_modulus.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t task = begin; task < end; task++) {
+            std::size_t i = task / coeff_modulus.size(), j = task % coeff_modulus.size();
+            const std::uint64_t *source = low.data(i);
+            std::uint64_t *limb = destination.data(i) + j * coeff_count;
+            for (std::size_t c = 0; c < coeff_count; c++) {
+                std::uint64_t value = source[c];
+                limb[c] = value > half ? negate_uint_mod(barrett_reduce_64(q0.value() - value, coeff_modulus[j]),
+                                                         coeff_modulus[j])
+                                       : barrett_reduce_64(value, coeff_modulus[j]);
+            }
+            ntt_negacyclic_harvey(limb, ntt_tables[j]);
+        }
+    });
+    destination.is_ntt_form() = true;
+    destination.scale() = raise_scale_;
+}
+
+void CKKSBootstrapper::apply(const std::vector<DiagonalTransform> &groups, std::vector<Ciphertext> &values,
+                             const GaloisKeys &galois_keys) const {
+    for (auto &group : groups) {
+        std::vector<const Ciphertext *> inputs;
+        for (auto &value : values) inputs.push_back(&value);
+        values = group.apply(batch_, inputs, galois_keys);
+    }
+}
+
+void CKKSBootstrapper::multiply_canonical(Ciphertext &encrypted, const Ciphertext &other,
+                                          const RelinKeys &relin_keys) const {
+    auto &evaluator = batch_.evaluator();
+    if (&encrypted == &other) {
+        evaluator.square_inplace(encrypted);
+    } else {
+        evaluator.multiply_inplace(encrypted, other);
+    }
+    evaluator.relinearize_inplace(encrypted, relin_keys);
+    evaluator.rescale_to_next_inplace(encrypted);
+    encrypted.scale() = scales_[level_of(encrypted)];
+}
+
+Ciphertext CKKSBootstrapper::eval_mod(const Ciphertext &encrypted, const RelinKeys &relin_keys) const {
+    auto &evaluator = batch_.evaluator();
+    std::size_t degree = eval_mod_degree();
+    std::vector<Ciphertext> powers(degree + 1);
+    std::vector<std::size_t> levels(degree + 1);
+    powers[1] = encrypted;
+    levels[1] = eval_mod_level_;
+
+    // T_k = 2 T_a T_b - T_(a - b) sits ceil(log2 k) levels down
+    batch_.power_ladder(degree, [&](std::size_t k, std::size_t a) {
+        std::size_t b = k - a, c = a - b;
+        Ciphertext product = powers[a];
+        if (levels[b] == levels[a]) {
+            multiply_canonical(product, powers[b], relin_keys);
+            batch_.multiply_integer(product, 2);
+        } else {
+            multiply_canonical(product, batch_.align(powers[b], level_parms_[levels[a]], scales_[levels[a]], 2.0),
+                               relin_keys);
+        }
+        std::size_t level = levels[a] - 1;
+        if (c) {
+            evaluator.sub_inplace(product, batch_.align(powers[c], level_parms_[level], scales_[level]));
+        } else {
+            batch_.add_scalar(product, -1.0);
+        }
+        powers[k] = std::move(product);
+        levels[k] = level;
+    });
+
+    // Every term lands one level below the deepest power at the same scale
+    std::size_t sum_level = eval_mod_level_ - ceil_log2(degree) - 1;
+    Ciphertext result = batch_.linear_combination(powers, coeffs_, level_parms_[sum_level], scales_[sum_level]);
+
+    // cos(2 theta) = 2 cos(theta)^2 - 1
+    for (std::size_t r = 0; r < config_.double_angle; r++) {
+        multiply_canonical(result, result, relin_keys);
+        batch_.multiply_integer(result, 2);
+        batch_.add_scalar(result, -1.0);
+    }
+    return result;
+}
+
+CKKSBootstrapper::Timings CKKSBootstrapper::run(const Ciphertext &encrypted, const RelinKeys &relin_keys,
+                                                const GaloisKeys &galois_keys, Ciphertext &destination) const {
+    if (!encrypted.is_ntt_form()) throw std::invalid_argument("CKKS encrypted must be in NTT form");
+    if (encrypted.size() != 2) throw std::invalid_argument("encrypted must be relinearized");
+    level_of(encrypted);
+    double scale = encrypted.scale();
+    Timings timings;
+    auto start = std::chrono::steady_clock::now(), mark = start;
+
+    std::vector<Ciphertext> values(1);
+    mod_raise(encrypted, values[0]);
+    timings.mod_raise = seconds_since(mark);
+
+    apply(coeff_to_slot_, values, galois_keys);
+    batch_.pool().parallel_for(values.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            values[i].scale() = scales_[eval_mod_level_];
+            Ciphertext conjugate;
+            batch_.evaluator().complex_conjugate(values[i], galois_keys, conjugate);
+            batch_.evaluator().add_inplace(values[i], conjugate);
+        }
+    });
+    timings.coeff_to_slot = seconds_since(mark);
+
+    for (auto &value : values) value = eval_mod(value, relin_keys);
+    timings.eval_mod = seconds_since(mark);
+
+    apply(slot_to_coeff_, values, galois_keys);
+    destination = std::move(values[0]);
+    destination.scale() = scale;
+    timings.slot_to_coeff = seconds_since(mark);
+    timings.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.bootstraps++;
+    stats_.last = timings;
+    add_timings(stats_.total, timings);
+    return timings;
+}
+
+void CKKSBootstrapper::bootstrap(const Ciphertext &encrypted, const RelinKeys &relin_keys,
+                                 const GaloisKeys &galois_keys, Ciphertext &destination) const {
+    run(encrypted, relin_keys, galois_keys, destination);
+}
+
+Ciphertext CKKSBootstrapper::bootstrap(const Ciphertext &encrypted, const RelinKeys &relin_keys,
+                                       const GaloisKeys &galois_keys) const {
+    Ciphertext destination;
+    run(encrypted, relin_keys, galois_keys, destination);
+    return destination;
+}
+
+CKKSBootstrapper::Report CKKSBootstrapper::measure(const Ciphertext &encrypted, const RelinKeys &relin_keys,
+                                                   const GaloisKeys &galois_keys, Decryptor &decryptor,
+                                                   Ciphertext &destination) const {
+    Report report;
+    report.input_level = level_of(encrypted);
+    Plaintext plain;
+    std::vector<Complex> before, after;
+    decryptor.decrypt(encrypted, plain);
+    encoder_.decode(plain, before);
+
+    report.timings = run(encrypted, relin_keys, galois_keys, destination);
+    report.output_level = level_of(destination);
+    decryptor.decrypt(destination, plain);
+    encoder_.decode(plain, after);
+
+    double sum = 0;
+    for (std::size_t i = 0; i < before.size(); i++) {
+        double error = std::abs(after[i] - before[i]);
+        report.max_error = std::max(report.max_error, error);
+        sum += error;
+    }
+    report.mean_error = sum / static_cast<double>(before.size());
+    report.precision_bits =
+        report.max_error > 0 ? -std::log2(report.max_error) : std::numeric_limits<double>::infinity();
+    return report;
+}
+
+CKKSBootstrapper::Stats CKKSBootstrapper::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+void CKKSBootstrapper::reset_stats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = Stats();
+}
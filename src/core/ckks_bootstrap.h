@@ -0,0 +1,145 @@
+#pragma once
+#include "batch_evaluator.h"
+#include "bsgs.h"
+#include <seal/ckks.h>
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/decryptor.h>
+#include <seal/galoiskeys.h>
+#include <seal/relinkeys.h>
+#include <seal/secretkey.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Secret key with exactly hamming_weight nonzero (+-1) coefficients, for use
+// with KeyGenerator(context, secret_key). Bootstrapping has to remove q0 * I
+// where |I| grows with the weight of the secret, so a sparse secret keeps
+// EvalMod shallow; it also lowers security, so pick the weight with the
+// parameter set in mind.
+seal::SecretKey sparse_secret_key(const seal::SEALContext &context, std::size_t hamming_weight);
+
+// Full-slot CKKS bootstrapping: refreshes a ciphertext at any level to a
+// fixed level high in the modulus chain, so circuits deeper than the chain can
+// keep going.
+//
+// ModRaise reinterprets the ciphertext at the last level modulo the top
+// modulus; its plaintext becomes m + q0 * I. CoeffToSlot moves the
+// coefficients into the slots of two real ciphertexts, EvalMod removes q0 * I
+// slot-wise with a Chebyshev approximation of a scaled cosine followed by
+// double-angle steps (together sin(2 pi x) / 2 pi), and SlotToCoeff moves the
+// coefficients back. The two linear transforms are SEAL's decoding FFT split
+// into cts_levels / stc_levels groups of merged butterfly layers, each group
+// one pre-encoded DiagonalTransform.
+//
+// Levels are taken from the top of the chain: CoeffToSlot, then EvalMod
+// (depth()), then SlotToCoeff, leaving output_level(). The primes consumed by
+// EvalMod should all have about the same size, and q0 should exceed the
+// scale of the messages by enough bits to keep m / q0 small.
+class CKKSBootstrapper {
+public:
+    struct Config {
+        // Plaintext-multiply levels given to each linear transform
+        std::size_t cts_levels = 3;
+        std::size_t stc_levels = 3;
+        // Bound on |I|; about 4.5 * sqrt(h / 12) + 1 for a secret of weight h
+        double k_range = 16;
+        // Chebyshev degree of the cosine; 0 picks the smallest degree whose
+        // dropped coefficients are below 1e-14
+        std::size_t degree = 0;
+        std::size_t double_angle = 3;
+    };
+
+    // Wall-clock seconds per phase
+    struct Timings {
+        double mod_raise = 0;
+        double coeff_to_slot = 0;
+        double eval_mod = 0;
+        double slot_to_coeff = 0;
+        double total = 0;
+    };
+
+    struct Report {
+        Timings timings;
+        std::size_t input_level = 0;
+        std::size_t output_level = 0;
+        // Slot-wise distance between the decryptions before and after
+        double max_error = 0;
+        double mean_error = 0;
+        double precision_bits = 0;
+    };
+
+    struct Stats {
+        std::uint64_t bootstraps = 0;
+        Timings last;
+        Timings total;
+    };
+
+    // Pre-encodes the CoeffToSlot and SlotToCoeff diagonals; threads == 0
+    // shares the process-wide pool. Config has no default here: a nested
+    // class's member initializers cannot be used inside the enclosing class.
+    CKKSBootstrapper(std::shared_ptr<seal::SEALContext> context, const Config &config, std::size_t threads = 0);
+
+    // Rotation steps of both linear transforms
+    std::vector<int> galois_steps() const;
+
+    // Galois elements of galois_steps() plus complex conjugation; pass them
+    // to KeyGenerator.create_galois_keys
+    std::vector<std::uint32_t> galois_elements() const;
+
+    const Config &config() const noexcept { return config_; }
+    std::size_t eval_mod_degree() const noexcept { return coeffs_.size() - 1; }
+    std::size_t eval_mod_depth() const noexcept { return eval_mod_depth_; }
+
+    // Levels consumed in total and the chain index of the results
+    std::size_t depth() const noexcept { return config_.cts_levels + eval_mod_depth_ + config_.stc_levels; }
+    std::size_t output_level() const noexcept { return output_level_; }
+    const seal::parms_id_type &output_parms_id() const { return level_parms_[output_level_]; }
+
+    // encrypted must be relinearized; the result keeps its scale and holds
+    // the same slots at output_level()
+    void bootstrap(const seal::Ciphertext &encrypted, const seal::RelinKeys &relin_keys,
+                   const seal::GaloisKeys &galois_keys, seal::Ciphertext &destination) const;
+    seal::Ciphertext bootstrap(const seal::Ciphertext &encrypted, const seal::RelinKeys &relin_keys,
+                               const seal::GaloisKeys &galois_keys) const;
+
+    // Bootstraps and compares the decryptions of the input and the output
+    Report measure(const seal::Ciphertext &encrypted, const seal::RelinKeys &relin_keys,
+                   const seal::GaloisKeys &galois_keys, seal::Decryptor &decryptor,
+                   seal::Ciphertext &destination) const;
+
+    Stats stats() const;
+    void reset_stats();
+
+private:
+    Timings run(const seal::Ciphertext &encrypted, const seal::RelinKeys &relin_keys,
+                const seal::GaloisKeys &galois_keys, seal::Ciphertext &destination) const;
+    void mod_raise(const seal::Ciphertext &encrypted, seal::Ciphertext &destination) const;
+    void apply(const std::vector<DiagonalTransform> &groups, std::vector<seal::Ciphertext> &values,
+               const seal::GaloisKeys &galois_keys) const;
+    seal::Ciphertext eval_mod(const seal::Ciphertext &encrypted, const seal::RelinKeys &relin_keys) const;
+    void multiply_canonical(seal::Ciphertext &encrypted, const seal::Ciphertext &other,
+                            const seal::RelinKeys &relin_keys) const;
+    std::size_t level_of(const seal::Ciphertext &encrypted) const;
+
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    seal::CKKSEncoder encoder_;
+    Config config_;
+    std::size_t slots_;
+
+    // Per chain index: parms_id, prime removed by rescaling and the scale
+    // EvalMod keeps ciphertexts at on that level
+    std::vector<seal::parms_id_type> level_parms_;
+    std::vector<double> primes_;
+    std::vector<double> scales_;
+
+    double raise_scale_ = 0;
+    std::size_t eval_mod_level_ = 0, eval_mod_depth_ = 0, output_level_ = 0;
+    std::vector<double> coeffs_;
+    std::vector<DiagonalTransform> coeff_to_slot_, slot_to_coeff_;
+
+    mutable std::mutex stats_mutex_;
+    mutable Stats stats_;
+};
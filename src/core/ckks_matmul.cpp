@@ -0,0 +1,224 @@
+#include "ckks_matmul.h"
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace seal;
+
+CKKSMatMul::CKKSMatMul(std::shared_ptr<SEALContext> context, std::size_t dimension, std::size_t threads)
+    : context_(std::move(context)), batch_(context_, threads), encoder_(*context_), slots_(encoder_.slot_count()),
+      d_(dimension) {
+    auto first = context_->first_context_data();
+    if (first->parms().scheme() != scheme_type::ckks) throw std::invalid_argument("CKKSMatMul requires CKKS");
+    if (!d_ || slots_ % (d_ * d_)) throw std::invalid_argument("dimension * dimension must divide the slot count");
+
+    std::size_t top = first->chain_index();
+    level_parms_.resize(top + 1);
+    primes_.resize(top + 1);
+    for (auto data = first; data; data = data->next_context_data()) {
+        level_parms_[data->chain_index()] = data->parms_id();
+    }
+    auto &coeff_modulus = first->parms().coeff_modulus();
+    for (std::size_t level = 0; level <= top; level++) {
+        primes_[level] = static_cast<double>(coeff_modulus[level].value());
+    }
+
+    // sigma(A)[i][j] = A[i][i + j], tau(B)[i][j] = B[i + j][j], transpose(A)[i][j] = A[j][i]
+    auto d = static_cast<long long>(d_);
+    sigma_offset_ = [d](std::size_t i, std::size_t j) {
+        return static_cast<long long>((i + j) % static_cast<std::size_t>(d)) - static_cast<long long>(j);
+    };
+    tau_offset_ = [d](std::size_t, std::size_t j) { return d * static_cast<long long>(j); };
+    transpose_offset_ = [d](std::size_t i, std::size_t j) {
+        return (d - 1) * (static_cast<long long>(j) - static_cast<long long>(i));
+    };
+    sigma_shape_ = build(sigma_offset_, 0, false);
+    tau_shape_ = build(tau_offset_, 0, false);
+    transpose_shape_ = build(transpose_offset_, 0, false);
+
+    if (top >= depth()) plan(top);
+}
+
+std::size_t CKKSMatMul::level_of(const Ciphertext &encrypted) const {
+    auto context_data = context_->get_context_data(encrypted.parms_id());
+    if (!context_data) throw std::invalid_argument("ciphertext is not valid for the context");
+    return context_data->chain_index();
+}
+
+std::vector<double> CKKSMatMul::mask(const std::function<bool(std::size_t, std::size_t)> &keep) const {
+    std::vector<double> values(slots_);
+    for (std::size_t s = 0; s < slots_; s++) {
+        std::size_t t = s % (d_ * d_);
+        values[s] = keep(t / d_, t % d_) ? 1.0 : 0.0;
+    }
+    return values;
+}
+
+DiagonalTransform CKKSMatMul::build(const std::function<long long(std::size_t, std::size_t)> &offset,
+                                     std::size_t level, bool encode) const {
+    std::size_t n = d_ * d_;
+    DiagonalMaps<double> maps(1, std::vector<DiagonalSet<double>>(1));
+    auto &diagonals = maps[0][0];
+    for (std::size_t i = 0; i < d_; i++) {
+        for (std::size_t j = 0; j < d_; j++) {
+            auto &diagonal = diagonals[offset(i, j)];
+            if (diagonal.empty()) diagonal.assign(n, 0.0);
+            diagonal[i * d_ + j] = 1.0;
+        }
+    }
+    if (!encode) return DiagonalTransform(maps, n);
+    return DiagonalTransform(maps, n, batch_, encoder_, level_parms_[level], primes_[level]);
+}
+
+std::size_t CKKSMatMul::keyswitches() const {
+    return sigma_shape_.rotations() + tau_shape_.rotations() + 3 * (d_ - 1) + 1;
+}
+
+std::vector<int> CKKSMatMul::galois_steps(bool transpose) const {
+    std::set<int> steps;
+    auto add = [&steps](const DiagonalTransform &shape) {
+        for (int step : shape.steps()) steps.insert(step);
+    };
+    add(sigma_shape_);
+    add(tau_shape_);
+    if (transpose) add(transpose_shape_);
+    auto d = static_cast<long long>(d_);
+    for (long long k = 1; k < d; k++) {
+        steps.insert(signed_step(k, d_ * d_));
+        steps.insert(signed_step(k - d, d_ * d_));
+        steps.insert(signed_step(d * k, d_ * d_));
+    }
+    steps.erase(0);
+    return { steps.begin(), steps.end() };
+}
+
+const CKKSMatMul::Plan &CKKSMatMul::plan(std::size_t level) const {
+    if (level < depth()) {
+        throw std::invalid_argument("matmul needs " + std::to_string(depth()) + " levels but the input has " +
+                                    std::to_string(level));
+    }
+    std::lock_guard<std::mutex> lock(plans_mutex_);
+    auto &entry = plans_[level];
+    if (!entry) {
+        auto result = std::make_unique<Plan>();
+        result->sigma = build(sigma_offset_, level, true);
+        result->tau = build(tau_offset_, level, true);
+
+        // phi^k(A)[i][j] = A[i][j + k]: columns j < d - k come from the
+        // rotation by k, the rest from the rotation by k - d
+        result->phi.resize(2 * (d_ - 1));
+        batch_.pool().parallel_for(d_ - 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin + 1; k < end + 1; k++) {
+                auto low = mask([this, k](std::size_t, std::size_t j) { return j < d_ - k; });
+                auto high = mask([this, k](std::size_t, std::size_t j) { return j >= d_ - k; });
+                encoder_.encode(low, level_parms_[level - 1], primes_[level - 1], result->phi[2 * (k - 1)]);
+                encoder_.encode(high, level_parms_[level - 1], primes_[level - 1], result->phi[2 * (k - 1) + 1]);
+            }
+        });
+        entry = std::move(result);
+    }
+    return *entry;
+}
+
+const DiagonalTransform &CKKSMatMul::transpose_plan(std::size_t level) const {
+    if (level < 1) throw std::invalid_argument("transpose needs one level");
+    std::lock_guard<std::mutex> lock(plans_mutex_);
+    auto &entry = transpose_plans_[level];
+    if (!entry) entry = std::make_unique<DiagonalTransform>(build(transpose_offset_, level, true));
+    return *entry;
+}
+
+Plaintext CKKSMatMul::encode(const std::vector<double> &matrix, double scale, parms_id_type parms_id) const {
+    std::size_t n = d_ * d_;
+    if (matrix.size() != n) throw std::invalid_argument("matrix must hold dimension * dimension values");
+    if (parms_id == parms_id_zero) parms_id = context_->first_parms_id();
+    std::vector<double> values(slots_);
+    for (std::size_t s = 0; s < slots_; s++) values[s] = matrix[s % n];
+    Plaintext plain;
+    encoder_.encode(values, parms_id, scale, plain);
+    return plain;
+}
+
+std::vector<double> CKKSMatMul::decode(const Plaintext &plain) const {
+    std::vector<double> values;
+    encoder_.decode(plain, values);
+    values.resize(d_ * d_);
+    return values;
+}
+
+Ciphertext CKKSMatMul::apply(const DiagonalTransform &transform, const Ciphertext &encrypted,
+                             const GaloisKeys &galois_keys) const {
+    Ciphertext result = transform.apply(batch_, encrypted, galois_keys);
+    result.scale() = encrypted.scale();
+    return result;
+}
+
+Ciphertext CKKSMatMul::matmul(const Ciphertext &a, const Ciphertext &b, const RelinKeys &relin_keys,
+                              const GaloisKeys &galois_keys) const {
+    auto &evaluator = batch_.evaluator();
+    std::size_t level = std::min(level_of(a), level_of(b));
+    auto &p = plan(level);
+    Ciphertext a_in, b_in;
+    evaluator.mod_switch_to(a, level_parms_[level], a_in);
+    evaluator.mod_switch_to(b, level_parms_[level], b_in);
+    Ciphertext a0 = apply(p.sigma, a_in, galois_keys);
+    Ciphertext b0 = apply(p.tau, b_in, galois_keys);
+
+    // A_k * B_k for every k, unrelinearized; one partial sum per chunk
+    std::vector<Ciphertext> partials;
+    std::mutex partials_mutex;
+    auto d = static_cast<long long>(d_);
+    batch_.pool().parallel_for(d_, [&](std::size_t begin, std::size_t end) {
+        Ciphertext partial, ak, bk;
+        for (std::size_t k = begin; k < end; k++) {
+            if (k == 0) {
+                evaluator.mod_switch_to_next(a0, ak);
+                evaluator.mod_switch_to_next(b0, bk);
+            } else {
+                Ciphertext low, high;
+                auto shift = static_cast<long long>(k);
+                evaluator.rotate_vector(a0, signed_step(shift, d_ * d_), galois_keys, low);
+                evaluator.rotate_vector(a0, signed_step(shift - d, d_ * d_), galois_keys, high);
+                ak = batch_.dot_plain({ &low, &high }, { &p.phi[2 * (k - 1)], &p.phi[2 * (k - 1) + 1] }, true);
+                ak.scale() = a0.scale();
+                evaluator.rotate_vector(b0, signed_step(d * shift, d_ * d_), galois_keys, bk);
+                evaluator.mod_switch_to_next_inplace(bk);
+            }
+            if (k == begin) {
+                evaluator.multiply(ak, bk, partial);
+            } else {
+                evaluator.multiply_inplace(ak, bk);
+                evaluator.add_inplace(partial, ak);
+            }
+        }
+        std::lock_guard<std::mutex> lock(partials_mutex);
+        partials.push_back(std::move(partial));
+    });
+
+    Ciphertext result = std::move(partials[0]);
+    for (std::size_t i = 1; i < partials.size(); i++) evaluator.add_inplace(result, partials[i]);
+    evaluator.relinearize_inplace(result, relin_keys);
+    evaluator.rescale_to_next_inplace(result);
+    return result;
+}
+
+std::vector<Ciphertext> CKKSMatMul::matmul_batch(const std::vector<const Ciphertext *> &a,
+                                                 const std::vector<const Ciphertext *> &b,
+                                                 const RelinKeys &relin_keys, const GaloisKeys &galois_keys) const {
+    if (a.size() != b.size()) throw std::invalid_argument("a and b must have the same length");
+    std::vector<Ciphertext> results(a.size());
+    if (a.size() >= batch_.threads()) {
+        // Products called from a worker run their loops inline
+        batch_.pool().parallel_for(a.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) results[i] = matmul(*a[i], *b[i], relin_keys, galois_keys);
+        });
+    } else {
+        for (std::size_t i = 0; i < a.size(); i++) results[i] = matmul(*a[i], *b[i], relin_keys, galois_keys);
+    }
+    return results;
+}
+
+Ciphertext CKKSMatMul::transpose(const Ciphertext &encrypted, const GaloisKeys &galois_keys) const {
+    return apply(transpose_plan(level_of(encrypted)), encrypted, galois_keys);
+}
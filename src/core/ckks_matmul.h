@@ -0,0 +1,118 @@
+#pragma once
+#include "batch_evaluator.h"
+#include "bsgs.h"
+#include <seal/ckks.h>
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/galoiskeys.h>
+#include <seal/plaintext.h>
+#include <seal/relinkeys.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Products of encrypted d x d matrices with the Jiang-Kim-Lauter-Song packed
+// algorithm. A matrix fills d * d slots row major (entry (i, j) at d * i + j)
+// and is repeated across the remaining slots, so d * d must divide the slot
+// count (d a power of two; pad other sizes with zeros). Every rotation is then
+// taken modulo d * d, and results come back in the same layout.
+//
+// matmul(A, B) = sum_k phi^k(sigma(A)) * psi^k(tau(B)) for 0 <= k < d, where
+// sigma and tau are the JKLS row and column skews and phi / psi shift columns
+// and rows by one. sigma and tau are DiagonalTransforms with period d * d;
+// the d products are spread over the workers, accumulated unrelinearized, and relinearized and rescaled
+// once. Three levels are consumed: one per skew, one for the column-shift
+// masks and one for the product. Masks are encoded at the prime the rescale
+// removes, so the inputs' scales come through the first two levels exactly.
+//
+// Galois keys (galois_steps()), with offsets reduced modulo d * d:
+//   sigma  offsets -(d - 1) .. d - 1 in baby-step giant-step form, about
+//          2 sqrt(2d) steps
+//   tau    offsets d * k, about 2 sqrt(d) steps
+//   phi    k and k - d for 1 <= k < d
+//   psi    d * k for 1 <= k < d
+// about 3d + O(sqrt(d)) keys in all; transpose() adds about 2 sqrt(2d) more.
+class CKKSMatMul {
+public:
+    // Plaintexts for the first data level are encoded here; other levels are
+    // encoded on first use. threads == 0 shares the process-wide pool.
+    CKKSMatMul(std::shared_ptr<seal::SEALContext> context, std::size_t dimension, std::size_t threads = 0);
+
+    std::size_t dimension() const noexcept { return d_; }
+
+    // Copies of the matrix held by one ciphertext
+    std::size_t copies() const noexcept { return slots_ / (d_ * d_); }
+    std::size_t depth() const noexcept { return 3; }
+
+    // Key switches per matmul (rotations plus one relinearization)
+    std::size_t keyswitches() const;
+
+    // Rotation steps matmul needs, plus those of transpose when requested
+    std::vector<int> galois_steps(bool transpose = false) const;
+
+    // Row-major d * d matrix to a replicated plaintext, and back from the
+    // first copy; parms_id_zero is the first data level
+    seal::Plaintext encode(const std::vector<double> &matrix, double scale,
+                           seal::parms_id_type parms_id = seal::parms_id_zero) const;
+    std::vector<double> decode(const seal::Plaintext &plain) const;
+
+    // The operand at the higher level is switched down to the other's level,
+    // which must leave at least depth() levels. The result is three levels
+    // lower with scale a.scale() * b.scale() / q, q the prime of the last
+    // rescale.
+    seal::Ciphertext matmul(const seal::Ciphertext &a, const seal::Ciphertext &b, const seal::RelinKeys &relin_keys,
+                            const seal::GaloisKeys &galois_keys) const;
+
+    // With at least as many pairs as threads every pair runs on its own
+    // worker; smaller batches run one after another with each product parallel
+    std::vector<seal::Ciphertext> matmul_batch(const std::vector<const seal::Ciphertext *> &a,
+                                               const std::vector<const seal::Ciphertext *> &b,
+                                               const seal::RelinKeys &relin_keys,
+                                               const seal::GaloisKeys &galois_keys) const;
+
+    // A^T using one level and keeping the scale; matmul(transpose(X), X) is
+    // the Gram matrix X^T X
+    seal::Ciphertext transpose(const seal::Ciphertext &encrypted, const seal::GaloisKeys &galois_keys) const;
+
+private:
+    // Plaintexts of matmul for inputs at one level; phi[2 * (k - 1)] and
+    // phi[2 * (k - 1) + 1] mask the rotations by k and k - d one level lower
+    struct Plan {
+        DiagonalTransform sigma, tau;
+        std::vector<seal::Plaintext> phi;
+    };
+
+    // The slot permutation moving the entry that offset(i, j) slots away
+    // (mod d * d) to slot d * i + j, as masked diagonals encoded at level
+    // (layout only when encode is false)
+    DiagonalTransform build(const std::function<long long(std::size_t, std::size_t)> &offset, std::size_t level,
+                            bool encode) const;
+
+    // Applies transform and keeps the input's scale
+    seal::Ciphertext apply(const DiagonalTransform &transform, const seal::Ciphertext &encrypted,
+                           const seal::GaloisKeys &galois_keys) const;
+
+    const Plan &plan(std::size_t level) const;
+    const DiagonalTransform &transpose_plan(std::size_t level) const;
+    std::size_t level_of(const seal::Ciphertext &encrypted) const;
+    std::vector<double> mask(const std::function<bool(std::size_t, std::size_t)> &keep) const;
+
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    seal::CKKSEncoder encoder_;
+    std::size_t slots_;
+    std::size_t d_;
+
+    // Per chain index: parms_id and the prime removed by rescaling
+    std::vector<seal::parms_id_type> level_parms_;
+    std::vector<double> primes_;
+
+    std::function<long long(std::size_t, std::size_t)> sigma_offset_, tau_offset_, transpose_offset_;
+    DiagonalTransform sigma_shape_, tau_shape_, transpose_shape_;
+
+    mutable std::mutex plans_mutex_;
+    mutable std::map<std::size_t, std::unique_ptr<Plan>> plans_;
+    mutable std::map<std::size_t, std::unique_ptr<DiagonalTransform>> transpose_plans_;
+};
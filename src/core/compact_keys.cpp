@@ -0,0 +1,179 @@
+#include "compact_keys.h"
+#include <seal/serializable.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace seal;
+
+namespace {
+    // Saves a seeded Serializable without compression so cold expansion only
+    // pays for the PRNG, not for a decompressor
+    template <class T>
+    std::vector<seal_byte> save_seeded(const Serializable<T> &obj) {
+        std::vector<seal_byte> out(static_cast<std::size_t>(obj.save_size(compr_mode_type::none)));
+        auto written = obj.save(out.data(), out.size(), compr_mode_type::none);
+        out.resize(static_cast<std::size_t>(written));
+        out.shrink_to_fit();
+        return out;
+    }
+
+    void check_keyswitching(const SEALContext &context) {
+        if (!context.parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+        if (!context.using_keyswitching()) throw std::logic_error("keyswitching is not supported by the context");
+    }
+}
+
+CompactGaloisKeys::CompactGaloisKeys(std::shared_ptr<SEALContext> context, KeyGenerator &keygen,
+                                     const std::vector<std::uint32_t> &galois_elts, std::size_t cache_size)
+    : context_(std::move(context)), cache_size_(cache_size) {
+    check_keyswitching(*context_);
+    auto elts = galois_elts.empty() ? context_->key_context_data()->galois_tool()->get_elts_all() : galois_elts;
+    for (auto elt : elts) {
+        if (seeded_.count(elt)) continue;
+        auto blob = save_seeded(keygen.create_galois_keys(std::vector<std::uint32_t>{ elt }));
+        compact_bytes_ += blob.size();
+        seeded_.emplace(elt, std::move(blob));
+    }
+}
+
+std::vector<std::uint32_t> CompactGaloisKeys::elts_from_steps(const SEALContext &context, const std::vector<int> &steps) {
+    check_keyswitching(context);
+    return context.key_context_data()->galois_tool()->get_elts_from_steps(steps);
+}
+
+std::vector<std::uint32_t> CompactGaloisKeys::galois_elts() const {
+    std::vector<std::uint32_t> elts;
+    elts.reserve(seeded_.size());
+    for (auto &entry : seeded_) elts.push_back(entry.first);
+    std::sort(elts.begin(), elts.end());
+    return elts;
+}
+
+std::shared_ptr<const GaloisKeys> CompactGaloisKeys::get(std::uint32_t galois_elt) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto cached = cache_.find(galois_elt);
+    if (cached != cache_.end()) {
+        hits_++;
+        lru_.splice(lru_.begin(), lru_, cached->second.position);
+        return cached->second.keys;
+    }
+    misses_++;
+
+    auto blob = seeded_.find(galois_elt);
+    if (blob == seeded_.end()) {
+        throw std::invalid_argument("no Galois key for element " + std::to_string(galois_elt));
+    }
+
+    // Expand outside the lock; the seeded blobs are immutable after construction
+    lock.unlock();
+    auto keys = std::make_shared<GaloisKeys>();
+    keys->unsafe_load(*context_, blob->second.data(), blob->second.size());
+    lock.lock();
+
+    cached = cache_.find(galois_elt);
+    if (cached != cache_.end()) return cached->second.keys;
+    if (cache_size_ == 0) return keys;
+    lru_.push_front(galois_elt);
+    cache_.emplace(galois_elt, CacheEntry{ keys, lru_.begin() });
+    evict_locked();
+    return keys;
+}
+
+GaloisKeys CompactGaloisKeys::expand(const std::vector<std::uint32_t> &galois_elts) {
+    GaloisKeys result;
+    for (auto elt : galois_elts) {
+        auto keys = get(elt);
+        auto index = GaloisKeys::get_index(elt);
+        if (result.data().size() <= index) result.data().resize(index + 1);
+        result.data()[index] = keys->data()[index];
+        result.parms_id() = keys->parms_id();
+    }
+    return result;
+}
+
+void CompactGaloisKeys::apply_galois(const Evaluator &evaluator, const Ciphertext &encrypted, std::uint32_t galois_elt,
+                                     Ciphertext &destination) {
+    auto keys = get(galois_elt);
+    evaluator.apply_galois(encrypted, galois_elt, *keys, destination);
+}
+
+void CompactGaloisKeys::rotate(const Evaluator &evaluator, const Ciphertext &encrypted, int steps, Ciphertext &destination) {
+    if (steps == 0) {
+        destination = encrypted;
+        return;
+    }
+    auto elt = context_->key_context_data()->galois_tool()->get_elt_from_step(steps);
+    apply_galois(evaluator, encrypted, elt, destination);
+}
+
+void CompactGaloisKeys::conjugate(const Evaluator &evaluator, const Ciphertext &encrypted, Ciphertext &destination) {
+    // Step 0 maps to the conjugation / column-swap element 2N - 1
+    auto elt = context_->key_context_data()->galois_tool()->get_elt_from_step(0);
+    apply_galois(evaluator, encrypted, elt, destination);
+}
+
+void CompactGaloisKeys::set_cache_size(std::size_t cache_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_size_ = cache_size;
+    evict_locked();
+}
+
+void CompactGaloisKeys::clear_cache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+    lru_.clear();
+}
+
+std::size_t CompactGaloisKeys::cached_keys() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+}
+
+std::uint64_t CompactGaloisKeys::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+std::uint64_t CompactGaloisKeys::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+void CompactGaloisKeys::evict_locked() {
+    while (cache_.size() > cache_size_) {
+        cache_.erase(lru_.back());
+        lru_.pop_back();
+    }
+}
+
+CompactRelinKeys::CompactRelinKeys(std::shared_ptr<SEALContext> context, KeyGenerator &keygen)
+    : context_(std::move(context)) {
+    check_keyswitching(*context_);
+    seeded_ = save_seeded(keygen.create_relin_keys());
+}
+
+std::shared_ptr<const RelinKeys> CompactRelinKeys::get() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!expanded_) {
+        auto keys = std::make_shared<RelinKeys>();
+        keys->unsafe_load(*context_, seeded_.data(), seeded_.size());
+        expanded_ = std::move(keys);
+    }
+    return expanded_;
+}
+
+void CompactRelinKeys::relinearize(const Evaluator &evaluator, const Ciphertext &encrypted, Ciphertext &destination) {
+    auto keys = get();
+    evaluator.relinearize(encrypted, *keys, destination);
+}
+
+void CompactRelinKeys::release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    expanded_.reset();
+}
+
+bool CompactRelinKeys::expanded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return expanded_ != nullptr;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <seal/context.h>
+#include <seal/keygenerator.h>
+#include <seal/galoiskeys.h>
+#include <seal/relinkeys.h>
+#include <seal/evaluator.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Galois keys held in SEAL's seeded wire format: the pseudorandom half of each
+// key-switching key is kept as a PRNG seed, roughly halving resident memory.
+// Individual Galois elements are expanded on demand into a bounded LRU cache.
+class CompactGaloisKeys {
+public:
+    // Generates one seeded key per Galois element (all of them when empty)
+    CompactGaloisKeys(std::shared_ptr<seal::SEALContext> context, seal::KeyGenerator &keygen,
+                      const std::vector<std::uint32_t> &galois_elts, std::size_t cache_size);
+
+    static std::vector<std::uint32_t> elts_from_steps(const seal::SEALContext &context, const std::vector<int> &steps);
+
+    bool has_key(std::uint32_t galois_elt) const { return seeded_.count(galois_elt) != 0; }
+    std::vector<std::uint32_t> galois_elts() const;
+
+    // Returns the expanded key for one element, expanding it on a cache miss
+    std::shared_ptr<const seal::GaloisKeys> get(std::uint32_t galois_elt);
+
+    // Builds a regular GaloisKeys object holding the requested elements
+    seal::GaloisKeys expand(const std::vector<std::uint32_t> &galois_elts);
+
+    void apply_galois(const seal::Evaluator &evaluator, const seal::Ciphertext &encrypted, std::uint32_t galois_elt,
+                      seal::Ciphertext &destination);
+    void rotate(const seal::Evaluator &evaluator, const seal::Ciphertext &encrypted, int steps,
+                seal::Ciphertext &destination);
+    void conjugate(const seal::Evaluator &evaluator, const seal::Ciphertext &encrypted, seal::Ciphertext &destination);
+
+    std::size_t cache_size() const noexcept { return cache_size_; }
+    void set_cache_size(std::size_t cache_size);
+    void clear_cache();
+
+    std::size_t cached_keys() const;
+    std::size_t compact_bytes() const noexcept { return compact_bytes_; }
+    std::uint64_t hits() const;
+    std::uint64_t misses() const;
+
+private:
+    void evict_locked();
+
+    std::shared_ptr<seal::SEALContext> context_;
+    std::unordered_map<std::uint32_t, std::vector<seal::seal_byte>> seeded_;
+    std::size_t compact_bytes_ = 0;
+
+    using lru_list = std::list<std::uint32_t>;
+    struct CacheEntry {
+        std::shared_ptr<const seal::GaloisKeys> keys;
+        lru_list::iterator position;
+    };
+    mutable std::mutex mutex_;
+    lru_list lru_;
+    std::unordered_map<std::uint32_t, CacheEntry> cache_;
+    std::size_t cache_size_;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+// Relinearization keys kept seeded at rest and expanded on first use.
+class CompactRelinKeys {
+public:
+    CompactRelinKeys(std::shared_ptr<seal::SEALContext> context, seal::KeyGenerator &keygen);
+
+    // Returns the expanded keys, expanding them on first use
+    std::shared_ptr<const seal::RelinKeys> get();
+
+    void relinearize(const seal::Evaluator &evaluator, const seal::Ciphertext &encrypted,
+                     seal::Ciphertext &destination);
+
+    // Drops the expanded copy; in-flight operations keep theirs alive
+    void release();
+    bool expanded() const;
+    std::size_t compact_bytes() const noexcept { return seeded_.size(); }
+
+private:
+    std::shared_ptr<seal::SEALContext> context_;
+    std::vector<seal::seal_byte> seeded_;
+    mutable std::mutex mutex_;
+    std::shared_ptr<const seal::RelinKeys> expanded_;
+};
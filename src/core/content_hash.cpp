@@ -0,0 +1,119 @@
+#include "content_hash.h"
+#include <cstring>
+
+using namespace seal;
+
+namespace {
+    constexpr std::uint64_t prime1 = 11400714785074694791ULL;
+    constexpr std::uint64_t prime2 = 14029467366897019727ULL;
+    constexpr std::uint64_t prime3 = 1609587929392839161ULL;
+    constexpr std::uint64_t prime4 = 9650029242287828579ULL;
+    constexpr std::uint64_t prime5 = 2870177450012600261ULL;
+
+    inline std::uint64_t rotl(std::uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline std::uint64_t mix_round(std::uint64_t acc, std::uint64_t input) {
+        return rotl(acc + input * prime2, 31) * prime1;
+    }
+
+    inline std::uint64_t merge(std::uint64_t acc, std::uint64_t lane) {
+        return (acc ^ mix_round(0, lane)) * prime1 + prime4;
+    }
+
+    inline std::uint64_t avalanche(std::uint64_t h) {
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+    }
+}
+
+ContentHasher::ContentHasher(std::uint64_t seed) : seed_(seed) {
+    lanes_[0] = seed + prime1 + prime2;
+    lanes_[1] = seed + prime2;
+    lanes_[2] = seed;
+    lanes_[3] = seed - prime1;
+}
+
+void ContentHasher::update(const std::uint64_t *words, std::size_t count) {
+    length_ += count;
+    // Top up a partial stripe left by a previous call
+    while (tail_count_ && count) {
+        tail_[tail_count_++] = *words++;
+        count--;
+        if (tail_count_ == 4) {
+            for (int i = 0; i < 4; i++) lanes_[i] = mix_round(lanes_[i], tail_[i]);
+            tail_count_ = 0;
+        }
+    }
+    for (; count >= 4; count -= 4, words += 4) {
+        lanes_[0] = mix_round(lanes_[0], words[0]);
+        lanes_[1] = mix_round(lanes_[1], words[1]);
+        lanes_[2] = mix_round(lanes_[2], words[2]);
+        lanes_[3] = mix_round(lanes_[3], words[3]);
+    }
+    while (count--) tail_[tail_count_++] = *words++;
+}
+
+void ContentHasher::update(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    update(bits);
+}
+
+void ContentHasher::update(const ContentHash &hash) {
+    std::uint64_t words[2] = { hash.lo, hash.hi };
+    update(words, 2);
+}
+
+ContentHash ContentHasher::finish() const {
+    // Two differently rotated and ordered folds of the same lanes
+    std::uint64_t lo = rotl(lanes_[0], 1) + rotl(lanes_[1], 7) + rotl(lanes_[2], 12) + rotl(lanes_[3], 18);
+    std::uint64_t hi = rotl(lanes_[3], 1) + rotl(lanes_[2], 7) + rotl(lanes_[1], 12) + rotl(lanes_[0], 18) + prime5;
+    for (int i = 0; i < 4; i++) {
+        lo = merge(lo, lanes_[i]);
+        hi = merge(hi ^ seed_, lanes_[3 - i]);
+    }
+    lo += length_ * 8;
+    hi += length_ * prime5;
+    for (std::size_t i = 0; i < tail_count_; i++) {
+        lo = rotl(lo ^ mix_round(0, tail_[i]), 27) * prime1 + prime4;
+        hi = rotl(hi ^ mix_round(prime5, tail_[i]), 29) * prime2 + prime3;
+    }
+    return { avalanche(lo), avalanche(hi ^ (lo >> 1)) };
+}
+
+ContentHash content_hash(const Ciphertext &encrypted) {
+    ContentHasher hasher;
+    hasher.update(encrypted.parms_id().data(), encrypted.parms_id().size());
+    hasher.update(encrypted.scale());
+    hasher.update(static_cast<std::uint64_t>(encrypted.is_ntt_form()));
+    hasher.update(static_cast<std::uint64_t>(encrypted.size()));
+    hasher.update(encrypted.correction_factor());
+    hasher.update(encrypted.data(), encrypted.dyn_array().size());
+    return hasher.finish();
+}
+
+ContentHash content_hash(const Plaintext &plain) {
+    ContentHasher hasher(1);
+    hasher.update(plain.parms_id().data(), plain.parms_id().size());
+    hasher.update(plain.scale());
+    hasher.update(static_cast<std::uint64_t>(plain.coeff_count()));
+    hasher.update(plain.data(), plain.coeff_count());
+    return hasher.finish();
+}
+
+ContentHash content_hash(const KSwitchKeys &keys) {
+    ContentHasher hasher(2);
+    hasher.update(keys.parms_id().data(), keys.parms_id().size());
+    for (std::size_t i = 0; i < keys.data().size(); i++) {
+        hasher.update(static_cast<std::uint64_t>(i));
+        hasher.update(static_cast<std::uint64_t>(keys.data()[i].size()));
+        for (auto &key : keys.data()[i]) hasher.update(key.data().data(), key.data().dyn_array().size());
+    }
+    return hasher.finish();
+}
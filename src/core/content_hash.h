@@ -0,0 +1,56 @@
+#pragma once
+#include <seal/ciphertext.h>
+#include <seal/plaintext.h>
+#include <seal/kswitchkeys.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// 128-bit content digest. Not cryptographic: it is meant for cache keys and
+// deduplication, where the width only has to make accidental collisions
+// negligible.
+struct ContentHash {
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    bool operator==(const ContentHash &other) const noexcept { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const ContentHash &other) const noexcept { return !(*this == other); }
+};
+
+namespace std {
+    template <>
+    struct hash<ContentHash> {
+        std::size_t operator()(const ContentHash &h) const noexcept { return static_cast<std::size_t>(h.lo); }
+    };
+}
+
+// Streaming word hash with four independent lanes (xxHash64-style rounds), so
+// long polynomials hash at close to memory bandwidth
+class ContentHasher {
+public:
+    explicit ContentHasher(std::uint64_t seed = 0);
+
+    void update(const std::uint64_t *words, std::size_t count);
+    void update(std::uint64_t word) { update(&word, 1); }
+    void update(double value);
+    void update(const ContentHash &hash);
+
+    ContentHash finish() const;
+
+private:
+    std::uint64_t lanes_[4];
+    std::uint64_t tail_[4];
+    std::size_t tail_count_ = 0;
+    std::uint64_t length_ = 0;
+    std::uint64_t seed_;
+};
+
+// Covers parms_id, scale, NTT form, size, correction factor and all data
+ContentHash content_hash(const seal::Ciphertext &encrypted);
+
+// Covers parms_id, scale, coefficient count and all data
+ContentHash content_hash(const seal::Plaintext &plain);
+
+// Covers parms_id and every key-switching key; meant to be computed once per
+// key set since Galois keys can be large
+ContentHash content_hash(const seal::KSwitchKeys &keys);
@@ -0,0 +1,87 @@
+#include "context_registry.h"
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace py = pybind11;
+using namespace seal;
+
+namespace {
+    struct RegistryEntry {
+        std::weak_ptr<SEALContext> context;
+        const SEALContext *raw;
+        bool expand_mod_chain;
+        sec_level_type sec_level;
+    };
+
+    std::mutex registry_mutex;
+    std::vector<RegistryEntry> registry;
+
+    void prune_expired() {
+        std::vector<RegistryEntry> live;
+        live.reserve(registry.size());
+        for (auto &entry : registry) {
+            if (!entry.context.expired()) live.push_back(entry);
+        }
+        registry.swap(live);
+    }
+
+    const RegistryEntry *entry_for(const SEALContext &context) {
+        for (auto &entry : registry) {
+            if (entry.raw == &context && !entry.context.expired()) return &entry;
+        }
+        return nullptr;
+    }
+}
+
+void register_context(const std::shared_ptr<SEALContext> &context, bool expand_mod_chain, sec_level_type sec_level) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    prune_expired();
+    registry.push_back({ context, context.get(), expand_mod_chain, sec_level });
+}
+
+std::shared_ptr<SEALContext> find_context(const parms_id_type &parms_id) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto it = registry.rbegin(); it != registry.rend(); ++it) {
+        auto context = it->context.lock();
+        if (!context) continue;
+        if (parms_id == parms_id_zero || context->get_context_data(parms_id)) return context;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<SEALContext> require_context(const parms_id_type &parms_id) {
+    auto context = find_context(parms_id);
+    if (!context) {
+        throw std::runtime_error(
+            "No live SEALContext matches this parms_id; create a SEALContext with the same parameters first");
+    }
+    return context;
+}
+
+bool context_expand_mod_chain(const SEALContext &context) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto entry = entry_for(context);
+    return entry ? entry->expand_mod_chain : true;
+}
+
+sec_level_type context_sec_level(const SEALContext &context) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto entry = entry_for(context);
+    return entry ? entry->sec_level : sec_level_type::tc128;
+}
+
+py::bytes parms_id_to_bytes(const parms_id_type &parms_id) {
+    return py::bytes(reinterpret_cast<const char*>(parms_id.data()), sizeof(parms_id_type));
+}
+
+parms_id_type parms_id_from_bytes(const py::bytes &parms_id_bytes) {
+    std::string bytes = parms_id_bytes;
+    if (bytes.size() != sizeof(parms_id_type)) {
+        throw std::invalid_argument("parms_id must be 32 bytes");
+    }
+    parms_id_type parms_id;
+    std::memcpy(parms_id.data(), bytes.data(), sizeof(parms_id_type));
+    return parms_id;
+}
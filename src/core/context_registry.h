@@ -0,0 +1,24 @@
+#pragma once
+#include <seal/context.h>
+#include <pybind11/pybind11.h>
+#include <memory>
+
+// Process-wide registry of live SEALContext objects. Pickled SEAL objects carry
+// only a parms_id and are re-attached to a registered context on unpickling, so
+// contexts never travel inside the pickle stream.
+void register_context(const std::shared_ptr<seal::SEALContext> &context,
+                      bool expand_mod_chain, seal::sec_level_type sec_level);
+
+// Returns the newest registered context whose modulus chain contains parms_id,
+// or nullptr. parms_id_zero matches the newest live context.
+std::shared_ptr<seal::SEALContext> find_context(const seal::parms_id_type &parms_id);
+
+// Same as find_context but throws std::runtime_error when nothing matches.
+std::shared_ptr<seal::SEALContext> require_context(const seal::parms_id_type &parms_id);
+
+// Returns the flags the context was registered with.
+bool context_expand_mod_chain(const seal::SEALContext &context);
+seal::sec_level_type context_sec_level(const seal::SEALContext &context);
+
+pybind11::bytes parms_id_to_bytes(const seal::parms_id_type &parms_id);
+seal::parms_id_type parms_id_from_bytes(const pybind11::bytes &parms_id_bytes);
@@ -0,0 +1,164 @@
+#include "conv2d.h"
+#include "rns_kernels.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace seal;
+
+namespace {
+    std::size_t next_power_of_two(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+Conv2D::Conv2D(std::shared_ptr<SEALContext> context, std::size_t in_channels, std::size_t height, std::size_t width,
+               std::size_t out_channels, std::size_t kernel_size, const std::vector<double> &weights,
+               const std::vector<double> &bias, parms_id_type parms_id, double scale_factor, std::size_t threads)
+    : context_(std::move(context)), batch_(context_, threads), encoder_(*context_), parms_id_(parms_id),
+      in_channels_(in_channels), padded_channels_(next_power_of_two(in_channels)), height_(height), width_(width),
+      out_channels_(out_channels), kernel_size_(kernel_size), bias_(bias) {
+    auto context_data = context_->get_context_data(parms_id_);
+    if (!context_data) throw std::invalid_argument("parms_id is not valid for the context");
+    if (context_data->parms().scheme() != scheme_type::ckks) throw std::invalid_argument("Conv2D requires CKKS");
+    if (!in_channels || !out_channels || !height || !width) throw std::invalid_argument("dimensions must be positive");
+    if (kernel_size % 2 == 0) throw std::invalid_argument("kernel_size must be odd");
+    if (padded_channels_ * height * width > encoder_.slot_count()) {
+        throw std::invalid_argument("image does not fit in the slots");
+    }
+    std::size_t taps = kernel_size * kernel_size;
+    if (weights.size() != out_channels * in_channels * taps) throw std::invalid_argument("weights have the wrong size");
+    if (!bias_.empty() && bias_.size() != out_channels) throw std::invalid_argument("bias has the wrong size");
+
+    auto &coeff_modulus = context_data->parms().coeff_modulus();
+    if (coeff_modulus.size() < 2) throw std::invalid_argument("parms_id has no level left to rescale");
+    weight_scale_ = scale_factor > 0 ? scale_factor : static_cast<double>(coeff_modulus.back().value());
+
+    masks_.resize(out_channels * taps);
+    present_.assign(out_channels * taps, 0);
+    std::size_t plane = height * width;
+    auto half = static_cast<std::ptrdiff_t>(kernel_size / 2);
+    batch_.pool().parallel_for(masks_.size(), [&](std::size_t begin, std::size_t end) {
+        std::vector<double> mask(encoder_.slot_count());
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t o = i / taps, t = i % taps;
+            auto dy = static_cast<std::ptrdiff_t>(t / kernel_size) - half;
+            auto dx = static_cast<std::ptrdiff_t>(t % kernel_size) - half;
+            std::fill(mask.begin(), mask.end(), 0.0);
+            bool any = false;
+            for (std::size_t c = 0; c < in_channels_; c++) {
+                double w = weights[(o * in_channels_ + c) * taps + t];
+                if (w == 0.0) continue;
+                for (std::size_t y = 0; y < height_; y++) {
+                    auto sy = static_cast<std::ptrdiff_t>(y) + dy;
+                    if (sy < 0 || sy >= static_cast<std::ptrdiff_t>(height_)) continue;
+                    for (std::size_t x = 0; x < width_; x++) {
+                        auto sx = static_cast<std::ptrdiff_t>(x) + dx;
+                        if (sx < 0 || sx >= static_cast<std::ptrdiff_t>(width_)) continue;
+                        mask[c * plane + y * width_ + x] = w;
+                        any = true;
+                    }
+                }
+            }
+            if (!any) continue;
+            encoder_.encode(mask, parms_id_, weight_scale_, masks_[i]);
+            present_[i] = 1;
+        }
+    });
+}
+
+int Conv2D::tap_step(std::size_t tap) const {
+    auto half = static_cast<std::ptrdiff_t>(kernel_size_ / 2);
+    auto dy = static_cast<std::ptrdiff_t>(tap / kernel_size_) - half;
+    auto dx = static_cast<std::ptrdiff_t>(tap % kernel_size_) - half;
+    return static_cast<int>(dy * static_cast<std::ptrdiff_t>(width_) + dx);
+}
+
+std::vector<int> Conv2D::galois_steps() const {
+    std::vector<int> steps;
+    for (std::size_t t = 0; t < kernel_size_ * kernel_size_; t++) {
+        if (tap_step(t) != 0) steps.push_back(tap_step(t));
+    }
+    for (std::size_t s = 1; s < padded_channels_; s <<= 1) steps.push_back(static_cast<int>(s * height_ * width_));
+    std::sort(steps.begin(), steps.end());
+    steps.erase(std::unique(steps.begin(), steps.end()), steps.end());
+    return steps;
+}
+
+std::vector<double> Conv2D::pack(const std::vector<double> &image) const {
+    if (image.size() != in_channels_ * height_ * width_) throw std::invalid_argument("image has the wrong size");
+    std::vector<double> slots(encoder_.slot_count(), 0.0);
+    std::copy(image.begin(), image.end(), slots.begin());
+    return slots;
+}
+
+Plaintext Conv2D::encode(const std::vector<double> &image, double scale) const {
+    Plaintext plain;
+    encoder_.encode(pack(image), parms_id_, scale, plain);
+    return plain;
+}
+
+std::vector<double> Conv2D::decode(const Plaintext &plain) const {
+    std::vector<double> values;
+    encoder_.decode(plain, values);
+    values.resize(height_ * width_);
+    return values;
+}
+
+std::vector<Ciphertext> Conv2D::apply(const Ciphertext &encrypted, const GaloisKeys &galois_keys) const {
+    if (encrypted.parms_id() != parms_id_) throw std::invalid_argument("encrypted is not at the Conv2D level");
+    if (!encrypted.is_ntt_form() || encrypted.size() != 2) {
+        throw std::invalid_argument("encrypted must be a relinearized CKKS ciphertext");
+    }
+    const Evaluator &evaluator = batch_.evaluator();
+    std::size_t taps = kernel_size_ * kernel_size_;
+
+    // Each tap rotation is computed once from the input and shared by all
+    // output channels; taps with only zero weights are skipped
+    std::vector<char> needed(taps, 0);
+    for (std::size_t i = 0; i < masks_.size(); i++) {
+        if (present_[i]) needed[i % taps] = 1;
+    }
+    std::vector<Ciphertext> rotated(taps);
+    batch_.pool().parallel_for(taps, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; t++) {
+            if (!needed[t]) continue;
+            if (tap_step(t) == 0) {
+                rotated[t] = encrypted;
+            } else {
+                evaluator.rotate_vector(encrypted, tap_step(t), galois_keys, rotated[t]);
+            }
+        }
+    });
+
+    auto &coeff_modulus = context_->get_context_data(parms_id_)->parms().coeff_modulus();
+    std::size_t coeff_count = encrypted.poly_modulus_degree();
+    std::size_t poly_words = coeff_count * coeff_modulus.size();
+    std::vector<Ciphertext> outputs(out_channels_);
+    batch_.pool().parallel_for(out_channels_, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::uint64_t> scratch(coeff_count);
+        Ciphertext shifted;
+        for (std::size_t o = begin; o < end; o++) {
+            auto &result = outputs[o];
+            result = encrypted;
+            std::fill_n(result.data(), 2 * poly_words, std::uint64_t(0));
+            for (std::size_t t = 0; t < taps; t++) {
+                if (!present_[o * taps + t]) continue;
+                const std::uint64_t *mask = masks_[o * taps + t].data();
+                multiply_accumulate(rotated[t].data(0), mask, result.data(0), coeff_count, coeff_modulus, scratch.data());
+                multiply_accumulate(rotated[t].data(1), mask, result.data(1), coeff_count, coeff_modulus, scratch.data());
+            }
+            result.scale() = encrypted.scale() * weight_scale_;
+            evaluator.rescale_to_next_inplace(result);
+
+            // Sum the per-channel partials into the first channel block
+            for (std::size_t s = 1; s < padded_channels_; s <<= 1) {
+                evaluator.rotate_vector(result, static_cast<int>(s * height_ * width_), galois_keys, shifted);
+                evaluator.add_inplace(result, shifted);
+            }
+            if (!bias_.empty() && bias_[o] != 0.0) batch_.add_scalar(result, bias_[o]);
+        }
+    });
+    return outputs;
+}
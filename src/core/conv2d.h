@@ -0,0 +1,68 @@
+#pragma once
+#include "batch_evaluator.h"
+#include <seal/ckks.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Stride-1, zero-padded ("same") 2-D convolution over a CKKS-packed tensor.
+//
+// Slot layout: an image of C channels, H rows and W columns is packed channel
+// major, slot c * H * W + y * W + x holds pixel (c, y, x). The channel count is
+// padded to a power of two Cp and Cp * H * W must fit in the slot count; all
+// other slots are zero.
+//
+// Output channel o is returned as its own ciphertext with pixel (y, x) in slot
+// y * W + x, one level below the input and at the input scale. Slots past
+// H * W hold partial sums and should be ignored (or masked before reuse).
+//
+// Weights are row-major [out][in][k][k]; tap (dy, dx) reads pixel
+// (y + dy - k / 2, x + dx - k / 2). For each output channel and tap one
+// NTT-form plaintext holds the weights of all input channels, with zeros
+// where the tap falls outside the image.
+class Conv2D {
+public:
+    // scale_factor == 0 encodes the weights with the last prime at parms_id,
+    // so the single rescale returns outputs to the input scale exactly
+    Conv2D(std::shared_ptr<seal::SEALContext> context, std::size_t in_channels, std::size_t height, std::size_t width,
+           std::size_t out_channels, std::size_t kernel_size, const std::vector<double> &weights,
+           const std::vector<double> &bias, seal::parms_id_type parms_id, double scale_factor = 0,
+           std::size_t threads = 0);
+
+    std::size_t in_channels() const noexcept { return in_channels_; }
+    std::size_t out_channels() const noexcept { return out_channels_; }
+    std::size_t height() const noexcept { return height_; }
+    std::size_t width() const noexcept { return width_; }
+    std::size_t kernel_size() const noexcept { return kernel_size_; }
+    const seal::parms_id_type &parms_id() const noexcept { return parms_id_; }
+
+    // Rotation steps used by apply: one per kernel tap plus the channel-sum tree
+    std::vector<int> galois_steps() const;
+
+    // Packs a [C][H][W] image into slot order
+    std::vector<double> pack(const std::vector<double> &image) const;
+    seal::Plaintext encode(const std::vector<double> &image, double scale) const;
+
+    // Extracts the H * W output pixels of one output channel
+    std::vector<double> decode(const seal::Plaintext &plain) const;
+
+    // Rotates the input once per tap, shared by every output channel, then
+    // accumulates tap products per output channel in parallel with a single
+    // rescale each before the channel sum
+    std::vector<seal::Ciphertext> apply(const seal::Ciphertext &encrypted, const seal::GaloisKeys &galois_keys) const;
+
+private:
+    int tap_step(std::size_t tap) const;
+
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    seal::CKKSEncoder encoder_;
+    seal::parms_id_type parms_id_;
+    std::size_t in_channels_, padded_channels_, height_, width_, out_channels_, kernel_size_;
+    double weight_scale_;
+
+    // masks_[o * taps + t]; present_[o * taps + t] is false for all-zero taps
+    std::vector<seal::Plaintext> masks_;
+    std::vector<char> present_;
+    std::vector<double> bias_;
+};
@@ -0,0 +1,151 @@
+#include "cpu_dispatch.h"
+#include "rns_kernels.h"
+#include <seal/util/config.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+    CpuFeatures detect() {
+        CpuFeatures features;
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        features.sse4_2 = __builtin_cpu_supports("sse4.2");
+        features.avx = __builtin_cpu_supports("avx");
+        features.avx2 = __builtin_cpu_supports("avx2");
+        features.bmi2 = __builtin_cpu_supports("bmi2");
+        features.avx512f = __builtin_cpu_supports("avx512f");
+        features.avx512dq = __builtin_cpu_supports("avx512dq");
+        features.avx512ifma = __builtin_cpu_supports("avx512ifma");
+        features.avx512vbmi2 = __builtin_cpu_supports("avx512vbmi2");
+#endif
+        return features;
+    }
+
+    std::string read_request() {
+        const char *value = std::getenv("SEAL_PYTHON_BACKEND");
+        std::string request = value ? value : "";
+        std::transform(request.begin(), request.end(), request.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return request;
+    }
+
+    KernelTable select() {
+        auto available = available_backends();
+        auto &request = requested_backend();
+        KernelBackend wanted = available.back();
+        if (request == "baseline") {
+            wanted = KernelBackend::baseline;
+        } else if (request == "avx2") {
+            wanted = KernelBackend::avx2;
+        } else if (request == "hexl") {
+            wanted = KernelBackend::hexl;
+        } else if (!request.empty() && request != "auto") {
+            throw std::invalid_argument("SEAL_PYTHON_BACKEND must be baseline, avx2, hexl or auto, not '" + request +
+                                        "'");
+        }
+        // Fastest available backend not above the request
+        KernelBackend chosen = KernelBackend::baseline;
+        for (auto backend : available) {
+            if (static_cast<int>(backend) <= static_cast<int>(wanted)) chosen = backend;
+        }
+        return kernel_table(chosen);
+    }
+}
+
+const CpuFeatures &cpu_features() {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+bool hexl_compiled() {
+#ifdef SEAL_USE_INTEL_HEXL
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<KernelBackend> available_backends() {
+    auto &features = cpu_features();
+    std::vector<KernelBackend> backends{ KernelBackend::baseline };
+    if (features.avx2 && features.bmi2) backends.push_back(KernelBackend::avx2);
+    // Without AVX-512 HEXL falls back to scalar code, which the fused
+    // kernels beat
+    if (hexl_compiled() && features.avx512f && features.avx512dq) backends.push_back(KernelBackend::hexl);
+    return backends;
+}
+
+const std::string &requested_backend() {
+    static const std::string request = read_request();
+    return request;
+}
+
+const KernelTable &kernels() {
+    static const KernelTable table = select();
+    return table;
+}
+
+const char *backend_name(KernelBackend backend) {
+    switch (backend) {
+    case KernelBackend::avx2:
+        return "avx2";
+    case KernelBackend::hexl:
+        return "hexl";
+    default:
+        return "baseline";
+    }
+}
+
+KernelTable kernel_table(KernelBackend backend) {
+    switch (backend) {
+    case KernelBackend::avx2:
+        return { backend, &multiply_accumulate_limb_avx2 };
+    case KernelBackend::hexl:
+        // The limb kernel is unused: rns_kernels.h calls SEAL's helpers
+        return { backend, &multiply_accumulate_limb_baseline };
+    default:
+        return { KernelBackend::baseline, &multiply_accumulate_limb_baseline };
+    }
+}
+
+std::vector<BackendTiming> benchmark_backends(const seal::SEALContext &context, std::size_t iterations) {
+    auto &parms = context.first_context_data()->parms();
+    auto &coeff_modulus = parms.coeff_modulus();
+    std::size_t coeff_count = parms.poly_modulus_degree();
+    std::size_t words = coeff_count * coeff_modulus.size();
+
+    // splitmix64 data, reduced into each limb's range
+    std::vector<std::uint64_t> x(words), y(words), scratch(coeff_count);
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    auto next = [&]() {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    };
+    for (std::size_t i = 0; i < words; i++) {
+        auto modulus = coeff_modulus[i / coeff_count].value();
+        x[i] = next() % modulus;
+        y[i] = next() % modulus;
+    }
+
+    std::vector<BackendTiming> timings;
+    for (auto backend : available_backends()) {
+        auto table = kernel_table(backend);
+        std::vector<std::uint64_t> acc(words, 0);
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; i++) {
+            multiply_accumulate(x.data(), y.data(), acc.data(), coeff_count, coeff_modulus, scratch.data(), table);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        BackendTiming timing;
+        timing.backend = backend;
+        timing.seconds_per_call = iterations ? seconds / static_cast<double>(iterations) : 0.0;
+        for (auto word : acc) timing.checksum = timing.checksum * 1099511628211ULL ^ word;
+        timings.push_back(timing);
+    }
+    return timings;
+}
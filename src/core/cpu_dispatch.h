@@ -0,0 +1,75 @@
+#pragma once
+#include <seal/context.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Instruction-set extensions of the running CPU, read once from CPUID
+struct CpuFeatures {
+    bool sse4_2 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool avx512dq = false;
+    bool avx512ifma = false;
+    bool avx512vbmi2 = false;
+};
+
+// Which build of the native RNS kernels runs. hexl routes them through
+// SEAL's HEXL-backed helpers, whose AVX-512 (DQ / IFMA) paths HEXL itself
+// selects at runtime; baseline and avx2 use this module's fused kernels
+// compiled for plain x86-64 and for AVX2 + BMI2.
+enum class KernelBackend { baseline, avx2, hexl };
+
+// acc[i] = (acc[i] + x[i] * y[i]) mod modulus over one limb; const_ratio is
+// Modulus::const_ratio() (floor(2^128 / modulus), low word first)
+using multiply_accumulate_limb_fn = void (*)(const std::uint64_t *x, const std::uint64_t *y, std::uint64_t *acc,
+                                            std::size_t coeff_count, std::uint64_t modulus,
+                                            const std::uint64_t *const_ratio);
+
+struct KernelTable {
+    KernelBackend backend;
+    multiply_accumulate_limb_fn multiply_accumulate_limb;
+};
+
+const CpuFeatures &cpu_features();
+
+// True when SEAL was built with SEAL_USE_INTEL_HEXL
+bool hexl_compiled();
+
+// Backends the running CPU and this build can use, slowest first
+std::vector<KernelBackend> available_backends();
+
+// Chosen on first use: the fastest available backend, or the one named by
+// the SEAL_PYTHON_BACKEND environment variable (baseline, avx2, hexl or
+// auto). A request the CPU cannot run falls back to the fastest available
+// backend below it; any other value throws std::invalid_argument.
+const KernelTable &kernels();
+
+// SEAL_PYTHON_BACKEND as read at selection time, empty when unset
+const std::string &requested_backend();
+
+const char *backend_name(KernelBackend backend);
+
+// The kernels of one backend, for comparing backends side by side
+KernelTable kernel_table(KernelBackend backend);
+
+struct BackendTiming {
+    KernelBackend backend;
+    double seconds_per_call = 0;
+    // Digest of the result; equal across backends when they agree
+    std::uint64_t checksum = 0;
+};
+
+// Times multiply_accumulate at the first data level of context on every
+// available backend
+std::vector<BackendTiming> benchmark_backends(const seal::SEALContext &context, std::size_t iterations);
+
+// Entry points of the per-ISA builds (rns_kernels_baseline.cpp, rns_kernels_avx2.cpp)
+void multiply_accumulate_limb_baseline(const std::uint64_t *x, const std::uint64_t *y, std::uint64_t *acc,
+                                       std::size_t coeff_count, std::uint64_t modulus,
+                                       const std::uint64_t *const_ratio);
+void multiply_accumulate_limb_avx2(const std::uint64_t *x, const std::uint64_t *y, std::uint64_t *acc,
+                                   std::size_t coeff_count, std::uint64_t modulus, const std::uint64_t *const_ratio);
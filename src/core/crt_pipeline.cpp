@@ -0,0 +1,252 @@
+#include "crt_pipeline.h"
+#include <seal/memorymanager.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace seal;
+
+CRTPipeline::CRTPipeline(const EncryptionParameters &parms, const std::vector<Modulus> &plain_moduli,
+                         sec_level_type sec_level, std::size_t threads)
+    : plain_moduli_(plain_moduli), own_pool_(threads ? std::make_unique<ThreadPool>(threads) : nullptr) {
+    if (parms.scheme() != scheme_type::bfv && parms.scheme() != scheme_type::bgv) {
+        throw std::invalid_argument("CRTPipeline requires the BFV or BGV scheme");
+    }
+    if (plain_moduli_.empty()) throw std::invalid_argument("plain_moduli must not be empty");
+    for (std::size_t i = 0; i < plain_moduli_.size(); i++) {
+        for (std::size_t j = 0; j < i; j++) {
+            if (plain_moduli_[i] == plain_moduli_[j]) throw std::invalid_argument("plain moduli must be distinct");
+        }
+    }
+    base_ = std::make_unique<util::RNSBase>(plain_moduli_, MemoryManager::GetPool());
+    slots_ = parms.poly_modulus_degree();
+
+    // Context creation builds the NTT tables of every prime, so shards are
+    // set up concurrently
+    shards_.resize(plain_moduli_.size());
+    for_each_shard([&](std::size_t i) {
+        auto shard_parms = parms;
+        shard_parms.set_plain_modulus(plain_moduli_[i]);
+        auto &shard = shards_[i];
+        shard.context = std::make_shared<SEALContext>(shard_parms, true, sec_level);
+        if (!shard.context->parameters_set()) {
+            throw std::invalid_argument(shard.context->parameter_error_message());
+        }
+        if (!shard.context->first_context_data()->qualifiers().using_batching) {
+            throw std::invalid_argument("plain modulus " + std::to_string(plain_moduli_[i].value()) +
+                                        " does not support batching");
+        }
+        shard.evaluator = std::make_unique<Evaluator>(*shard.context);
+        shard.encoder = std::make_unique<BatchEncoder>(*shard.context);
+    });
+}
+
+std::vector<std::uint64_t> CRTPipeline::plain_modulus_product() const {
+    return std::vector<std::uint64_t>(base_->base_prod(), base_->base_prod() + base_->size());
+}
+
+void CRTPipeline::generate_keys(bool relin_keys, const std::vector<int> &galois_steps) {
+    for_each_shard([&](std::size_t i) {
+        auto &shard = shards_[i];
+        shard.keygen = std::make_unique<KeyGenerator>(*shard.context);
+        PublicKey public_key;
+        shard.keygen->create_public_key(public_key);
+        shard.encryptor = std::make_unique<Encryptor>(*shard.context, public_key);
+        shard.decryptor = std::make_unique<Decryptor>(*shard.context, shard.keygen->secret_key());
+        shard.has_relin_keys = relin_keys;
+        if (relin_keys) shard.keygen->create_relin_keys(shard.relin_keys);
+        shard.has_galois_keys = !galois_steps.empty();
+        if (shard.has_galois_keys) shard.keygen->create_galois_keys(galois_steps, shard.galois_keys);
+    });
+    has_keys_ = true;
+}
+
+const CRTPipeline::Shard &CRTPipeline::keyed_shard(std::size_t index) const {
+    if (!has_keys_) throw std::logic_error("keys have not been generated");
+    return shards_[index];
+}
+
+void CRTPipeline::check_shards(std::size_t count) const {
+    if (count != shards_.size()) {
+        throw std::invalid_argument("expected " + std::to_string(shards_.size()) + " shards, got " +
+                                    std::to_string(count));
+    }
+}
+
+CRTPlaintext CRTPipeline::encode(const std::vector<std::uint64_t> &values) const {
+    std::size_t words = word_count();
+    if (values.size() % words) throw std::invalid_argument("values must hold word_count() limbs per integer");
+    std::size_t count = values.size() / words;
+    if (count > slots_) throw std::invalid_argument("too many values for the slot count");
+
+    // residues[i * slots + j] is value j modulo prime i
+    std::vector<std::uint64_t> residues(shards_.size() * slots_, 0);
+    pool().parallel_for(count, [&](std::size_t begin, std::size_t end) {
+        auto memory = MemoryManager::GetPool();
+        std::vector<std::uint64_t> value(words);
+        for (std::size_t j = begin; j < end; j++) {
+            std::copy_n(values.begin() + static_cast<std::ptrdiff_t>(j * words), words, value.begin());
+            base_->decompose(value.data(), memory);
+            for (std::size_t i = 0; i < words; i++) residues[i * slots_ + j] = value[i];
+        }
+    }, 256);
+
+    CRTPlaintext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        auto first = residues.begin() + static_cast<std::ptrdiff_t>(i * slots_);
+        shards_[i].encoder->encode(std::vector<std::uint64_t>(first, first + static_cast<std::ptrdiff_t>(slots_)),
+                                   result.shards[i]);
+    });
+    return result;
+}
+
+std::vector<std::uint64_t> CRTPipeline::decode(const CRTPlaintext &plain) const {
+    check_shards(plain.shards.size());
+    std::vector<std::vector<std::uint64_t>> residues(shards_.size());
+    for_each_shard([&](std::size_t i) { shards_[i].encoder->decode(plain.shards[i], residues[i]); });
+
+    std::size_t words = word_count();
+    std::vector<std::uint64_t> result(slots_ * words);
+    pool().parallel_for(slots_, [&](std::size_t begin, std::size_t end) {
+        auto memory = MemoryManager::GetPool();
+        for (std::size_t j = begin; j < end; j++) {
+            auto value = result.data() + j * words;
+            for (std::size_t i = 0; i < words; i++) value[i] = residues[i][j];
+            base_->compose(value, memory);
+        }
+    }, 256);
+    return result;
+}
+
+CRTCiphertext CRTPipeline::encrypt(const CRTPlaintext &plain) const {
+    check_shards(plain.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) { keyed_shard(i).encryptor->encrypt(plain.shards[i], result.shards[i]); });
+    return result;
+}
+
+CRTPlaintext CRTPipeline::decrypt(const CRTCiphertext &encrypted) const {
+    check_shards(encrypted.shards.size());
+    CRTPlaintext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) { keyed_shard(i).decryptor->decrypt(encrypted.shards[i], result.shards[i]); });
+    return result;
+}
+
+int CRTPipeline::invariant_noise_budget(const CRTCiphertext &encrypted) const {
+    check_shards(encrypted.shards.size());
+    std::vector<int> budgets(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        budgets[i] = keyed_shard(i).decryptor->invariant_noise_budget(encrypted.shards[i]);
+    });
+    return *std::min_element(budgets.begin(), budgets.end());
+}
+
+CRTCiphertext CRTPipeline::add(const CRTCiphertext &a, const CRTCiphertext &b) const {
+    check_shards(a.shards.size());
+    check_shards(b.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) { shards_[i].evaluator->add(a.shards[i], b.shards[i], result.shards[i]); });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::sub(const CRTCiphertext &a, const CRTCiphertext &b) const {
+    check_shards(a.shards.size());
+    check_shards(b.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) { shards_[i].evaluator->sub(a.shards[i], b.shards[i], result.shards[i]); });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::negate(const CRTCiphertext &encrypted) const {
+    check_shards(encrypted.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) { shards_[i].evaluator->negate(encrypted.shards[i], result.shards[i]); });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::multiply(const CRTCiphertext &a, const CRTCiphertext &b) const {
+    check_shards(a.shards.size());
+    check_shards(b.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        auto &shard = shards_[i];
+        shard.evaluator->multiply(a.shards[i], b.shards[i], result.shards[i]);
+        if (shard.has_relin_keys) shard.evaluator->relinearize_inplace(result.shards[i], shard.relin_keys);
+    });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::square(const CRTCiphertext &encrypted) const {
+    check_shards(encrypted.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        auto &shard = shards_[i];
+        shard.evaluator->square(encrypted.shards[i], result.shards[i]);
+        if (shard.has_relin_keys) shard.evaluator->relinearize_inplace(result.shards[i], shard.relin_keys);
+    });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::add_plain(const CRTCiphertext &encrypted, const CRTPlaintext &plain) const {
+    check_shards(encrypted.shards.size());
+    check_shards(plain.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        shards_[i].evaluator->add_plain(encrypted.shards[i], plain.shards[i], result.shards[i]);
+    });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::multiply_plain(const CRTCiphertext &encrypted, const CRTPlaintext &plain) const {
+    check_shards(encrypted.shards.size());
+    check_shards(plain.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        shards_[i].evaluator->multiply_plain(encrypted.shards[i], plain.shards[i], result.shards[i]);
+    });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::rotate_rows(const CRTCiphertext &encrypted, int steps) const {
+    check_shards(encrypted.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        auto &shard = keyed_shard(i);
+        if (!shard.has_galois_keys) throw std::logic_error("Galois keys have not been generated");
+        shard.evaluator->rotate_rows(encrypted.shards[i], steps, shard.galois_keys, result.shards[i]);
+    });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::rotate_columns(const CRTCiphertext &encrypted) const {
+    check_shards(encrypted.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        auto &shard = keyed_shard(i);
+        if (!shard.has_galois_keys) throw std::logic_error("Galois keys have not been generated");
+        shard.evaluator->rotate_columns(encrypted.shards[i], shard.galois_keys, result.shards[i]);
+    });
+    return result;
+}
+
+CRTCiphertext CRTPipeline::mod_switch_to_next(const CRTCiphertext &encrypted) const {
+    check_shards(encrypted.shards.size());
+    CRTCiphertext result;
+    result.shards.resize(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        shards_[i].evaluator->mod_switch_to_next(encrypted.shards[i], result.shards[i]);
+    });
+    return result;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include "thread_pool.h"
+#include <seal/batchencoder.h>
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/decryptor.h>
+#include <seal/encryptionparams.h>
+#include <seal/encryptor.h>
+#include <seal/evaluator.h>
+#include <seal/galoiskeys.h>
+#include <seal/keygenerator.h>
+#include <seal/plaintext.h>
+#include <seal/relinkeys.h>
+#include <seal/util/rns.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// One value per shard: the residues of a batch of integers modulo each plain
+// prime, or their encryptions
+struct CRTPlaintext {
+    std::vector<seal::Plaintext> shards;
+};
+
+struct CRTCiphertext {
+    std::vector<seal::Ciphertext> shards;
+};
+
+// BFV/BGV over the product P of several batching primes. Every prime gets its
+// own SEALContext (same N and coefficient modulus) and key set; a batch of
+// integers modulo P is split by CRT into one batch per prime, every operation
+// runs on all shards concurrently, and decode recombines the residues. Results
+// are exact modulo P, so a P of k 60-bit primes gives the integer range of a
+// single k * 60-bit plain modulus while each shard keeps the noise growth of
+// its own prime.
+//
+// Integers cross the API as little-endian 64-bit limbs, word_count() limbs per
+// value and values back to back, reduced modulo P.
+class CRTPipeline {
+public:
+    // parms supplies the scheme, N and coefficient modulus; its plain modulus
+    // is replaced by each of plain_moduli, which must be distinct batching
+    // primes. threads == 0 shares the process-wide pool.
+    CRTPipeline(const seal::EncryptionParameters &parms, const std::vector<seal::Modulus> &plain_moduli,
+                seal::sec_level_type sec_level = seal::sec_level_type::tc128, std::size_t threads = 0);
+
+    std::size_t shard_count() const noexcept { return shards_.size(); }
+    std::size_t word_count() const noexcept { return shards_.size(); }
+    std::size_t slot_count() const noexcept { return slots_; }
+    const std::vector<seal::Modulus> &plain_moduli() const noexcept { return plain_moduli_; }
+    const std::shared_ptr<seal::SEALContext> &context(std::size_t shard) const { return shards_.at(shard).context; }
+
+    // P as word_count() limbs
+    std::vector<std::uint64_t> plain_modulus_product() const;
+
+    // Generates a secret, public and (optionally) relinearization key per
+    // shard, with Galois keys for galois_steps when it is not empty (step 0
+    // is the column swap)
+    void generate_keys(bool relin_keys = true, const std::vector<int> &galois_steps = {});
+    bool has_keys() const noexcept { return has_keys_; }
+
+    // At most slot_count() values; missing slots are zero
+    CRTPlaintext encode(const std::vector<std::uint64_t> &values) const;
+    std::vector<std::uint64_t> decode(const CRTPlaintext &plain) const;
+
+    CRTCiphertext encrypt(const CRTPlaintext &plain) const;
+    CRTPlaintext decrypt(const CRTCiphertext &encrypted) const;
+
+    // BFV: smallest remaining noise budget over the shards
+    int invariant_noise_budget(const CRTCiphertext &encrypted) const;
+
+    CRTCiphertext add(const CRTCiphertext &a, const CRTCiphertext &b) const;
+    CRTCiphertext sub(const CRTCiphertext &a, const CRTCiphertext &b) const;
+    CRTCiphertext negate(const CRTCiphertext &encrypted) const;
+
+    // Relinearizes the product when relinearization keys were generated
+    CRTCiphertext multiply(const CRTCiphertext &a, const CRTCiphertext &b) const;
+    CRTCiphertext square(const CRTCiphertext &encrypted) const;
+
+    CRTCiphertext add_plain(const CRTCiphertext &encrypted, const CRTPlaintext &plain) const;
+    CRTCiphertext multiply_plain(const CRTCiphertext &encrypted, const CRTPlaintext &plain) const;
+    CRTCiphertext rotate_rows(const CRTCiphertext &encrypted, int steps) const;
+    CRTCiphertext rotate_columns(const CRTCiphertext &encrypted) const;
+    CRTCiphertext mod_switch_to_next(const CRTCiphertext &encrypted) const;
+
+private:
+    struct Shard {
+        std::shared_ptr<seal::SEALContext> context;
+        std::unique_ptr<seal::Evaluator> evaluator;
+        std::unique_ptr<seal::BatchEncoder> encoder;
+        std::unique_ptr<seal::KeyGenerator> keygen;
+        std::unique_ptr<seal::Encryptor> encryptor;
+        std::unique_ptr<seal::Decryptor> decryptor;
+        seal::RelinKeys relin_keys;
+        seal::GaloisKeys galois_keys;
+        bool has_relin_keys = false;
+        bool has_galois_keys = false;
+    };
+
+    ThreadPool &pool() const noexcept { return own_pool_ ? *own_pool_ : ThreadPool::Global(); }
+    const Shard &keyed_shard(std::size_t index) const;
+    void check_shards(std::size_t count) const;
+
+    // Runs fn(shard index) for every shard in parallel
+    template <class F>
+    void for_each_shard(F &&fn) const {
+        pool().parallel_for(shards_.size(), [&fn](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) fn(i);
+        });
+    }
+
+    std::vector<seal::Modulus> plain_moduli_;
+    std::unique_ptr<seal::util::RNSBase> base_;
+    std::vector<Shard> shards_;
+    std::size_t slots_ = 0;
+    bool has_keys_ = false;
+    std::unique_ptr<ThreadPool> own_pool_;
+};
@@ -0,0 +1,236 @@
+#include "group_by.h"
+#include <seal/batchencoder.h>
+#include <seal/ckks.h>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace seal;
+
+AggregateKind parse_aggregate(const std::string &name) {
+    static const std::unordered_map<std::string, AggregateKind> kinds = {
+        { "sum", AggregateKind::sum }, { "count", AggregateKind::count }, { "mean", AggregateKind::mean }
+    };
+    auto it = kinds.find(name);
+    if (it == kinds.end()) throw std::invalid_argument("unknown aggregate: " + name);
+    return it->second;
+}
+
+GroupByAggregator::GroupByAggregator(std::shared_ptr<SEALContext> context, const std::vector<std::int64_t> &groups,
+                                     parms_id_type parms_id, std::size_t threads)
+    : context_(std::move(context)), batch_(context_, threads),
+      parms_id_(parms_id == parms_id_zero ? context_->first_parms_id() : parms_id) {
+    auto context_data = context_->get_context_data(parms_id_);
+    if (!context_data) throw std::invalid_argument("parms_id is not valid for the context");
+    auto &parms = context_data->parms();
+    ckks_ = parms.scheme() == scheme_type::ckks;
+    std::size_t degree = parms.poly_modulus_degree();
+    if (ckks_) {
+        if (context_data->chain_index() < 2) throw std::invalid_argument("CKKS aggregation needs two levels");
+        slots_ = row_size_ = degree / 2;
+    } else {
+        if (!context_data->qualifiers().using_batching) {
+            throw std::invalid_argument("the plain modulus does not support batching");
+        }
+        slots_ = degree;
+        row_size_ = degree / 2;
+    }
+
+    std::int64_t top = -1;
+    for (auto group : groups) top = std::max(top, group);
+    if (top < 0) throw std::invalid_argument("groups must assign at least one row");
+    auto group_count = static_cast<std::size_t>(top) + 1;
+    if (group_count > row_size_) throw std::invalid_argument("more groups than slots in a row");
+    block_ = 1;
+    while (block_ < group_count) block_ *= 2;
+    counts_.assign(group_count, 0);
+    ciphertexts_ = (groups.size() + slots_ - 1) / slots_;
+    masks_.resize(ciphertexts_ * group_count);
+    present_.assign(masks_.size(), 0);
+    for (std::size_t r = 0; r < groups.size(); r++) {
+        if (groups[r] < 0) continue;
+        auto g = static_cast<std::size_t>(groups[r]);
+        counts_[g]++;
+        present_[(r / slots_) * group_count + g] = 1;
+    }
+
+    // Group masks at parms_id; placement masks one level lower for CKKS,
+    // where both are encoded at the prime the following rescale removes
+    std::unique_ptr<CKKSEncoder> ckks_encoder;
+    std::unique_ptr<BatchEncoder> batch_encoder;
+    if (ckks_) {
+        ckks_encoder = std::make_unique<CKKSEncoder>(*context_);
+    } else {
+        batch_encoder = std::make_unique<BatchEncoder>(*context_);
+    }
+    auto encode = [&](const std::vector<double> &values, const SEALContext::ContextData &level, Plaintext &plain) {
+        if (ckks_) {
+            auto scale = static_cast<double>(level.parms().coeff_modulus().back().value());
+            ckks_encoder->encode(values, level.parms_id(), scale, plain);
+        } else {
+            std::vector<std::uint64_t> integers(values.begin(), values.end());
+            batch_encoder->encode(integers, plain);
+            batch_.evaluator().transform_to_ntt_inplace(plain, level.parms_id());
+        }
+    };
+
+    batch_.pool().parallel_for(masks_.size(), [&](std::size_t begin, std::size_t end) {
+        std::vector<double> values(slots_);
+        for (std::size_t index = begin; index < end; index++) {
+            if (!present_[index]) continue;
+            std::size_t t = index / group_count;
+            auto g = static_cast<std::int64_t>(index % group_count);
+            for (std::size_t s = 0; s < slots_; s++) {
+                std::size_t r = t * slots_ + s;
+                values[s] = r < groups.size() && groups[r] == g ? 1.0 : 0.0;
+            }
+            encode(values, *context_data, masks_[index]);
+        }
+    });
+
+    auto &place_level = ckks_ ? *context_data->next_context_data() : *context_data;
+    place_sum_.resize(group_count);
+    if (ckks_) place_mean_.resize(group_count);
+    batch_.pool().parallel_for(group_count, [&](std::size_t begin, std::size_t end) {
+        std::vector<double> values(slots_);
+        for (std::size_t g = begin; g < end; g++) {
+            for (std::size_t s = 0; s < slots_; s++) values[s] = s % block_ == g ? 1.0 : 0.0;
+            encode(values, place_level, place_sum_[g]);
+            if (!ckks_) continue;
+            double weight = counts_[g] ? 1.0 / static_cast<double>(counts_[g]) : 0.0;
+            for (auto &value : values) value *= weight;
+            encode(values, place_level, place_mean_[g]);
+        }
+    });
+}
+
+std::size_t GroupByAggregator::rotations() const noexcept {
+    std::size_t inner = 0, outer = 0;
+    for (std::size_t step = 1; step < block_; step *= 2) inner++;
+    for (std::size_t step = block_; step < row_size_; step *= 2) outer++;
+    return group_count() * inner + outer + (ckks_ ? 0 : 1);
+}
+
+std::vector<int> GroupByAggregator::galois_steps() const {
+    std::vector<int> steps;
+    if (!ckks_) steps.push_back(0);
+    for (std::size_t step = 1; step < row_size_; step *= 2) steps.push_back(static_cast<int>(step));
+    return steps;
+}
+
+void GroupByAggregator::rotate_add(Ciphertext &encrypted, int step, const GaloisKeys &galois_keys) const {
+    Ciphertext rotated;
+    if (ckks_) {
+        batch_.evaluator().rotate_vector(encrypted, step, galois_keys, rotated);
+    } else {
+        batch_.evaluator().rotate_rows(encrypted, step, galois_keys, rotated);
+    }
+    batch_.evaluator().add_inplace(encrypted, rotated);
+}
+
+std::vector<Ciphertext> GroupByAggregator::aggregate(const std::vector<std::vector<const Ciphertext *>> &columns,
+                                                     const std::vector<AggregateKind> &kinds,
+                                                     const GaloisKeys &galois_keys) const {
+    if (columns.size() != kinds.size()) throw std::invalid_argument("columns and kinds must have the same length");
+    if (columns.empty()) return {};
+    for (auto &column : columns) {
+        if (column.size() != ciphertexts_) {
+            throw std::invalid_argument("every column must hold " + std::to_string(ciphertexts_) + " ciphertexts");
+        }
+        for (auto encrypted : column) {
+            if (encrypted->parms_id() != parms_id_) {
+                throw std::invalid_argument("columns must be at the aggregator's parms_id");
+            }
+            if (encrypted->is_ntt_form() != columns[0][0]->is_ntt_form()) {
+                throw std::invalid_argument("all ciphertexts must have the same NTT form");
+            }
+            if (ckks_ && encrypted->scale() != column[0]->scale()) {
+                throw std::invalid_argument("all ciphertexts of a column must have the same scale");
+            }
+        }
+    }
+    for (auto kind : kinds) {
+        if (kind == AggregateKind::mean && !ckks_) throw std::invalid_argument("mean requires CKKS");
+    }
+
+    // Aggregates over the same column share its masked sums
+    std::vector<const std::vector<const Ciphertext *> *> unique;
+    std::vector<std::size_t> column_of(columns.size());
+    for (std::size_t a = 0; a < columns.size(); a++) {
+        auto it = std::find_if(unique.begin(), unique.end(), [&](auto *column) { return *column == columns[a]; });
+        column_of[a] = static_cast<std::size_t>(it - unique.begin());
+        if (it == unique.end()) unique.push_back(&columns[a]);
+    }
+
+    // BFV ciphertexts are taken to NTT form once, for every group's masks
+    auto &evaluator = batch_.evaluator();
+    bool to_ntt = !ckks_ && !columns[0][0]->is_ntt_form();
+    std::vector<Ciphertext> prepared(to_ntt ? unique.size() * ciphertexts_ : 0);
+    batch_.pool().parallel_for(prepared.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            evaluator.transform_to_ntt(*(*unique[i / ciphertexts_])[i % ciphertexts_], prepared[i]);
+        }
+    });
+    auto input = [&](std::size_t u, std::size_t t) -> const Ciphertext & {
+        return to_ntt ? prepared[u * ciphertexts_ + t] : *(*unique[u])[t];
+    };
+
+    // Masked sum of every (column, group), reduced inside blocks
+    std::size_t groups = group_count();
+    std::vector<Ciphertext> reduced(unique.size() * groups);
+    std::vector<char> filled(reduced.size(), 0);
+    batch_.pool().parallel_for(reduced.size(), [&](std::size_t begin, std::size_t end) {
+        Ciphertext term;
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t u = i / groups, g = i % groups;
+            auto &acc = reduced[i];
+            for (std::size_t t = 0; t < ciphertexts_; t++) {
+                if (!present_[t * groups + g]) continue;
+                auto &target = filled[i] ? term : acc;
+                evaluator.multiply_plain(input(u, t), masks_[t * groups + g], target);
+                if (filled[i]) evaluator.add_inplace(acc, term);
+                filled[i] = 1;
+            }
+            if (!filled[i]) continue;
+            if (ckks_) {
+                evaluator.rescale_to_next_inplace(acc);
+                acc.scale() = input(u, 0).scale();
+            }
+            if (to_ntt) evaluator.transform_from_ntt_inplace(acc);
+            for (std::size_t step = 1; step < block_; step *= 2) rotate_add(acc, static_cast<int>(step), galois_keys);
+            if (to_ntt) evaluator.transform_to_ntt_inplace(acc);
+        }
+    });
+
+    // Slot g of every block keeps group g; the shared steps sum the blocks
+    std::vector<Ciphertext> results(columns.size());
+    batch_.pool().parallel_for(columns.size(), [&](std::size_t begin, std::size_t end) {
+        Ciphertext term;
+        for (std::size_t a = begin; a < end; a++) {
+            auto &place = kinds[a] == AggregateKind::mean ? place_mean_ : place_sum_;
+            auto &result = results[a];
+            bool first = true;
+            for (std::size_t g = 0; g < groups; g++) {
+                std::size_t i = column_of[a] * groups + g;
+                if (!filled[i]) continue;
+                evaluator.multiply_plain(reduced[i], place[g], first ? result : term);
+                if (!first) evaluator.add_inplace(result, term);
+                first = false;
+            }
+            if (ckks_) {
+                evaluator.rescale_to_next_inplace(result);
+                result.scale() = columns[a][0]->scale();
+            }
+            if (to_ntt) evaluator.transform_from_ntt_inplace(result);
+            for (std::size_t step = block_; step < row_size_; step *= 2) {
+                rotate_add(result, static_cast<int>(step), galois_keys);
+            }
+            if (!ckks_) {
+                Ciphertext swapped;
+                evaluator.rotate_columns(result, galois_keys, swapped);
+                evaluator.add_inplace(result, swapped);
+            }
+        }
+    });
+    return results;
+}
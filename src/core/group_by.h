@@ -0,0 +1,80 @@
+#pragma once
+#include "batch_evaluator.h"
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/galoiskeys.h>
+#include <seal/plaintext.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class AggregateKind { sum, count, mean };
+
+AggregateKind parse_aggregate(const std::string &name);
+
+// SUM / COUNT / AVG grouped by a plaintext key over encrypted columns. A column
+// is a list of ciphertexts holding one row per slot, row r in slot r % slots of
+// ciphertext r / slots (for BFV/BGV, slots is the full batching width). Row r
+// belongs to group groups[r]; negative entries and rows past groups.size()
+// are left out.
+//
+// Each group's per-ciphertext masks are encoded once, in NTT form. An
+// aggregate multiplies every ciphertext by its masks and accumulates per
+// group, then reduces with rotations in two phases: log2(B) steps inside
+// blocks of B >= group_count() slots, and after a second mask keeping slot g
+// of every block for group g, log2(slots / B) steps shared by all groups.
+// Group g's result lands in slot g (and in every B-th slot after it), the
+// other slots are zero, and the cost is group_count() * log2(B) +
+// log2(slots / B) rotations per column instead of a full reduction per group.
+// All aggregates of one call share a single sweep, and aggregates over the
+// same column share its masked sums.
+//
+// sum and count (a sum over a 0/1 indicator column) are exact for BFV/BGV,
+// modulo the plain modulus. mean is CKKS only: the 1 / count weights are folded
+// into the second mask. CKKS consumes two levels and keeps the input scale.
+class GroupByAggregator {
+public:
+    // Columns are expected at parms_id (the first data level when zero);
+    // threads == 0 shares the process-wide pool
+    GroupByAggregator(std::shared_ptr<seal::SEALContext> context, const std::vector<std::int64_t> &groups,
+                      seal::parms_id_type parms_id = seal::parms_id_zero, std::size_t threads = 0);
+
+    std::size_t group_count() const noexcept { return counts_.size(); }
+    std::size_t ciphertext_count() const noexcept { return ciphertexts_; }
+    std::size_t slot_count() const noexcept { return slots_; }
+    const seal::parms_id_type &parms_id() const noexcept { return parms_id_; }
+
+    // Rows per group, known from the plaintext assignment
+    const std::vector<std::uint64_t> &counts() const noexcept { return counts_; }
+
+    // Rotations per distinct column, and the steps they need (BFV/BGV: 0 is
+    // the column swap)
+    std::size_t rotations() const noexcept;
+    std::vector<int> galois_steps() const;
+
+    // One packed ciphertext per entry of kinds; columns[i] is aggregated by
+    // kinds[i]. Every input must share one NTT form; CKKS columns may differ
+    // in scale but not within a column, and each result keeps its column's.
+    std::vector<seal::Ciphertext> aggregate(const std::vector<std::vector<const seal::Ciphertext *>> &columns,
+                                            const std::vector<AggregateKind> &kinds,
+                                            const seal::GaloisKeys &galois_keys) const;
+
+private:
+    void rotate_add(seal::Ciphertext &encrypted, int step, const seal::GaloisKeys &galois_keys) const;
+
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    seal::parms_id_type parms_id_;
+    bool ckks_;
+    std::size_t slots_, row_size_, block_;
+    std::size_t ciphertexts_;
+    std::vector<std::uint64_t> counts_;
+
+    // masks_[t * group_count() + g] selects group g's rows of ciphertext t
+    std::vector<seal::Plaintext> masks_;
+    std::vector<char> present_;
+
+    // Slot g of every block, weighted 1 and (CKKS) 1 / count
+    std::vector<seal::Plaintext> place_sum_, place_mean_;
+};
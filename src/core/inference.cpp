@@ -0,0 +1,482 @@
+#include "inference.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace seal;
+
+namespace {
+    constexpr char model_magic[8] = { 'S', 'E', 'A', 'L', 'N', 'N', '0', '1' };
+
+    struct FileHeader {
+        char magic[8];
+        std::uint64_t channels;
+        std::uint64_t height;
+        std::uint64_t width;
+        std::uint64_t layers;
+    };
+
+    struct LayerRecord {
+        std::uint64_t kind;
+        std::uint64_t units;
+        std::uint64_t kernel;
+        std::uint64_t weights;
+        std::uint64_t bias;
+    };
+
+    static_assert(sizeof(FileHeader) == 40 && sizeof(LayerRecord) == 40, "unexpected padding in file layout");
+
+    std::size_t padded(std::size_t size) {
+        return (size + 7) & ~std::size_t(7);
+    }
+
+    std::vector<float> to_float(const std::vector<double> &values) {
+        return { values.begin(), values.end() };
+    }
+
+    std::vector<double> to_double(const std::vector<float> &values) {
+        return { values.begin(), values.end() };
+    }
+
+    std::size_t ceil_log2(std::size_t value) {
+        std::size_t bits = 0;
+        while ((std::size_t(1) << bits) < value) bits++;
+        return bits;
+    }
+
+    std::size_t poly_levels(std::size_t degree) {
+        return ceil_log2(degree) + 1;
+    }
+}
+
+const char *layer_kind_name(LayerKind kind) {
+    switch (kind) {
+    case LayerKind::dense:
+        return "dense";
+    case LayerKind::conv:
+        return "conv";
+    case LayerKind::avg_pool:
+        return "avg_pool";
+    case LayerKind::poly:
+        return "poly";
+    }
+    return "unknown";
+}
+
+NNModel::NNModel(std::size_t channels, std::size_t height, std::size_t width) : input_{ channels, height, width } {
+    if (!channels || !height || !width) throw std::invalid_argument("dimensions must be positive");
+}
+
+void NNModel::push(Layer layer) {
+    layers_.push_back(std::move(layer));
+}
+
+void NNModel::add_dense(std::size_t units, const std::vector<double> &weights, const std::vector<double> &bias) {
+    std::size_t inputs = output_shape().size();
+    if (!units) throw std::invalid_argument("units must be positive");
+    if (weights.size() != units * inputs) throw std::invalid_argument("weights have the wrong size");
+    if (!bias.empty() && bias.size() != units) throw std::invalid_argument("bias has the wrong size");
+    push({ LayerKind::dense, units, 0, to_float(weights), to_float(bias), { units, 1, 1 } });
+}
+
+void NNModel::add_conv(std::size_t out_channels, std::size_t kernel_size, const std::vector<double> &weights,
+                       const std::vector<double> &bias) {
+    auto shape = output_shape();
+    if (!out_channels) throw std::invalid_argument("out_channels must be positive");
+    if (kernel_size % 2 == 0) throw std::invalid_argument("kernel_size must be odd");
+    if (weights.size() != out_channels * shape.channels * kernel_size * kernel_size) {
+        throw std::invalid_argument("weights have the wrong size");
+    }
+    if (!bias.empty() && bias.size() != out_channels) throw std::invalid_argument("bias has the wrong size");
+    push({ LayerKind::conv, out_channels, kernel_size, to_float(weights), to_float(bias),
+           { out_channels, shape.height, shape.width } });
+}
+
+void NNModel::add_avg_pool(std::size_t window) {
+    auto shape = output_shape();
+    if (!window) throw std::invalid_argument("window must be positive");
+    if (shape.height % window || shape.width % window) {
+        throw std::invalid_argument("window must divide the height and width");
+    }
+    push({ LayerKind::avg_pool, 0, window, {}, {}, { shape.channels, shape.height / window, shape.width / window } });
+}
+
+void NNModel::add_poly(const std::vector<double> &coeffs) {
+    auto weights = to_float(coeffs);
+    while (!weights.empty() && weights.back() == 0.0f) weights.pop_back();
+    if (weights.size() < 2) throw std::invalid_argument("poly must have degree at least 1");
+    push({ LayerKind::poly, 0, 0, std::move(weights), {}, output_shape() });
+}
+
+void NNModel::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) throw std::runtime_error("Cannot open file: " + path);
+    FileHeader header;
+    std::memcpy(header.magic, model_magic, sizeof(model_magic));
+    header.channels = input_.channels;
+    header.height = input_.height;
+    header.width = input_.width;
+    header.layers = layers_.size();
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    const char zeros[8] = {};
+    for (auto &layer : layers_) {
+        LayerRecord record{ static_cast<std::uint64_t>(layer.kind), layer.units, layer.kernel, layer.weights.size(),
+                            layer.bias.size() };
+        out.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        std::size_t bytes = (layer.weights.size() + layer.bias.size()) * sizeof(float);
+        out.write(reinterpret_cast<const char *>(layer.weights.data()),
+                  static_cast<std::streamsize>(layer.weights.size() * sizeof(float)));
+        out.write(reinterpret_cast<const char *>(layer.bias.data()),
+                  static_cast<std::streamsize>(layer.bias.size() * sizeof(float)));
+        out.write(zeros, static_cast<std::streamsize>(padded(bytes) - bytes));
+    }
+    if (!out) throw std::runtime_error("failed to write " + path);
+}
+
+NNModel NNModel::load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) throw std::runtime_error("Cannot open file: " + path);
+    auto remaining = static_cast<std::size_t>(in.tellg());
+    in.seekg(0);
+
+    FileHeader header;
+    if (remaining < sizeof(header)) throw std::runtime_error(path + " is not a model file");
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, model_magic, sizeof(model_magic)) != 0) {
+        throw std::runtime_error(path + " is not a model file");
+    }
+    remaining -= sizeof(header);
+    NNModel model(header.channels, header.height, header.width);
+
+    // Sizes are checked against the file before anything is allocated; the
+    // add_* checks then validate the layer itself
+    for (std::uint64_t i = 0; i < header.layers; i++) {
+        LayerRecord record;
+        if (remaining < sizeof(record)) throw std::runtime_error(path + " is truncated");
+        in.read(reinterpret_cast<char *>(&record), sizeof(record));
+        remaining -= sizeof(record);
+        if (record.weights > remaining / sizeof(float) || record.bias > remaining / sizeof(float) ||
+            padded((record.weights + record.bias) * sizeof(float)) > remaining) {
+            throw std::runtime_error(path + " is truncated");
+        }
+        std::vector<float> weights(record.weights), bias(record.bias);
+        in.read(reinterpret_cast<char *>(weights.data()), static_cast<std::streamsize>(weights.size() * sizeof(float)));
+        in.read(reinterpret_cast<char *>(bias.data()), static_cast<std::streamsize>(bias.size() * sizeof(float)));
+        std::size_t bytes = (weights.size() + bias.size()) * sizeof(float);
+        in.seekg(static_cast<std::streamoff>(padded(bytes) - bytes), std::ios::cur);
+        remaining -= padded(bytes);
+        if (!in) throw std::runtime_error(path + " is truncated");
+
+        switch (static_cast<LayerKind>(record.kind)) {
+        case LayerKind::dense:
+            model.add_dense(record.units, to_double(weights), to_double(bias));
+            break;
+        case LayerKind::conv:
+            model.add_conv(record.units, record.kernel, to_double(weights), to_double(bias));
+            break;
+        case LayerKind::avg_pool:
+            model.add_avg_pool(record.kernel);
+            break;
+        case LayerKind::poly:
+            model.add_poly(to_double(weights));
+            break;
+        default:
+            throw std::runtime_error(path + " has an unknown layer kind " + std::to_string(record.kind));
+        }
+    }
+    return model;
+}
+
+EncryptedInference::EncryptedInference(std::shared_ptr<SEALContext> context, const NNModel &model, double scale,
+                                       parms_id_type parms_id, std::size_t threads)
+    : context_(std::move(context)), batch_(context_, threads), encoder_(*context_), slots_(encoder_.slot_count()),
+      input_shape_(model.input_shape()), output_shape_(model.output_shape()) {
+    if (parms_id == parms_id_zero) parms_id = context_->first_parms_id();
+    auto context_data = context_->get_context_data(parms_id);
+    if (!context_data) throw std::invalid_argument("parms_id is not valid for the context");
+    if (context_data->parms().scheme() != scheme_type::ckks) {
+        throw std::invalid_argument("EncryptedInference requires CKKS");
+    }
+    if (!(scale > 0)) throw std::invalid_argument("scale must be positive");
+    if (input_shape_.size() > slots_) throw std::invalid_argument("input does not fit in the slots");
+
+    input_level_ = context_data->chain_index();
+    level_parms_.resize(input_level_ + 1);
+    primes_.resize(input_level_ + 1);
+    for (auto data = context_data; data; data = data->next_context_data()) {
+        level_parms_[data->chain_index()] = data->parms_id();
+    }
+    auto &coeff_modulus = context_data->parms().coeff_modulus();
+    for (std::size_t level = 0; level <= input_level_; level++) {
+        primes_[level] = static_cast<double>(coeff_modulus[level].value());
+    }
+
+    // Plan levels first so an oversized model fails before any encoding
+    std::size_t depth = 0;
+    for (auto &spec : model.layers()) {
+        if (spec.output.size() > slots_) throw std::invalid_argument("a layer output does not fit in the slots");
+        depth += spec.kind == LayerKind::poly ? poly_levels(spec.weights.size() - 1) : 1;
+    }
+    if (depth > input_level_) {
+        throw std::invalid_argument("the model needs " + std::to_string(depth) + " levels but parms_id has " +
+                                    std::to_string(input_level_));
+    }
+    output_level_ = input_level_ - depth;
+
+    scales_.assign(input_level_ + 1, 0.0);
+    scales_[input_level_] = scale;
+    for (std::size_t level = input_level_; level > output_level_; level--) {
+        scales_[level - 1] = scales_[level] * scales_[level] / primes_[level];
+        if (!(scales_[level - 1] >= 1) || !std::isfinite(scales_[level - 1])) {
+            throw std::invalid_argument("scale drifts out of range over the model's levels; choose a scale close "
+                                        "to the primes");
+        }
+    }
+
+    std::size_t level = input_level_;
+    TensorShape shape = input_shape_;
+    for (std::size_t i = 0; i < model.layers().size(); i++) {
+        auto &spec = model.layers()[i];
+        Layer layer;
+        layer.info.kind = spec.kind;
+        layer.info.output = spec.output;
+        layer.info.input_level = level;
+        if (spec.kind == LayerKind::poly) {
+            layer.coeffs = to_double(spec.weights);
+            layer.info.degree = layer.coeffs.size() - 1;
+            layer.info.output_level = level - poly_levels(layer.info.degree);
+
+            // Terms that would round to zero at their scale are dropped
+            bool any = false;
+            for (std::size_t k = 1; k < layer.coeffs.size(); k++) {
+                std::size_t from = level - ceil_log2(k), to = layer.info.output_level;
+                if (std::fabs(layer.coeffs[k] * scales_[to] * primes_[to + 1] / scales_[from]) < 0.5) {
+                    layer.coeffs[k] = 0;
+                }
+                any = any || layer.coeffs[k] != 0;
+            }
+            if (!any) throw std::invalid_argument("poly layer " + std::to_string(i) + " vanishes at this scale");
+        } else {
+            layer.info.output_level = level - 1;
+            build_linear(layer, spec, shape);
+            if (layer.info.plaintexts == 0) {
+                throw std::invalid_argument("layer " + std::to_string(i) + " has only zero weights");
+            }
+        }
+        level = layer.info.output_level;
+        shape = spec.output;
+        layers_.push_back(std::move(layer));
+    }
+    stats_.resize(layers_.size());
+}
+
+void EncryptedInference::build_linear(Layer &layer, const NNModel::Layer &spec, const TensorShape &input) {
+    // y[out] += w * x[in] is diagonal in - out of the slot matrix at row out
+    DiagonalMaps<double> maps(1, std::vector<DiagonalSet<double>>(1));
+    auto &diagonals = maps[0][0];
+    std::vector<double> bias(slots_, 0.0);
+    auto add = [&](std::size_t out, std::size_t in, double weight) {
+        if (weight == 0.0) return;
+        auto &diagonal = diagonals[signed_step(static_cast<long long>(in) - static_cast<long long>(out), slots_)];
+        if (diagonal.empty()) diagonal.assign(slots_, 0.0);
+        diagonal[out] += weight;
+    };
+
+    std::size_t plane = input.height * input.width;
+    switch (spec.kind) {
+    case LayerKind::dense: {
+        std::size_t inputs = input.size();
+        for (std::size_t o = 0; o < spec.units; o++) {
+            for (std::size_t i = 0; i < inputs; i++) add(o, i, spec.weights[o * inputs + i]);
+            if (!spec.bias.empty()) bias[o] = spec.bias[o];
+        }
+        break;
+    }
+    case LayerKind::conv: {
+        std::size_t taps = spec.kernel * spec.kernel;
+        auto half = static_cast<std::ptrdiff_t>(spec.kernel / 2);
+        auto height = static_cast<std::ptrdiff_t>(input.height), width = static_cast<std::ptrdiff_t>(input.width);
+        for (std::size_t o = 0; o < spec.units; o++) {
+            for (std::size_t c = 0; c < input.channels; c++) {
+                for (std::size_t t = 0; t < taps; t++) {
+                    double w = spec.weights[(o * input.channels + c) * taps + t];
+                    auto dy = static_cast<std::ptrdiff_t>(t / spec.kernel) - half;
+                    auto dx = static_cast<std::ptrdiff_t>(t % spec.kernel) - half;
+                    for (std::ptrdiff_t y = 0; y < height; y++) {
+                        if (y + dy < 0 || y + dy >= height) continue;
+                        for (std::ptrdiff_t x = 0; x < width; x++) {
+                            if (x + dx < 0 || x + dx >= width) continue;
+                            add(o * plane + static_cast<std::size_t>(y * width + x),
+                                c * plane + static_cast<std::size_t>((y + dy) * width + x + dx), w);
+                        }
+                    }
+                }
+            }
+            if (!spec.bias.empty()) {
+                std::fill_n(bias.begin() + static_cast<std::ptrdiff_t>(o * plane), plane, spec.bias[o]);
+            }
+        }
+        break;
+    }
+    case LayerKind::avg_pool: {
+        std::size_t window = spec.kernel, height = spec.output.height, width = spec.output.width;
+        double weight = 1.0 / static_cast<double>(window * window);
+        for (std::size_t c = 0; c < input.channels; c++) {
+            for (std::size_t y = 0; y < height; y++) {
+                for (std::size_t x = 0; x < width; x++) {
+                    for (std::size_t dy = 0; dy < window; dy++) {
+                        for (std::size_t dx = 0; dx < window; dx++) {
+                            add((c * height + y) * width + x,
+                                c * plane + (y * window + dy) * input.width + x * window + dx, weight);
+                        }
+                    }
+                }
+            }
+        }
+        break;
+    }
+    default:
+        throw std::logic_error("not a linear layer");
+    }
+    if (diagonals.empty()) return;
+
+    std::size_t level = layer.info.input_level;
+    double plain_scale = primes_[level] * scales_[level - 1] / scales_[level];
+    layer.transform = DiagonalTransform(maps, slots_, batch_, encoder_, level_parms_[level], plain_scale);
+    layer.info.plaintexts = layer.transform.plaintexts();
+    layer.info.rotations = layer.transform.rotations();
+
+    if (std::any_of(bias.begin(), bias.end(), [](double v) { return v != 0.0; })) {
+        encoder_.encode(bias, level_parms_[level - 1], scales_[level - 1], layer.bias);
+        layer.has_bias = true;
+    }
+}
+
+std::vector<int> EncryptedInference::galois_steps() const {
+    std::set<int> steps;
+    for (auto &layer : layers_) {
+        for (int step : layer.transform.steps()) steps.insert(step);
+    }
+    steps.erase(0);
+    return { steps.begin(), steps.end() };
+}
+
+Plaintext EncryptedInference::encode(const std::vector<double> &input) const {
+    if (input.size() != input_shape_.size()) throw std::invalid_argument("input has the wrong size");
+    std::vector<double> slots(slots_, 0.0);
+    std::copy(input.begin(), input.end(), slots.begin());
+    Plaintext plain;
+    encoder_.encode(slots, input_parms_id(), input_scale(), plain);
+    return plain;
+}
+
+std::vector<double> EncryptedInference::decode(const Plaintext &plain) const {
+    std::vector<double> values;
+    encoder_.decode(plain, values);
+    values.resize(output_shape_.size());
+    return values;
+}
+
+Ciphertext EncryptedInference::linear(const Layer &layer, const Ciphertext &encrypted,
+                                      const GaloisKeys &galois_keys) const {
+    Ciphertext result = layer.transform.apply(batch_, encrypted, galois_keys);
+    result.scale() = scales_[layer.info.output_level];
+    if (layer.has_bias) batch_.evaluator().add_plain_inplace(result, layer.bias);
+    return result;
+}
+
+Ciphertext EncryptedInference::poly(const Layer &layer, const Ciphertext &encrypted,
+                                    const RelinKeys &relin_keys) const {
+    auto &evaluator = batch_.evaluator();
+    std::size_t degree = layer.info.degree;
+    std::vector<Ciphertext> powers(degree + 1);
+    std::vector<std::size_t> levels(degree + 1);
+    powers[1] = encrypted;
+    levels[1] = layer.info.input_level;
+
+    // x^k = x^a * x^(k - a) sits ceil(log2 k) levels down
+    batch_.power_ladder(degree, [&](std::size_t k, std::size_t a) {
+        std::size_t b = k - a;
+        Ciphertext product = powers[a];
+        if (levels[b] == levels[a]) {
+            evaluator.multiply_inplace(product, powers[b]);
+        } else {
+            evaluator.multiply_inplace(product, batch_.align(powers[b], level_parms_[levels[a]], scales_[levels[a]]));
+        }
+        evaluator.relinearize_inplace(product, relin_keys);
+        evaluator.rescale_to_next_inplace(product);
+        levels[k] = levels[a] - 1;
+        product.scale() = scales_[levels[k]];
+        powers[k] = std::move(product);
+    });
+
+    std::size_t level = layer.info.output_level;
+    return batch_.linear_combination(powers, layer.coeffs, level_parms_[level], scales_[level]);
+}
+
+Ciphertext EncryptedInference::infer(const Ciphertext &encrypted, const RelinKeys &relin_keys,
+                                     const GaloisKeys &galois_keys) const {
+    if (encrypted.parms_id() != input_parms_id()) {
+        throw std::invalid_argument("encrypted is not at the model input level");
+    }
+    if (!encrypted.is_ntt_form() || encrypted.size() != 2) {
+        throw std::invalid_argument("encrypted must be a relinearized CKKS ciphertext");
+    }
+    if (std::fabs(encrypted.scale() / input_scale() - 1) > 1e-6) {
+        throw std::invalid_argument("encrypted scale does not match the model input scale");
+    }
+    Ciphertext value = encrypted;
+    value.scale() = input_scale();
+
+    std::vector<double> seconds(layers_.size());
+    for (std::size_t i = 0; i < layers_.size(); i++) {
+        auto start = std::chrono::steady_clock::now();
+        auto &layer = layers_[i];
+        value = layer.info.kind == LayerKind::poly ? poly(layer, value, relin_keys) : linear(layer, value, galois_keys);
+        seconds[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (std::size_t i = 0; i < layers_.size(); i++) {
+        stats_[i].calls++;
+        stats_[i].seconds += seconds[i];
+    }
+    return value;
+}
+
+std::vector<Ciphertext> EncryptedInference::infer_batch(const std::vector<Ciphertext> &encrypted,
+                                                        const RelinKeys &relin_keys,
+                                                        const GaloisKeys &galois_keys) const {
+    std::vector<Ciphertext> results(encrypted.size());
+    if (encrypted.size() >= batch_.threads()) {
+        // Layers called from a worker run their loops inline
+        batch_.pool().parallel_for(encrypted.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) results[i] = infer(encrypted[i], relin_keys, galois_keys);
+        });
+    } else {
+        for (std::size_t i = 0; i < encrypted.size(); i++) results[i] = infer(encrypted[i], relin_keys, galois_keys);
+    }
+    return results;
+}
+
+std::vector<EncryptedInference::LayerInfo> EncryptedInference::layers() const {
+    std::vector<LayerInfo> result;
+    for (auto &layer : layers_) result.push_back(layer.info);
+    return result;
+}
+
+std::vector<EncryptedInference::LayerStats> EncryptedInference::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+void EncryptedInference::reset_stats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    std::fill(stats_.begin(), stats_.end(), LayerStats());
+}
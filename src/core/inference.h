@@ -0,0 +1,172 @@
+#pragma once
+#include "batch_evaluator.h"
+#include "bsgs.h"
+#include <seal/ckks.h>
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/galoiskeys.h>
+#include <seal/plaintext.h>
+#include <seal/relinkeys.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class LayerKind : std::uint64_t { dense = 1, conv = 2, avg_pool = 3, poly = 4 };
+
+struct TensorShape {
+    std::size_t channels = 1, height = 1, width = 1;
+    std::size_t size() const noexcept { return channels * height * width; }
+};
+
+// A feed-forward model over a [C][H][W] tensor, flattened channel major
+// (index c * H * W + y * W + x) wherever a layer needs a vector.
+//
+// dense: units outputs, weights [units][inputs], output shape [units][1][1]
+// conv: stride-1 "same" convolution, odd kernel, weights [out][in][k][k]
+// avg_pool: non-overlapping window x window average; H and W must divide
+// poly: elementwise polynomial, coefficients from the constant term up
+//
+// Weights are kept as float32, in memory and in the file. The file is a
+// 40-byte header (magic "SEALNN01", C, H, W, layer count) followed per layer
+// by a 40-byte record (kind, units, kernel, weight count, bias count) and the
+// weights and bias, padded to 8 bytes; all integers are native 64-bit.
+class NNModel {
+public:
+    struct Layer {
+        LayerKind kind;
+        std::size_t units = 0;
+        std::size_t kernel = 0;
+        std::vector<float> weights;
+        std::vector<float> bias;
+        TensorShape output;
+    };
+
+    NNModel(std::size_t channels, std::size_t height, std::size_t width);
+
+    // Each add_* checks the weights against the current output shape and
+    // throws std::invalid_argument on a mismatch
+    void add_dense(std::size_t units, const std::vector<double> &weights, const std::vector<double> &bias = {});
+    void add_conv(std::size_t out_channels, std::size_t kernel_size, const std::vector<double> &weights,
+                  const std::vector<double> &bias = {});
+    void add_avg_pool(std::size_t window);
+    void add_poly(const std::vector<double> &coeffs);
+
+    const TensorShape &input_shape() const noexcept { return input_; }
+    const TensorShape &output_shape() const noexcept { return layers_.empty() ? input_ : layers_.back().output; }
+    const std::vector<Layer> &layers() const noexcept { return layers_; }
+
+    void save(const std::string &path) const;
+
+    // Throws std::runtime_error for a file that is not a model or is truncated
+    static NNModel load(const std::string &path);
+
+private:
+    void push(Layer layer);
+
+    TensorShape input_;
+    std::vector<Layer> layers_;
+};
+
+const char *layer_kind_name(LayerKind kind);
+
+// Runs an NNModel on CKKS ciphertexts holding one flattened input each.
+//
+// At construction every layer is given its levels: a linear layer (dense,
+// conv, avg_pool) takes one, a polynomial of degree d takes ceil(log2 d) + 1.
+// Linear layers become a DiagonalTransform of the slot vector, encoded at the
+// level the layer runs on with the scale chosen so the result lands exactly
+// on the next level's scale. Those scales follow S(l - 1) = S(l)^2 / q(l) from
+// the input scale, so products of ciphertexts on one level need no fixing;
+// pick the input scale close to the primes being consumed. Every layer
+// writes its output flattened from slot 0, so layers compose without
+// repacking, and slots past the output are ignored by the next layer.
+class EncryptedInference {
+public:
+    struct LayerInfo {
+        LayerKind kind;
+        TensorShape output;
+        std::size_t input_level = 0;
+        std::size_t output_level = 0;
+        // Key switches and plaintext multiplies per call (linear layers)
+        std::size_t rotations = 0;
+        std::size_t plaintexts = 0;
+        // Polynomial degree (poly layers)
+        std::size_t degree = 0;
+    };
+
+    struct LayerStats {
+        std::uint64_t calls = 0;
+        // Wall-clock seconds summed over calls
+        double seconds = 0;
+    };
+
+    // Inputs are expected at parms_id (the first data level when zero) with
+    // the given scale; threads == 0 shares the process-wide pool
+    EncryptedInference(std::shared_ptr<seal::SEALContext> context, const NNModel &model, double scale,
+                       seal::parms_id_type parms_id = seal::parms_id_zero, std::size_t threads = 0);
+
+    const TensorShape &input_shape() const noexcept { return input_shape_; }
+    const TensorShape &output_shape() const noexcept { return output_shape_; }
+    std::size_t input_level() const noexcept { return input_level_; }
+    std::size_t output_level() const noexcept { return output_level_; }
+    std::size_t depth() const noexcept { return input_level_ - output_level_; }
+    const seal::parms_id_type &input_parms_id() const { return level_parms_[input_level_]; }
+    const seal::parms_id_type &output_parms_id() const { return level_parms_[output_level_]; }
+    double input_scale() const { return scales_[input_level_]; }
+    double output_scale() const { return scales_[output_level_]; }
+
+    // Rotation steps of every linear layer
+    std::vector<int> galois_steps() const;
+
+    // Flattened input to a plaintext at the input level and scale, and the
+    // output values back from a decrypted result
+    seal::Plaintext encode(const std::vector<double> &input) const;
+    std::vector<double> decode(const seal::Plaintext &plain) const;
+
+    seal::Ciphertext infer(const seal::Ciphertext &encrypted, const seal::RelinKeys &relin_keys,
+                           const seal::GaloisKeys &galois_keys) const;
+
+    // With at least as many inputs as threads every input runs on its own
+    // worker; smaller batches run one after another with each layer parallel
+    std::vector<seal::Ciphertext> infer_batch(const std::vector<seal::Ciphertext> &encrypted,
+                                              const seal::RelinKeys &relin_keys,
+                                              const seal::GaloisKeys &galois_keys) const;
+
+    std::vector<LayerInfo> layers() const;
+    std::vector<LayerStats> stats() const;
+    void reset_stats();
+
+private:
+    struct Layer {
+        LayerInfo info;
+        DiagonalTransform transform;
+        seal::Plaintext bias;
+        bool has_bias = false;
+        std::vector<double> coeffs;
+    };
+
+    void build_linear(Layer &layer, const NNModel::Layer &spec, const TensorShape &input);
+    seal::Ciphertext linear(const Layer &layer, const seal::Ciphertext &encrypted,
+                            const seal::GaloisKeys &galois_keys) const;
+    seal::Ciphertext poly(const Layer &layer, const seal::Ciphertext &encrypted,
+                          const seal::RelinKeys &relin_keys) const;
+
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    seal::CKKSEncoder encoder_;
+    std::size_t slots_;
+    TensorShape input_shape_, output_shape_;
+    std::size_t input_level_ = 0, output_level_ = 0;
+
+    // Per chain index: parms_id, prime removed by rescaling and scale
+    std::vector<seal::parms_id_type> level_parms_;
+    std::vector<double> primes_;
+    std::vector<double> scales_;
+
+    std::vector<Layer> layers_;
+
+    mutable std::mutex stats_mutex_;
+    mutable std::vector<LayerStats> stats_;
+};
@@ -0,0 +1,25 @@
+#include "mapped_file.h"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("failed to open " + path);
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("failed to stat " + path);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    void *addr = size_ ? ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0) : nullptr;
+    ::close(fd);
+    if (addr == MAP_FAILED) throw std::runtime_error("failed to map " + path);
+    data_ = static_cast<const unsigned char *>(addr);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) ::munmap(const_cast<unsigned char *>(data_), size_);
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a file; the pages are shared with other
+// processes mapping the same file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const unsigned char *data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    const unsigned char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
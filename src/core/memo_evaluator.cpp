@@ -0,0 +1,172 @@
+#include "memo_evaluator.h"
+#include <stdexcept>
+#include <utility>
+
+using namespace seal;
+
+namespace {
+    std::size_t data_bytes(const Ciphertext &encrypted) {
+        return encrypted.dyn_array().size() * sizeof(ct_coeff_type);
+    }
+}
+
+MemoEvaluator::MemoEvaluator(std::shared_ptr<SEALContext> context, std::size_t capacity_bytes)
+    : context_(std::move(context)), evaluator_(*context_), capacity_bytes_(capacity_bytes) {}
+
+void MemoEvaluator::set_relin_keys(const RelinKeys *relin_keys) {
+    ContentHash id = relin_keys ? content_hash(*relin_keys) : ContentHash();
+    std::lock_guard<std::mutex> lock(mutex_);
+    relin_keys_ = relin_keys;
+    relin_id_ = id;
+}
+
+void MemoEvaluator::set_galois_keys(const GaloisKeys *galois_keys) {
+    ContentHash id = galois_keys ? content_hash(*galois_keys) : ContentHash();
+    std::lock_guard<std::mutex> lock(mutex_);
+    galois_keys_ = galois_keys;
+    galois_id_ = id;
+}
+
+const GaloisKeys &MemoEvaluator::galois_keys() const {
+    if (!galois_keys_) throw std::logic_error("no Galois keys are bound");
+    return *galois_keys_;
+}
+
+ContentHash MemoEvaluator::key_for(Op op, const ContentHash &a, const ContentHash *b, std::int64_t arg,
+                                   const ContentHash *keys) const {
+    ContentHasher hasher(static_cast<std::uint64_t>(op));
+    hasher.update(a);
+    if (b) hasher.update(*b);
+    hasher.update(static_cast<std::uint64_t>(arg));
+    if (keys) hasher.update(*keys);
+    return hasher.finish();
+}
+
+template <class F>
+Ciphertext MemoEvaluator::memoize(const ContentHash &key, F &&compute) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = cache_.find(key);
+        if (found != cache_.end()) {
+            stats_.hits++;
+            lru_.splice(lru_.begin(), lru_, found->second.position);
+            return *found->second.result;
+        }
+        stats_.misses++;
+    }
+
+    // Compute outside the lock; a concurrent miss on the same key just
+    // computes the same result twice
+    auto result = std::make_shared<Ciphertext>();
+    compute(*result);
+    std::size_t bytes = data_bytes(*result);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes <= capacity_bytes_ && cache_.find(key) == cache_.end()) {
+        lru_.push_front(key);
+        cache_.emplace(key, Entry{ result, bytes, lru_.begin() });
+        bytes_ += bytes;
+        evict_locked();
+    }
+    return *result;
+}
+
+void MemoEvaluator::evict_locked() {
+    while (bytes_ > capacity_bytes_ && !lru_.empty()) {
+        auto entry = cache_.find(lru_.back());
+        bytes_ -= entry->second.bytes;
+        cache_.erase(entry);
+        lru_.pop_back();
+        stats_.evictions++;
+    }
+}
+
+Ciphertext MemoEvaluator::multiply(const Ciphertext &a, const Ciphertext &b) {
+    auto ha = content_hash(a), hb = content_hash(b);
+    // Multiplication commutes, so order the operand hashes
+    if (hb.hi < ha.hi || (hb.hi == ha.hi && hb.lo < ha.lo)) std::swap(ha, hb);
+    return memoize(key_for(Op::multiply, ha, &hb, 0, nullptr),
+                   [&](Ciphertext &out) { evaluator_.multiply(a, b, out); });
+}
+
+Ciphertext MemoEvaluator::square(const Ciphertext &encrypted) {
+    return memoize(key_for(Op::square, content_hash(encrypted), nullptr, 0, nullptr),
+                   [&](Ciphertext &out) { evaluator_.square(encrypted, out); });
+}
+
+Ciphertext MemoEvaluator::multiply_plain(const Ciphertext &encrypted, const Plaintext &plain) {
+    auto hp = content_hash(plain);
+    return memoize(key_for(Op::multiply_plain, content_hash(encrypted), &hp, 0, nullptr),
+                   [&](Ciphertext &out) { evaluator_.multiply_plain(encrypted, plain, out); });
+}
+
+Ciphertext MemoEvaluator::relinearize(const Ciphertext &encrypted) {
+    if (!relin_keys_) throw std::logic_error("no relinearization keys are bound");
+    return memoize(key_for(Op::relinearize, content_hash(encrypted), nullptr, 0, &relin_id_),
+                   [&](Ciphertext &out) { evaluator_.relinearize(encrypted, *relin_keys_, out); });
+}
+
+Ciphertext MemoEvaluator::rescale_to_next(const Ciphertext &encrypted) {
+    return memoize(key_for(Op::rescale_to_next, content_hash(encrypted), nullptr, 0, nullptr),
+                   [&](Ciphertext &out) { evaluator_.rescale_to_next(encrypted, out); });
+}
+
+Ciphertext MemoEvaluator::mod_switch_to_next(const Ciphertext &encrypted) {
+    return memoize(key_for(Op::mod_switch_to_next, content_hash(encrypted), nullptr, 0, nullptr),
+                   [&](Ciphertext &out) { evaluator_.mod_switch_to_next(encrypted, out); });
+}
+
+Ciphertext MemoEvaluator::rotate_vector(const Ciphertext &encrypted, int steps) {
+    auto &keys = galois_keys();
+    return memoize(key_for(Op::rotate_vector, content_hash(encrypted), nullptr, steps, &galois_id_),
+                   [&](Ciphertext &out) { evaluator_.rotate_vector(encrypted, steps, keys, out); });
+}
+
+Ciphertext MemoEvaluator::rotate_rows(const Ciphertext &encrypted, int steps) {
+    auto &keys = galois_keys();
+    return memoize(key_for(Op::rotate_rows, content_hash(encrypted), nullptr, steps, &galois_id_),
+                   [&](Ciphertext &out) { evaluator_.rotate_rows(encrypted, steps, keys, out); });
+}
+
+Ciphertext MemoEvaluator::rotate_columns(const Ciphertext &encrypted) {
+    auto &keys = galois_keys();
+    return memoize(key_for(Op::rotate_columns, content_hash(encrypted), nullptr, 0, &galois_id_),
+                   [&](Ciphertext &out) { evaluator_.rotate_columns(encrypted, keys, out); });
+}
+
+Ciphertext MemoEvaluator::complex_conjugate(const Ciphertext &encrypted) {
+    auto &keys = galois_keys();
+    return memoize(key_for(Op::complex_conjugate, content_hash(encrypted), nullptr, 0, &galois_id_),
+                   [&](Ciphertext &out) { evaluator_.complex_conjugate(encrypted, keys, out); });
+}
+
+std::size_t MemoEvaluator::capacity_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_bytes_;
+}
+
+void MemoEvaluator::set_capacity_bytes(std::size_t capacity_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_bytes_ = capacity_bytes;
+    evict_locked();
+}
+
+void MemoEvaluator::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+    lru_.clear();
+    bytes_ = 0;
+}
+
+MemoEvaluator::Stats MemoEvaluator::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.entries = cache_.size();
+    stats.bytes = bytes_;
+    return stats;
+}
+
+void MemoEvaluator::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.hits = stats_.misses = stats_.evictions = 0;
+}
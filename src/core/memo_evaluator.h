@@ -0,0 +1,83 @@
+#pragma once
+#include "content_hash.h"
+#include <seal/context.h>
+#include <seal/evaluator.h>
+#include <seal/relinkeys.h>
+#include <seal/galoiskeys.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Memoizes expensive Evaluator operations by content: the cache key is the
+// operation, the content hashes of its operands, its integer argument and the
+// identity (content hash) of the keys it uses. Results are kept in an LRU
+// bounded by capacity_bytes of ciphertext data. Cheap operations (add, sub,
+// negate) are not worth hashing for and are not offered.
+class MemoEvaluator {
+public:
+    enum class Op : std::uint64_t {
+        multiply = 1, square, multiply_plain, relinearize, rescale_to_next, mod_switch_to_next,
+        rotate_vector, rotate_rows, rotate_columns, complex_conjugate
+    };
+
+    MemoEvaluator(std::shared_ptr<seal::SEALContext> context, std::size_t capacity_bytes);
+
+    // Binds the keys used by relinearize / rotations and hashes them once;
+    // the caller keeps them alive and unchanged while bound
+    void set_relin_keys(const seal::RelinKeys *relin_keys);
+    void set_galois_keys(const seal::GaloisKeys *galois_keys);
+
+    seal::Ciphertext multiply(const seal::Ciphertext &a, const seal::Ciphertext &b);
+    seal::Ciphertext square(const seal::Ciphertext &encrypted);
+    seal::Ciphertext multiply_plain(const seal::Ciphertext &encrypted, const seal::Plaintext &plain);
+    seal::Ciphertext relinearize(const seal::Ciphertext &encrypted);
+    seal::Ciphertext rescale_to_next(const seal::Ciphertext &encrypted);
+    seal::Ciphertext mod_switch_to_next(const seal::Ciphertext &encrypted);
+    seal::Ciphertext rotate_vector(const seal::Ciphertext &encrypted, int steps);
+    seal::Ciphertext rotate_rows(const seal::Ciphertext &encrypted, int steps);
+    seal::Ciphertext rotate_columns(const seal::Ciphertext &encrypted);
+    seal::Ciphertext complex_conjugate(const seal::Ciphertext &encrypted);
+
+    std::size_t capacity_bytes() const;
+    void set_capacity_bytes(std::size_t capacity_bytes);
+    void clear();
+
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+    };
+    Stats stats() const;
+    void reset_stats();
+
+private:
+    template <class F>
+    seal::Ciphertext memoize(const ContentHash &key, F &&compute);
+
+    ContentHash key_for(Op op, const ContentHash &a, const ContentHash *b, std::int64_t arg, const ContentHash *keys) const;
+    const seal::GaloisKeys &galois_keys() const;
+    void evict_locked();
+
+    std::shared_ptr<seal::SEALContext> context_;
+    seal::Evaluator evaluator_;
+    const seal::RelinKeys *relin_keys_ = nullptr;
+    const seal::GaloisKeys *galois_keys_ = nullptr;
+    ContentHash relin_id_, galois_id_;
+
+    using lru_list = std::list<ContentHash>;
+    struct Entry {
+        std::shared_ptr<const seal::Ciphertext> result;
+        std::size_t bytes;
+        lru_list::iterator position;
+    };
+    mutable std::mutex mutex_;
+    lru_list lru_;
+    std::unordered_map<ContentHash, Entry> cache_;
+    std::size_t capacity_bytes_;
+    std::size_t bytes_ = 0;
+    Stats stats_;
+};
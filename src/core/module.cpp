@@ -19,6 +19,25 @@
 #include "bind_serialization.h"
 #include "bind_modulus.h"
 #include "bind_security.h" 
+#include "bind_pickle.h"
+#include "bind_batchevaluator.h"
+#include "bind_async.h"
+#include "bind_pir.h"
+#include "bind_tuner.h"
+#include "bind_conv2d.h"
+#include "bind_stream.h"
+#include "bind_memo.h"
+#include "bind_trusted.h"
+#include "bind_cpu.h"
+#include "bind_rotation.h"
+#include "bind_pool.h"
+#include "bind_bootstrap.h"
+#include "bind_inference.h"
+#include "bind_numa.h"
+#include "bind_crt.h"
+#include "bind_matmul.h"
+#include "bind_group_by.h"
+#include "bind_psi.h"
 
 
 namespace py = pybind11;
@@ -39,6 +58,7 @@ PYBIND11_MODULE(seal, m) {
         .value("TC128", sec_level_type::tc128)
         .value("TC192", sec_level_type::tc192)
         .value("TC256", sec_level_type::tc256)
+        .value("NONE", sec_level_type::none)
         .export_values();
 
     
@@ -62,6 +82,25 @@ PYBIND11_MODULE(seal, m) {
     // bind_advanced(m); 
     // bind_util(m);
     bind_security(m);
+    bind_pickle(m);
+    bind_batchevaluator(m);
+    bind_async(m);
+    bind_pir(m);
+    bind_tuner(m);
+    bind_conv2d(m);
+    bind_stream(m);
+    bind_memo(m);
+    bind_trusted(m);
+    bind_cpu(m);
+    bind_rotation(m);
+    bind_pool(m);
+    bind_bootstrap(m);
+    bind_inference(m);
+    bind_numa(m);
+    bind_crt(m);
+    bind_matmul(m);
+    bind_group_by(m);
+    bind_psi(m);
     // bind_encryption(m);
     
     
@@ -0,0 +1,301 @@
+#include "numa_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace seal;
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    // "0-3,8-11" -> { 0, 1, 2, 3, 8, 9, 10, 11 }
+    std::vector<int> parse_cpulist(const std::string &text) {
+        std::vector<int> cpus;
+        std::stringstream stream(text);
+        std::string range;
+        while (std::getline(stream, range, ',')) {
+            if (range.find_first_of("0123456789") == std::string::npos) continue;
+            auto dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    std::vector<int> usable_cpus() {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (std::size_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(static_cast<int>(cpu));
+            }
+        }
+#endif
+        if (cpus.empty()) {
+            auto count = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned cpu = 0; cpu < count; cpu++) cpus.push_back(static_cast<int>(cpu));
+        }
+        return cpus;
+    }
+
+    // Copy of keys whose key ciphertexts are allocated from pool; copy
+    // assignment keeps the destination's pool, so the process-wide memory
+    // manager profile is left alone
+    template <class Keys>
+    std::unique_ptr<Keys> replicate_keys(const Keys &keys, const MemoryPoolHandle &pool) {
+        auto replica = std::make_unique<Keys>();
+        replica->parms_id() = keys.parms_id();
+        auto &data = replica->data();
+        data.resize(keys.data().size());
+        for (std::size_t i = 0; i < data.size(); i++) {
+            for (auto &key : keys.data()[i]) {
+                data[i].emplace_back();
+                data[i].back().data() = Ciphertext(pool);
+                data[i].back().data() = key.data();
+            }
+        }
+        return replica;
+    }
+
+    struct ChunkResult {
+        double busy = 0;
+        clock_type::time_point end;
+    };
+}
+
+std::vector<NumaNode> numa_topology() {
+    auto usable = usable_cpus();
+    std::vector<NumaNode> nodes;
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+        auto name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0) continue;
+        if (name.find_first_not_of("0123456789", 4) != std::string::npos) continue;
+        std::ifstream file(entry.path() / "cpulist");
+        std::string text;
+        if (!file || !std::getline(file, text)) continue;
+
+        NumaNode node;
+        node.id = std::stoi(name.substr(4));
+        for (int cpu : parse_cpulist(text)) {
+            if (std::find(usable.begin(), usable.end(), cpu) != usable.end()) node.cpus.push_back(cpu);
+        }
+        // Memory-only nodes and nodes outside our affinity mask get no workers
+        if (!node.cpus.empty()) nodes.push_back(std::move(node));
+    }
+    if (nodes.empty()) {
+        NumaNode node;
+        node.cpus = std::move(usable);
+        nodes.push_back(std::move(node));
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode &a, const NumaNode &b) { return a.id < b.id; });
+    return nodes;
+}
+
+int numa_node_of(const void *address) {
+#if defined(__linux__) && defined(SYS_move_pages)
+    if (!address) return -1;
+    auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto page = reinterpret_cast<void *>(reinterpret_cast<std::uintptr_t>(address) & ~(page_size - 1));
+    // move_pages with no target nodes only reports where each page lives
+    int status = -1;
+    if (syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) != 0) return -1;
+    return status < 0 ? -1 : status;
+#else
+    (void)address;
+    return -1;
+#endif
+}
+
+NumaWorkerPool::NumaWorkerPool(std::shared_ptr<SEALContext> context, std::size_t threads_per_node, bool pin)
+    : context_(std::move(context)), evaluator_(*context_) {
+    for (auto &info : numa_topology()) {
+        Node node;
+        std::size_t threads = threads_per_node ? threads_per_node : info.cpus.size();
+        node.pool = pin ? std::make_unique<ThreadPool>(threads, info.cpus) : std::make_unique<ThreadPool>(threads);
+        node.memory = MemoryPoolHandle::New();
+        node.info = std::move(info);
+        nodes_.push_back(std::move(node));
+    }
+    stats_.resize(nodes_.size());
+}
+
+std::size_t NumaWorkerPool::threads() const noexcept {
+    std::size_t total = 0;
+    for (auto &node : nodes_) total += node.pool->size();
+    return total;
+}
+
+void NumaWorkerPool::set_relin_keys(const RelinKeys &relin_keys) {
+    // Each replica is allocated and written by a worker of its node
+    std::vector<std::future<std::unique_ptr<RelinKeys>>> pending;
+    for (auto &node : nodes_) {
+        pending.push_back(node.pool->submit([&node, &relin_keys]() {
+            return replicate_keys(relin_keys, node.memory);
+        }));
+    }
+    for (std::size_t i = 0; i < nodes_.size(); i++) nodes_[i].relin_keys = pending[i].get();
+}
+
+void NumaWorkerPool::set_galois_keys(const GaloisKeys &galois_keys) {
+    std::vector<std::future<std::unique_ptr<GaloisKeys>>> pending;
+    for (auto &node : nodes_) {
+        pending.push_back(node.pool->submit([&node, &galois_keys]() {
+            return replicate_keys(galois_keys, node.memory);
+        }));
+    }
+    for (std::size_t i = 0; i < nodes_.size(); i++) nodes_[i].galois_keys = pending[i].get();
+}
+
+const RelinKeys &NumaWorkerPool::relin_keys(const Node &node) const {
+    if (!node.relin_keys) throw std::logic_error("relinearization keys have not been set");
+    return *node.relin_keys;
+}
+
+const GaloisKeys &NumaWorkerPool::galois_keys(const Node &node) const {
+    if (!node.galois_keys) throw std::logic_error("Galois keys have not been set");
+    return *node.galois_keys;
+}
+
+std::vector<std::size_t> NumaWorkerPool::route(const std::vector<const Ciphertext *> &cts) const {
+    std::vector<std::size_t> result(cts.size());
+    std::size_t unknown = 0;
+    for (std::size_t i = 0; i < cts.size(); i++) {
+        int id = numa_node_of(cts[i]->data());
+        auto it = std::find_if(nodes_.begin(), nodes_.end(), [id](const Node &node) { return node.info.id == id; });
+        result[i] = it != nodes_.end() ? static_cast<std::size_t>(it - nodes_.begin()) : unknown++ % nodes_.size();
+    }
+    return result;
+}
+
+std::vector<Ciphertext> NumaWorkerPool::run(const std::vector<const Ciphertext *> &cts,
+                                            const std::function<void(const Node &, std::size_t, Ciphertext &)> &fn)
+    const {
+    auto targets = route(cts);
+    std::vector<std::vector<std::size_t>> items(nodes_.size());
+    std::vector<std::uint64_t> local(nodes_.size(), 0);
+    std::vector<Ciphertext> result;
+    result.reserve(cts.size());
+    for (std::size_t i = 0; i < cts.size(); i++) {
+        auto &node = nodes_[targets[i]];
+        items[targets[i]].push_back(i);
+        if (numa_node_of(cts[i]->data()) == node.info.id) local[targets[i]]++;
+        result.emplace_back(node.memory);
+    }
+
+    auto start = clock_type::now();
+    auto run_chunk = [&](std::size_t n, std::size_t begin, std::size_t end) {
+        auto chunk_start = clock_type::now();
+        for (std::size_t k = begin; k < end; k++) fn(nodes_[n], items[n][k], result[items[n][k]]);
+        ChunkResult chunk;
+        chunk.end = clock_type::now();
+        chunk.busy = std::chrono::duration<double>(chunk.end - chunk_start).count();
+        return chunk;
+    };
+
+    // Called from a worker (of this or another pool) everything runs inline
+    std::vector<std::vector<std::future<ChunkResult>>> pending(nodes_.size());
+    std::vector<std::vector<ChunkResult>> done(nodes_.size());
+    bool inline_run = ThreadPool::on_worker_thread();
+    for (std::size_t n = 0; n < nodes_.size(); n++) {
+        std::size_t count = items[n].size();
+        if (!count) continue;
+        if (inline_run) {
+            done[n].push_back(run_chunk(n, 0, count));
+            continue;
+        }
+        std::size_t chunks = std::min(nodes_[n].pool->size(), count);
+        for (std::size_t c = 0; c < chunks; c++) {
+            std::size_t begin = count * c / chunks, end = count * (c + 1) / chunks;
+            pending[n].push_back(nodes_[n].pool->submit([&run_chunk, n, begin, end]() {
+                return run_chunk(n, begin, end);
+            }));
+        }
+    }
+
+    std::exception_ptr error;
+    for (std::size_t n = 0; n < nodes_.size(); n++) {
+        for (auto &future : pending[n]) {
+            try {
+                done[n].push_back(future.get());
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        }
+    }
+    if (error) std::rethrow_exception(error);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (std::size_t n = 0; n < nodes_.size(); n++) {
+        if (items[n].empty()) continue;
+        auto &stats = stats_[n];
+        stats.batches++;
+        stats.items += items[n].size();
+        stats.local_items += local[n];
+        auto last = start;
+        for (auto &chunk : done[n]) {
+            stats.busy_seconds += chunk.busy;
+            last = std::max(last, chunk.end);
+        }
+        stats.seconds += std::chrono::duration<double>(last - start).count();
+    }
+    return result;
+}
+
+std::vector<Ciphertext> NumaWorkerPool::relinearize(const std::vector<const Ciphertext *> &cts) const {
+    return run(cts, [this, &cts](const Node &node, std::size_t i, Ciphertext &destination) {
+        evaluator_.relinearize(*cts[i], relin_keys(node), destination, node.memory);
+    });
+}
+
+std::vector<Ciphertext> NumaWorkerPool::multiply_relinearize(const std::vector<const Ciphertext *> &a,
+                                                             const std::vector<const Ciphertext *> &b) const {
+    if (a.size() != b.size()) throw std::invalid_argument("a and b must have the same length");
+    return run(a, [this, &a, &b](const Node &node, std::size_t i, Ciphertext &destination) {
+        evaluator_.multiply(*a[i], *b[i], destination, node.memory);
+        evaluator_.relinearize_inplace(destination, relin_keys(node), node.memory);
+    });
+}
+
+std::vector<Ciphertext> NumaWorkerPool::rotate(const std::vector<const Ciphertext *> &cts, int steps) const {
+    bool ckks = context_->first_context_data()->parms().scheme() == scheme_type::ckks;
+    return run(cts, [this, &cts, steps, ckks](const Node &node, std::size_t i, Ciphertext &destination) {
+        if (ckks) {
+            evaluator_.rotate_vector(*cts[i], steps, galois_keys(node), destination, node.memory);
+        } else {
+            evaluator_.rotate_rows(*cts[i], steps, galois_keys(node), destination, node.memory);
+        }
+    });
+}
+
+std::vector<Ciphertext> NumaWorkerPool::apply_galois(const std::vector<const Ciphertext *> &cts,
+                                                     std::uint32_t galois_elt) const {
+    return run(cts, [this, &cts, galois_elt](const Node &node, std::size_t i, Ciphertext &destination) {
+        evaluator_.apply_galois(*cts[i], galois_elt, galois_keys(node), destination, node.memory);
+    });
+}
+
+std::vector<NumaWorkerPool::NodeStats> NumaWorkerPool::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+void NumaWorkerPool::reset_stats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    std::fill(stats_.begin(), stats_.end(), NodeStats());
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "thread_pool.h"
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/evaluator.h>
+#include <seal/galoiskeys.h>
+#include <seal/memorymanager.h>
+#include <seal/relinkeys.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct NumaNode {
+    // Operating-system node id
+    int id = 0;
+    // CPUs of the node this process may run on
+    std::vector<int> cpus;
+};
+
+// Nodes with at least one usable CPU, read from /sys/devices/system/node.
+// Without NUMA information this is a single node holding every usable CPU.
+std::vector<NumaNode> numa_topology();
+
+// Node holding the page at address, or -1 when the page is not mapped yet or
+// the platform cannot tell
+int numa_node_of(const void *address);
+
+// Worker pool for batched Evaluator work on multi-socket machines. Every node
+// gets its own ThreadPool pinned to its CPUs, its own MemoryPoolHandle, and
+// its own replica of the relinearization and Galois keys. Replicas are copied
+// by that node's workers into that node's memory pool, so first-touch
+// placement puts them in local memory. Each batch item runs on the node that
+// holds its ciphertext data and writes a result allocated from that node's
+// pool, so key switching reads keys, input and output without crossing the
+// interconnect. Items whose node cannot be determined are spread round-robin.
+class NumaWorkerPool {
+public:
+    struct NodeStats {
+        std::uint64_t batches = 0;
+        std::uint64_t items = 0;
+        // Items whose input was found on this node
+        std::uint64_t local_items = 0;
+        // Wall-clock seconds from dispatch to the node's last item, summed
+        // over batches, and worker seconds spent on items
+        double seconds = 0;
+        double busy_seconds = 0;
+    };
+
+    // threads_per_node == 0 starts one worker per CPU of each node; with pin
+    // false the workers are left to the scheduler
+    NumaWorkerPool(std::shared_ptr<seal::SEALContext> context, std::size_t threads_per_node = 0, bool pin = true);
+
+    std::size_t node_count() const noexcept { return nodes_.size(); }
+    const NumaNode &node(std::size_t index) const { return nodes_.at(index).info; }
+    std::size_t threads() const noexcept;
+    const seal::MemoryPoolHandle &memory_pool(std::size_t index) const { return nodes_.at(index).memory; }
+
+    // Replace the per-node replicas; not safe while a batch is running
+    void set_relin_keys(const seal::RelinKeys &relin_keys);
+    void set_galois_keys(const seal::GaloisKeys &galois_keys);
+    bool has_relin_keys() const noexcept { return nodes_.front().relin_keys != nullptr; }
+    bool has_galois_keys() const noexcept { return nodes_.front().galois_keys != nullptr; }
+
+    // Node index (into node()) each item would run on
+    std::vector<std::size_t> route(const std::vector<const seal::Ciphertext *> &cts) const;
+
+    // Batched Evaluator operations; result i belongs to cts[i]
+    std::vector<seal::Ciphertext> relinearize(const std::vector<const seal::Ciphertext *> &cts) const;
+    std::vector<seal::Ciphertext> multiply_relinearize(const std::vector<const seal::Ciphertext *> &a,
+                                                       const std::vector<const seal::Ciphertext *> &b) const;
+
+    // rotate_vector for CKKS, rotate_rows for BFV/BGV
+    std::vector<seal::Ciphertext> rotate(const std::vector<const seal::Ciphertext *> &cts, int steps) const;
+    std::vector<seal::Ciphertext> apply_galois(const std::vector<const seal::Ciphertext *> &cts,
+                                               std::uint32_t galois_elt) const;
+
+    std::vector<NodeStats> stats() const;
+    void reset_stats();
+
+private:
+    struct Node {
+        NumaNode info;
+        std::unique_ptr<ThreadPool> pool;
+        seal::MemoryPoolHandle memory;
+        // Null until the keys are set
+        std::unique_ptr<seal::RelinKeys> relin_keys;
+        std::unique_ptr<seal::GaloisKeys> galois_keys;
+    };
+
+    // Runs fn(node, i, result) for every item on the node route() picks and
+    // rethrows the first exception
+    std::vector<seal::Ciphertext> run(const std::vector<const seal::Ciphertext *> &cts,
+                                      const std::function<void(const Node &, std::size_t, seal::Ciphertext &)> &fn)
+        const;
+    const seal::RelinKeys &relin_keys(const Node &node) const;
+    const seal::GaloisKeys &galois_keys(const Node &node) const;
+
+    std::shared_ptr<seal::SEALContext> context_;
+    seal::Evaluator evaluator_;
+    std::vector<Node> nodes_;
+
+    mutable std::mutex stats_mutex_;
+    mutable std::vector<NodeStats> stats_;
+};
@@ -0,0 +1,31 @@
+#include "object_pool.h"
+
+using namespace seal;
+
+namespace {
+    std::shared_ptr<const SEALContext::ContextData> pool_context_data(const SEALContext &context,
+                                                                      parms_id_type &parms_id) {
+        if (!context.parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+        if (parms_id == parms_id_zero) parms_id = context.first_parms_id();
+        auto context_data = context.get_context_data(parms_id);
+        if (!context_data) throw std::invalid_argument("parms_id is not valid for encryption parameters");
+        return context_data;
+    }
+}
+
+CiphertextPool::CiphertextPool(std::shared_ptr<SEALContext> context, parms_id_type parms_id, std::size_t size_capacity,
+                               std::size_t preallocate)
+    : ObjectPool<Ciphertext>([this](Ciphertext &encrypted) { encrypted.reserve(*context_, parms_id_, size_capacity_); }),
+      context_(std::move(context)), parms_id_(parms_id), size_capacity_(size_capacity) {
+    pool_context_data(*context_, parms_id_);
+    if (size_capacity_ < 2) throw std::invalid_argument("size_capacity must be at least 2");
+    this->preallocate(preallocate);
+}
+
+PlaintextPool::PlaintextPool(std::shared_ptr<SEALContext> context, parms_id_type parms_id, std::size_t preallocate)
+    : ObjectPool<Plaintext>([this](Plaintext &plain) { plain.reserve(coeff_capacity_); }),
+      context_(std::move(context)), parms_id_(parms_id), coeff_capacity_(0) {
+    auto &parms = pool_context_data(*context_, parms_id_)->parms();
+    coeff_capacity_ = parms.poly_modulus_degree() * parms.coeff_modulus().size();
+    this->preallocate(preallocate);
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/plaintext.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+struct PoolStats {
+    // Objects constructed and reserved by the pool
+    std::uint64_t created = 0;
+    std::uint64_t acquires = 0;
+    std::uint64_t releases = 0;
+    // Released objects whose data buffer was reallocated while checked out,
+    // i.e. the reservation was too small for what was written into them
+    std::uint64_t reallocations = 0;
+    std::size_t outstanding = 0;
+    std::size_t free = 0;
+};
+
+// Free list of pre-reserved objects. acquire hands out an object (reusing a
+// released one when possible) that stays owned by the pool; release takes it
+// back with its buffer intact, so a steady-state loop allocates nothing.
+// Using an object after releasing it is an error, as with any pool.
+template <class T>
+class ObjectPool {
+public:
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    T *acquire() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stats_.acquires++;
+        std::unique_ptr<T> object;
+        if (!free_.empty()) {
+            object = std::move(free_.back());
+            free_.pop_back();
+        } else {
+            stats_.created++;
+            lock.unlock();
+            object = std::make_unique<T>();
+            reserve_(*object);
+            lock.lock();
+        }
+        T *raw = object.get();
+        outstanding_.emplace(raw, Checkout{ std::move(object), buffer(*raw) });
+        return raw;
+    }
+
+    void release(T *object) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = outstanding_.find(object);
+        if (found == outstanding_.end()) throw std::invalid_argument("object was not acquired from this pool");
+        stats_.releases++;
+        if (buffer(*object) != found->second.buffer) stats_.reallocations++;
+        free_.push_back(std::move(found->second.object));
+        outstanding_.erase(found);
+    }
+
+    // Constructs count objects ahead of time
+    void preallocate(std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            auto object = std::make_unique<T>();
+            reserve_(*object);
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.created++;
+            free_.push_back(std::move(object));
+        }
+    }
+
+    // Frees the released objects; outstanding ones are unaffected
+    void shrink() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.clear();
+    }
+
+    PoolStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PoolStats stats = stats_;
+        stats.outstanding = outstanding_.size();
+        stats.free = free_.size();
+        return stats;
+    }
+
+    void reset_stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = PoolStats();
+    }
+
+protected:
+    explicit ObjectPool(std::function<void(T &)> reserve) : reserve_(std::move(reserve)) {}
+
+private:
+    static const void *buffer(const T &object) {
+        return object.data();
+    }
+
+    struct Checkout {
+        std::unique_ptr<T> object;
+        const void *buffer;
+    };
+
+    std::function<void(T &)> reserve_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> free_;
+    std::unordered_map<T *, Checkout> outstanding_;
+    PoolStats stats_;
+};
+
+// Ciphertexts reserved for parms_id (the first data level when zero) with
+// room for size_capacity polynomials; 3 fits an unrelinearized product
+class CiphertextPool : public ObjectPool<seal::Ciphertext> {
+public:
+    CiphertextPool(std::shared_ptr<seal::SEALContext> context, seal::parms_id_type parms_id = seal::parms_id_zero,
+                   std::size_t size_capacity = 3, std::size_t preallocate = 0);
+
+    const seal::parms_id_type &parms_id() const noexcept { return parms_id_; }
+    std::size_t size_capacity() const noexcept { return size_capacity_; }
+
+private:
+    std::shared_ptr<seal::SEALContext> context_;
+    seal::parms_id_type parms_id_;
+    std::size_t size_capacity_;
+};
+
+// Plaintexts with room for one polynomial at parms_id (the first data level
+// when zero), enough for NTT-form CKKS encodings and BFV/BGV plaintexts alike
+class PlaintextPool : public ObjectPool<seal::Plaintext> {
+public:
+    PlaintextPool(std::shared_ptr<seal::SEALContext> context, seal::parms_id_type parms_id = seal::parms_id_zero,
+                  std::size_t preallocate = 0);
+
+    const seal::parms_id_type &parms_id() const noexcept { return parms_id_; }
+    std::size_t coeff_capacity() const noexcept { return coeff_capacity_; }
+
+private:
+    std::shared_ptr<seal::SEALContext> context_;
+    seal::parms_id_type parms_id_;
+    std::size_t coeff_capacity_;
+};
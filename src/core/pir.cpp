@@ -0,0 +1,423 @@
+#include "pir.h"
+#include "rns_kernels.h"
+#include <seal/serializable.h>
+#include <seal/util/polyarithsmallmod.h>
+#include <seal/util/uintarithsmallmod.h>
+#include <seal/util/ntt.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+using namespace seal;
+using namespace seal::util;
+
+namespace {
+    constexpr char database_magic[8] = { 'S', 'E', 'A', 'L', 'P', 'I', 'R', '1' };
+
+    // Fixed-size file header; the preprocessed rows follow immediately
+    struct DatabaseHeader {
+        char magic[8];
+        std::uint64_t item_count;
+        std::uint64_t poly_modulus_degree;
+        std::uint64_t coeff_modulus_size;
+        std::uint64_t plain_modulus;
+        parms_id_type parms_id;
+    };
+
+    void check_batching(const SEALContext &context) {
+        if (!context.parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+        auto scheme = context.first_context_data()->parms().scheme();
+        if (scheme != scheme_type::bfv && scheme != scheme_type::bgv) {
+            throw std::invalid_argument("PIR requires the BFV or BGV scheme");
+        }
+        if (!context.first_context_data()->qualifiers().using_batching) {
+            throw std::invalid_argument("encryption parameters are not valid for batching");
+        }
+        if (!context.using_keyswitching()) throw std::logic_error("keyswitching is not supported by the context");
+    }
+
+    std::size_t block_count(std::size_t item_count, std::size_t coeff_count) {
+        return (item_count + coeff_count - 1) / coeff_count;
+    }
+
+    // Items covered by query ciphertext block
+    std::size_t block_items(std::size_t item_count, std::size_t coeff_count, std::size_t block) {
+        return std::min(coeff_count, item_count - block * coeff_count);
+    }
+
+    // Expansion depth: each level doubles the number of selection ciphertexts
+    std::size_t expansion_levels(std::size_t items) {
+        std::size_t levels = 0;
+        while ((std::size_t(1) << levels) < items) levels++;
+        return levels;
+    }
+
+    std::uint32_t expansion_elt(std::size_t coeff_count, std::size_t level) {
+        return static_cast<std::uint32_t>((coeff_count >> level) + 1);
+    }
+
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Oblivious query expansion for one block. A node at level j with index k
+    // encrypts 2^j times the coefficients k, k + 2^j, ... of the query moved
+    // down to the even positions; its children are k and k + 2^j. Subtrees are
+    // walked depth first so only one path of ciphertexts is alive per worker.
+    class Expander {
+    public:
+        Expander(const Evaluator &evaluator, const SEALContext::ContextData &context_data,
+                 const GaloisKeys &galois_keys, bool ntt_form, std::size_t levels)
+            : evaluator_(evaluator), context_data_(context_data), galois_keys_(galois_keys), ntt_form_(ntt_form) {
+            auto &parms = context_data_.parms();
+            coeff_count_ = parms.poly_modulus_degree();
+            if (!ntt_form_) return;
+
+            // BGV ciphertexts stay in NTT form, so the monomial shifts become
+            // dyadic products with transformed monomials, one per level
+            auto &coeff_modulus = parms.coeff_modulus();
+            auto ntt_tables = context_data_.small_ntt_tables();
+            monomials_.resize(levels);
+            for (std::size_t level = 0; level < levels; level++) {
+                auto &monomial = monomials_[level];
+                monomial.assign(coeff_count_ * coeff_modulus.size(), 0);
+                for (std::size_t j = 0; j < coeff_modulus.size(); j++) {
+                    std::uint64_t *limb = monomial.data() + j * coeff_count_;
+                    limb[coeff_count_ - (std::size_t(1) << level)] = coeff_modulus[j].value() - 1;
+                    ntt_negacyclic_harvey(limb, ntt_tables[j]);
+                }
+            }
+        }
+
+        // Splits node (encrypted, level) in place into its left child and,
+        // when right is given, the right child
+        void split(Ciphertext &encrypted, std::size_t level, Ciphertext *right) const {
+            Ciphertext rotated;
+            if (right) {
+                multiply_by_inverse_monomial(encrypted, level, *right);
+                evaluator_.apply_galois(*right, expansion_elt(coeff_count_, level), galois_keys_, rotated);
+                evaluator_.add_inplace(*right, rotated);
+            }
+            evaluator_.apply_galois(encrypted, expansion_elt(coeff_count_, level), galois_keys_, rotated);
+            evaluator_.add_inplace(encrypted, rotated);
+        }
+
+    private:
+        // destination = encrypted * X^(-2^level) = encrypted * -X^(N - 2^level)
+        void multiply_by_inverse_monomial(const Ciphertext &encrypted, std::size_t level, Ciphertext &destination) const {
+            auto &coeff_modulus = context_data_.parms().coeff_modulus();
+            destination = encrypted;
+            for (std::size_t i = 0; i < encrypted.size(); i++) {
+                for (std::size_t j = 0; j < coeff_modulus.size(); j++) {
+                    std::size_t offset = j * coeff_count_;
+                    const std::uint64_t *in = encrypted.data(i) + offset;
+                    std::uint64_t *out = destination.data(i) + offset;
+                    if (ntt_form_) {
+                        dyadic_product_coeffmod(in, monomials_[level].data() + offset, coeff_count_, coeff_modulus[j], out);
+                    } else {
+                        negacyclic_shift_poly_coeffmod(in, coeff_count_, coeff_count_ - (std::size_t(1) << level),
+                                                       coeff_modulus[j], out);
+                        negate_poly_coeffmod(out, coeff_count_, coeff_modulus[j], out);
+                    }
+                }
+            }
+        }
+
+        const Evaluator &evaluator_;
+        const SEALContext::ContextData &context_data_;
+        const GaloisKeys &galois_keys_;
+        bool ntt_form_;
+        std::size_t coeff_count_;
+        std::vector<std::vector<std::uint64_t>> monomials_;
+    };
+
+    // Work item of the parallel phase: an expansion subtree of one block
+    struct Subtree {
+        Ciphertext encrypted;
+        std::size_t block;
+        std::size_t level;
+        std::size_t index;
+    };
+}
+
+PIRServer::PIRServer(std::shared_ptr<SEALContext> context, std::size_t threads)
+    : context_(std::move(context)), batch_(context_, threads) {
+    check_batching(*context_);
+    auto &parms = context_->first_context_data()->parms();
+    parms_id_ = context_->first_parms_id();
+    row_words_ = parms.poly_modulus_degree() * parms.coeff_modulus().size();
+}
+
+void PIRServer::set_database(const std::vector<std::vector<std::uint64_t>> &rows) {
+    BatchEncoder encoder(*context_);
+    std::vector<std::uint64_t> data(rows.size() * row_words_);
+    batch_.pool().parallel_for(rows.size(), [&](std::size_t begin, std::size_t end) {
+        Plaintext plain;
+        for (std::size_t i = begin; i < end; i++) {
+            if (rows[i].size() > encoder.slot_count()) throw std::invalid_argument("row has more values than slots");
+            encoder.encode(rows[i], plain);
+            batch_.evaluator().transform_to_ntt_inplace(plain, parms_id_);
+            std::copy_n(plain.data(), row_words_, data.data() + i * row_words_);
+        }
+    });
+
+    mapped_.reset();
+    rows_ = std::move(data);
+    data_ = rows_.data();
+    item_count_ = rows.size();
+}
+
+void PIRServer::save_database(const std::string &path) const {
+    if (!data_) throw std::logic_error("database is not set");
+    auto &parms = context_->first_context_data()->parms();
+    DatabaseHeader header;
+    std::memcpy(header.magic, database_magic, sizeof(database_magic));
+    header.item_count = item_count_;
+    header.poly_modulus_degree = parms.poly_modulus_degree();
+    header.coeff_modulus_size = parms.coeff_modulus().size();
+    header.plain_modulus = parms.plain_modulus().value();
+    header.parms_id = parms_id_;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("failed to open " + path);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(data_), static_cast<std::streamsize>(database_bytes()));
+    if (!out) throw std::runtime_error("failed to write " + path);
+}
+
+void PIRServer::load_database(const std::string &path) {
+    auto file = std::make_unique<MappedFile>(path);
+    if (file->size() < sizeof(DatabaseHeader)) throw std::invalid_argument("not a PIR database file");
+    DatabaseHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, database_magic, sizeof(database_magic)) != 0) {
+        throw std::invalid_argument("not a PIR database file");
+    }
+
+    auto &parms = context_->first_context_data()->parms();
+    if (header.parms_id != parms_id_ || header.poly_modulus_degree != parms.poly_modulus_degree() ||
+        header.coeff_modulus_size != parms.coeff_modulus().size() ||
+        header.plain_modulus != parms.plain_modulus().value()) {
+        throw std::invalid_argument("database file does not match the context");
+    }
+    auto count = static_cast<std::size_t>(header.item_count);
+    if (file->size() != sizeof(DatabaseHeader) + count * row_words_ * sizeof(std::uint64_t)) {
+        throw std::invalid_argument("database file is truncated");
+    }
+
+    rows_.clear();
+    rows_.shrink_to_fit();
+    data_ = reinterpret_cast<const std::uint64_t *>(file->data() + sizeof(DatabaseHeader));
+    mapped_ = std::move(file);
+    item_count_ = count;
+}
+
+Ciphertext PIRServer::answer(const std::vector<Ciphertext> &query, const GaloisKeys &galois_keys,
+                             bool compress_response) const {
+    if (!data_) throw std::logic_error("database is not set");
+    auto start = std::chrono::steady_clock::now();
+    auto &context_data = *context_->get_context_data(parms_id_);
+    auto &parms = context_data.parms();
+    auto &coeff_modulus = parms.coeff_modulus();
+    std::size_t coeff_count = parms.poly_modulus_degree();
+    std::size_t blocks = block_count(item_count_, coeff_count);
+
+    if (query.size() != blocks) throw std::invalid_argument("query has the wrong number of ciphertexts");
+    for (auto &encrypted : query) {
+        if (encrypted.parms_id() != parms_id_) throw std::invalid_argument("query is not at the first data level");
+        if (encrypted.size() != 2) throw std::invalid_argument("query ciphertexts must have size 2");
+    }
+    bool ntt_form = query.front().is_ntt_form();
+    const Evaluator &evaluator = batch_.evaluator();
+    Expander expander(evaluator, context_data, galois_keys, ntt_form,
+                      expansion_levels(block_items(item_count_, coeff_count, 0)));
+
+    // Expand breadth first until there is a subtree per worker
+    std::vector<Subtree> frontier;
+    for (std::size_t block = 0; block < blocks; block++) frontier.push_back({ query[block], block, 0, 0 });
+    auto is_leaf = [&](const Subtree &node) {
+        return node.level == expansion_levels(block_items(item_count_, coeff_count, node.block));
+    };
+    while (frontier.size() < batch_.threads() &&
+           std::any_of(frontier.begin(), frontier.end(), [&](const Subtree &node) { return !is_leaf(node); })) {
+        std::vector<Subtree> rights(frontier.size());
+        std::vector<char> has_right(frontier.size(), 0);
+        batch_.pool().parallel_for(frontier.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                auto &node = frontier[i];
+                if (is_leaf(node)) continue;
+                std::size_t step = std::size_t(1) << node.level;
+                bool right = node.index + step < block_items(item_count_, coeff_count, node.block);
+                expander.split(node.encrypted, node.level, right ? &rights[i].encrypted : nullptr);
+                if (right) {
+                    rights[i].block = node.block;
+                    rights[i].level = node.level + 1;
+                    rights[i].index = node.index + step;
+                    has_right[i] = 1;
+                }
+                node.level++;
+            }
+        });
+        for (std::size_t i = 0; i < rights.size(); i++) {
+            if (has_right[i]) frontier.push_back(std::move(rights[i]));
+        }
+    }
+
+    // Each chunk walks its subtrees depth first and accumulates the selected
+    // rows into its own NTT-form partial sum
+    std::size_t chunks = std::max<std::size_t>(1, std::min(batch_.threads(), frontier.size()));
+    std::vector<std::vector<std::uint64_t>> partials(chunks);
+    std::size_t chunk_size = (frontier.size() + chunks - 1) / chunks;
+    batch_.pool().parallel_for(chunks, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::uint64_t> scratch(coeff_count);
+        for (std::size_t c = begin; c < end; c++) {
+            auto &acc = partials[c];
+            acc.assign(2 * row_words_, 0);
+
+            std::function<void(Ciphertext &, std::size_t, std::size_t, std::size_t)> visit;
+            visit = [&](Ciphertext &encrypted, std::size_t block, std::size_t level, std::size_t index) {
+                std::size_t items = block_items(item_count_, coeff_count, block);
+                if (level == expansion_levels(items)) {
+                    if (!ntt_form) evaluator.transform_to_ntt_inplace(encrypted);
+                    const std::uint64_t *selected = row(block * coeff_count + index);
+                    multiply_accumulate(encrypted.data(0), selected, acc.data(), coeff_count, coeff_modulus, scratch.data());
+                    multiply_accumulate(encrypted.data(1), selected, acc.data() + row_words_, coeff_count, coeff_modulus,
+                                        scratch.data());
+                    return;
+                }
+                std::size_t step = std::size_t(1) << level;
+                Ciphertext right;
+                bool has_right = index + step < items;
+                expander.split(encrypted, level, has_right ? &right : nullptr);
+                visit(encrypted, block, level + 1, index);
+                if (has_right) visit(right, block, level + 1, index + step);
+            };
+
+            std::size_t first = c * chunk_size;
+            std::size_t last = std::min(frontier.size(), first + chunk_size);
+            for (std::size_t i = first; i < last; i++) {
+                auto &node = frontier[i];
+                visit(node.encrypted, node.block, node.level, node.index);
+            }
+        }
+    });
+
+    Ciphertext result = query.front();
+    if (!ntt_form) evaluator.transform_to_ntt_inplace(result);
+    std::fill_n(result.data(), 2 * row_words_, std::uint64_t(0));
+    for (auto &acc : partials) {
+        if (acc.empty()) continue;
+        for (std::size_t j = 0; j < coeff_modulus.size(); j++) {
+            for (std::size_t i = 0; i < 2; i++) {
+                std::size_t offset = i * row_words_ + j * coeff_count;
+                add_poly_coeffmod(result.data() + offset, acc.data() + offset, coeff_count, coeff_modulus[j],
+                                  result.data() + offset);
+            }
+        }
+    }
+    if (!ntt_form) evaluator.transform_from_ntt_inplace(result);
+    if (compress_response) evaluator.mod_switch_to_inplace(result, context_->last_parms_id());
+
+    double elapsed = seconds_since(start);
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.queries++;
+    stats_.last_query_seconds = elapsed;
+    stats_.total_query_seconds += elapsed;
+    return result;
+}
+
+std::vector<seal_byte> PIRServer::process_query(const std::vector<std::string> &query, const GaloisKeys &galois_keys,
+                                                bool compress_response) const {
+    std::vector<Ciphertext> encrypted(query.size());
+    std::size_t query_bytes = 0;
+    for (std::size_t i = 0; i < query.size(); i++) {
+        encrypted[i].load(*context_, reinterpret_cast<const seal_byte *>(query[i].data()), query[i].size());
+        query_bytes += query[i].size();
+    }
+
+    auto result = answer(encrypted, galois_keys, compress_response);
+    std::vector<seal_byte> out(static_cast<std::size_t>(result.save_size()));
+    out.resize(static_cast<std::size_t>(result.save(out.data(), out.size())));
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.last_query_bytes = query_bytes;
+    stats_.last_response_bytes = out.size();
+    return out;
+}
+
+PIRStats PIRServer::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+void PIRServer::reset_stats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = PIRStats();
+}
+
+PIRClient::PIRClient(std::shared_ptr<SEALContext> context, const SecretKey &secret_key)
+    : context_(std::move(context)), encryptor_(*context_, secret_key), decryptor_(*context_, secret_key),
+      encoder_(*context_) {
+    check_batching(*context_);
+}
+
+std::vector<std::uint32_t> PIRClient::galois_elts(const SEALContext &context, std::size_t item_count) {
+    check_batching(context);
+    std::size_t coeff_count = context.first_context_data()->parms().poly_modulus_degree();
+    std::vector<std::uint32_t> elts;
+    for (std::size_t level = 0; level < expansion_levels(std::min(item_count, coeff_count)); level++) {
+        elts.push_back(expansion_elt(coeff_count, level));
+    }
+    return elts;
+}
+
+std::vector<std::vector<seal_byte>> PIRClient::query(std::size_t index, std::size_t item_count) const {
+    if (index >= item_count) throw std::invalid_argument("index is out of range");
+    auto &parms = context_->first_context_data()->parms();
+    std::size_t coeff_count = parms.poly_modulus_degree();
+    auto &plain_modulus = parms.plain_modulus();
+
+    std::vector<std::vector<seal_byte>> result;
+    for (std::size_t block = 0; block < block_count(item_count, coeff_count); block++) {
+        Plaintext plain(coeff_count);
+        if (block == index / coeff_count) {
+            // Expansion multiplies the selected coefficient by 2^levels; pre-scale
+            // by its inverse so each selection ciphertext encrypts 0 or 1
+            std::size_t levels = expansion_levels(block_items(item_count, coeff_count, block));
+            std::uint64_t scaled = barrett_reduce_64(std::uint64_t(1) << levels, plain_modulus);
+            std::uint64_t inverse;
+            if (!try_invert_uint_mod(scaled, plain_modulus, inverse)) {
+                throw std::logic_error("plain modulus must be odd");
+            }
+            plain[index % coeff_count] = inverse;
+        }
+
+        // Seeded symmetric encryption halves the upload
+        auto encrypted = encryptor_.encrypt_symmetric(plain);
+        std::vector<seal_byte> out(static_cast<std::size_t>(encrypted.save_size()));
+        out.resize(static_cast<std::size_t>(encrypted.save(out.data(), out.size())));
+        result.push_back(std::move(out));
+    }
+    return result;
+}
+
+std::vector<std::uint64_t> PIRClient::decode(const Ciphertext &answer) const {
+    Plaintext plain;
+    decryptor_.decrypt(answer, plain);
+    std::vector<std::uint64_t> values;
+    encoder_.decode(plain, values);
+    return values;
+}
+
+std::vector<std::uint64_t> PIRClient::decode(const seal_byte *data, std::size_t size) const {
+    Ciphertext answer;
+    answer.load(*context_, data, size);
+    return decode(answer);
+}
+
+int PIRClient::noise_budget(const Ciphertext &answer) const {
+    return decryptor_.invariant_noise_budget(answer);
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "batch_evaluator.h"
+#include "mapped_file.h"
+#include <seal/batchencoder.h>
+#include <seal/encryptor.h>
+#include <seal/decryptor.h>
+#include <seal/secretkey.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct PIRStats {
+    std::uint64_t queries = 0;
+    double last_query_seconds = 0;
+    double total_query_seconds = 0;
+    std::size_t last_query_bytes = 0;
+    std::size_t last_response_bytes = 0;
+};
+
+// Single-server PIR over a plaintext database (BFV or BGV with batching).
+// Item i is one BatchEncoder row of up to poly_modulus_degree values modulo
+// the plain modulus. Rows are stored preprocessed as NTT-form plaintexts at the
+// first data level, so answering a query is a fused multiply-accumulate.
+//
+// A query is one ciphertext per block of poly_modulus_degree items; the block
+// holding the wanted index encrypts the monomial X^(index % N). The server
+// expands each query ciphertext obliviously into one encrypted selection bit
+// per item using the Galois elements N / 2^j + 1 (see PIRClient::galois_elts).
+class PIRServer {
+public:
+    explicit PIRServer(std::shared_ptr<seal::SEALContext> context, std::size_t threads = 0);
+
+    // Encodes and transforms rows in parallel; each row has at most
+    // poly_modulus_degree values, shorter rows are zero padded
+    void set_database(const std::vector<std::vector<std::uint64_t>> &rows);
+
+    // Writes the preprocessed database; load_database maps it back without
+    // re-encoding. The file is tied to the context's first parms_id.
+    void save_database(const std::string &path) const;
+    void load_database(const std::string &path);
+
+    std::size_t item_count() const noexcept { return item_count_; }
+    std::size_t database_bytes() const noexcept { return item_count_ * row_words_ * sizeof(std::uint64_t); }
+    bool mapped() const noexcept { return mapped_ != nullptr; }
+
+    // Expands the query and returns the selected row. With compress_response
+    // the answer is switched to the last level to shrink it.
+    seal::Ciphertext answer(const std::vector<seal::Ciphertext> &query, const seal::GaloisKeys &galois_keys,
+                            bool compress_response = true) const;
+
+    // Wire form of answer: serialized query ciphertexts in, serialized answer out
+    std::vector<seal::seal_byte> process_query(const std::vector<std::string> &query,
+                                               const seal::GaloisKeys &galois_keys,
+                                               bool compress_response = true) const;
+
+    PIRStats stats() const;
+    void reset_stats();
+
+private:
+    const std::uint64_t *row(std::size_t index) const noexcept { return data_ + index * row_words_; }
+
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    seal::parms_id_type parms_id_;
+    std::size_t row_words_;
+
+    std::size_t item_count_ = 0;
+    std::vector<std::uint64_t> rows_;
+    std::unique_ptr<MappedFile> mapped_;
+    const std::uint64_t *data_ = nullptr;
+
+    mutable std::mutex stats_mutex_;
+    mutable PIRStats stats_;
+};
+
+// Client side: builds compressed (seeded, symmetric) queries and decodes answers
+class PIRClient {
+public:
+    PIRClient(std::shared_ptr<seal::SEALContext> context, const seal::SecretKey &secret_key);
+
+    // Galois elements the server needs to expand queries over item_count items
+    static std::vector<std::uint32_t> galois_elts(const seal::SEALContext &context, std::size_t item_count);
+
+    // One serialized ciphertext per block of poly_modulus_degree items
+    std::vector<std::vector<seal::seal_byte>> query(std::size_t index, std::size_t item_count) const;
+
+    std::vector<std::uint64_t> decode(const seal::Ciphertext &answer) const;
+    std::vector<std::uint64_t> decode(const seal::seal_byte *data, std::size_t size) const;
+
+    int noise_budget(const seal::Ciphertext &answer) const;
+
+private:
+    std::shared_ptr<seal::SEALContext> context_;
+    seal::Encryptor encryptor_;
+    mutable seal::Decryptor decryptor_;
+    seal::BatchEncoder encoder_;
+};
@@ -0,0 +1,152 @@
+#include "prng_pool.h"
+#include "thread_pool.h"
+#include <seal/encryptor.h>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+using namespace seal;
+
+namespace {
+    // Handed to the base class as its default seed, so the base create()
+    // calls create_impl with it instead of drawing a seed from the OS. Any
+    // other seed reaching create_impl came from an explicit create(seed).
+    constexpr prng_seed_type pooled_marker = { 0x506f6f6c65645052ULL, 0x4e47466163746f72ULL, 0x9e3779b97f4a7c15ULL,
+                                               0xbf58476d1ce4e5b9ULL, 0x94d049bb133111ebULL, 0x2545f4914f6cdd1dULL,
+                                               0x27d4eb2f165667c5ULL, 0x165667b19e3779f9ULL };
+
+    // Seeds of the derived streams are buffered this many at a time
+    constexpr std::size_t stream_seeds_per_refill = 64;
+
+    std::atomic<std::uint64_t> next_factory_id{ 1 };
+
+    struct ThreadStream {
+        // Expires with the factory
+        std::weak_ptr<const void> owner;
+        std::shared_ptr<UniformRandomGenerator> stream;
+    };
+
+    // Per-thread seed streams, keyed by factory id so a factory allocated at
+    // a dead factory's address never inherits its stream
+    thread_local std::unordered_map<std::uint64_t, ThreadStream> thread_streams;
+
+    // The calling thread's entry for a factory; adding one first drops the
+    // entries of factories destroyed since, so the map stays as large as the
+    // set of live factories the thread has used
+    ThreadStream &thread_entry(std::uint64_t id, const std::shared_ptr<const void> &owner) {
+        auto it = thread_streams.find(id);
+        if (it != thread_streams.end()) return it->second;
+        for (auto entry = thread_streams.begin(); entry != thread_streams.end();) {
+            entry = entry->second.owner.expired() ? thread_streams.erase(entry) : std::next(entry);
+        }
+        auto &entry = thread_streams[id];
+        entry.owner = owner;
+        return entry;
+    }
+
+    void check_backend(prng_type backend) {
+        if (backend != prng_type::blake2xb && backend != prng_type::shake256) {
+            throw std::invalid_argument("backend must be blake2xb or shake256");
+        }
+    }
+
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+PooledPRNGFactory::PooledPRNGFactory(prng_type backend, std::size_t buffer_size)
+    : UniformRandomGeneratorFactory(pooled_marker), backend_(backend), buffer_size_(buffer_size),
+      deterministic_(false), id_(next_factory_id++) {
+    check_backend(backend_);
+    if (!buffer_size_) throw std::invalid_argument("buffer_size must be positive");
+}
+
+PooledPRNGFactory::PooledPRNGFactory(prng_type backend, std::size_t buffer_size, const prng_seed_type &seed)
+    : UniformRandomGeneratorFactory(pooled_marker), backend_(backend), buffer_size_(buffer_size),
+      deterministic_(true), master_seed_(seed), id_(next_factory_id++) {
+    check_backend(backend_);
+    if (!buffer_size_) throw std::invalid_argument("buffer_size must be positive");
+}
+
+std::shared_ptr<UniformRandomGenerator> PooledPRNGFactory::make(const prng_seed_type &seed,
+                                                               std::size_t buffer_size) const {
+    if (backend_ == prng_type::shake256) return std::make_shared<Shake256PRNG>(seed, buffer_size);
+    return std::make_shared<Blake2xbPRNG>(seed, buffer_size);
+}
+
+UniformRandomGenerator &PooledPRNGFactory::thread_stream() {
+    auto &stream = thread_entry(id_, lifetime_).stream;
+    if (!stream) {
+        prng_seed_type seed;
+        std::uint64_t ordinal = threads_++;
+        if (deterministic_) {
+            seed = master_seed_;
+            seed[0] ^= ordinal;
+        } else {
+            random_bytes(reinterpret_cast<seal_byte *>(seed.data()), prng_seed_byte_count);
+        }
+        stream = make(seed, stream_seeds_per_refill * prng_seed_byte_count);
+    }
+    return *stream;
+}
+
+void PooledPRNGFactory::set_thread_seed(const prng_seed_type &seed) {
+    auto &stream = thread_entry(id_, lifetime_).stream;
+    if (!stream) threads_++;
+    stream = make(seed, stream_seeds_per_refill * prng_seed_byte_count);
+}
+
+auto PooledPRNGFactory::create_impl(prng_seed_type seed) -> std::shared_ptr<UniformRandomGenerator> {
+    if (seed == pooled_marker) {
+        thread_stream().generate(prng_seed_byte_count, reinterpret_cast<seal_byte *>(seed.data()));
+    }
+    generators_++;
+    return make(seed, buffer_size_);
+}
+
+PooledPRNGFactory::Stats PooledPRNGFactory::stats() const {
+    Stats stats;
+    stats.generators = generators_.load();
+    stats.threads = threads_.load();
+    return stats;
+}
+
+ThroughputResult benchmark_prng(UniformRandomGeneratorFactory &factory, std::size_t count,
+                                std::size_t bytes_per_generator, std::size_t threads) {
+    ThreadPool pool(threads);
+    auto start = std::chrono::steady_clock::now();
+    pool.parallel_for(count, [&](std::size_t begin, std::size_t end) {
+        std::vector<seal_byte> buffer(bytes_per_generator);
+        for (std::size_t i = begin; i < end; i++) factory.create()->generate(buffer.size(), buffer.data());
+    });
+    ThroughputResult result;
+    result.seconds = seconds_since(start);
+    result.count = count;
+    result.bytes = static_cast<std::uint64_t>(count) * bytes_per_generator;
+    return result;
+}
+
+ThroughputResult benchmark_encryption(const SEALContext &context, const PublicKey &public_key, const Plaintext &plain,
+                                      std::size_t count, std::size_t threads, const SecretKey *secret_key) {
+    Encryptor encryptor(context, public_key);
+    if (secret_key) encryptor.set_secret_key(*secret_key);
+    ThreadPool pool(threads);
+    auto start = std::chrono::steady_clock::now();
+    pool.parallel_for(count, [&](std::size_t begin, std::size_t end) {
+        Ciphertext encrypted;
+        for (std::size_t i = begin; i < end; i++) {
+            if (secret_key) {
+                encryptor.encrypt_symmetric(plain, encrypted);
+            } else {
+                encryptor.encrypt(plain, encrypted);
+            }
+        }
+    });
+    ThroughputResult result;
+    result.seconds = seconds_since(start);
+    result.count = count;
+    return result;
+}
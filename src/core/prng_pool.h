@@ -0,0 +1,78 @@
+#pragma once
+#include <seal/randomgen.h>
+#include <seal/context.h>
+#include <seal/publickey.h>
+#include <seal/secretkey.h>
+#include <seal/plaintext.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// PRNG factory that avoids seeding every generator from the OS. Each thread
+// keeps its own seed stream (a buffered PRNG of the same backend, seeded from
+// the OS once or derived from a master seed) and every generator SEAL asks for
+// is seeded with the next 64 bytes of it, so create() makes no system calls
+// and threads never share state.
+//
+// SEAL takes the factory from the encryption parameters, so an Encryptor uses
+// it when built on a context whose parameters had it set with
+// set_random_generator. Seeds passed explicitly to create(seed) are honoured.
+class PooledPRNGFactory : public seal::UniformRandomGeneratorFactory {
+public:
+    // backend is blake2xb or shake256; buffer_size is the output each
+    // generator buffers per refill
+    explicit PooledPRNGFactory(seal::prng_type backend = seal::prng_type::blake2xb, std::size_t buffer_size = 4096);
+
+    // Deterministic: the n-th thread to use the factory derives its stream
+    // from seed and n, so single-threaded runs are reproducible
+    PooledPRNGFactory(seal::prng_type backend, std::size_t buffer_size, const seal::prng_seed_type &seed);
+
+    // Restarts the calling thread's seed stream from seed, for reproducible
+    // runs where each worker thread is seeded explicitly
+    void set_thread_seed(const seal::prng_seed_type &seed);
+
+    seal::prng_type backend() const noexcept { return backend_; }
+    std::size_t buffer_size() const noexcept { return buffer_size_; }
+
+    struct Stats {
+        std::uint64_t generators = 0;
+        std::uint64_t threads = 0;
+    };
+    Stats stats() const;
+
+protected:
+    auto create_impl(seal::prng_seed_type seed) -> std::shared_ptr<seal::UniformRandomGenerator> override;
+
+private:
+    std::shared_ptr<seal::UniformRandomGenerator> make(const seal::prng_seed_type &seed, std::size_t buffer_size) const;
+    seal::UniformRandomGenerator &thread_stream();
+
+    seal::prng_type backend_;
+    std::size_t buffer_size_;
+    bool deterministic_;
+    seal::prng_seed_type master_seed_{};
+    std::uint64_t id_;
+
+    // Watched by the per-thread streams so they can be dropped once the
+    // factory is gone
+    std::shared_ptr<const void> lifetime_ = std::make_shared<char>();
+    std::atomic<std::uint64_t> generators_{ 0 };
+    std::atomic<std::uint64_t> threads_{ 0 };
+};
+
+struct ThroughputResult {
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+    double seconds = 0;
+};
+
+// Creates count generators from factory on threads workers and draws
+// bytes_per_generator from each
+ThroughputResult benchmark_prng(seal::UniformRandomGeneratorFactory &factory, std::size_t count,
+                                std::size_t bytes_per_generator, std::size_t threads);
+
+// Encrypts plain count times on threads workers with one shared Encryptor;
+// symmetric when secret_key is given. The PRNG is the context's factory.
+ThroughputResult benchmark_encryption(const seal::SEALContext &context, const seal::PublicKey &public_key,
+                                      const seal::Plaintext &plain, std::size_t count, std::size_t threads,
+                                      const seal::SecretKey *secret_key = nullptr);
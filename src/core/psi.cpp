@@ -0,0 +1,391 @@
+#include "psi.h"
+#include <seal/randomgen.h>
+#include <seal/util/uintarithsmallmod.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+
+using namespace seal;
+using namespace seal::util;
+
+namespace {
+    void check_context(const SEALContext &context) {
+        if (!context.parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+        if (context.first_context_data()->parms().scheme() != scheme_type::bfv) {
+            throw std::invalid_argument("PSI requires the BFV scheme");
+        }
+        if (!context.first_context_data()->qualifiers().using_batching) {
+            throw std::invalid_argument("encryption parameters are not valid for batching");
+        }
+        if (!context.using_keyswitching()) throw std::logic_error("keyswitching is not supported by the context");
+    }
+
+    void check_params(const PSIParams &params) {
+        if (params.hash_count < 2 || params.hash_count > 8) throw std::invalid_argument("hash_count must be 2 to 8");
+        if (params.partition_size == 0) throw std::invalid_argument("partition_size must be positive");
+        if (params.window == 0 || params.window > 16) throw std::invalid_argument("window must be 1 to 16");
+    }
+
+    std::uint64_t mix(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // Hash function i: independent keyed mixes for the bin and the value
+    class ItemHash {
+    public:
+        ItemHash(const PSIParams &params, std::size_t bins, std::uint64_t plain_modulus)
+            : bins_(bins), plain_modulus_(plain_modulus) {
+            for (std::uint64_t i = 0; i < params.hash_count; i++) {
+                bin_keys_.push_back(mix(params.seed + 2 * i));
+                value_keys_.push_back(mix(params.seed + 2 * i + 1));
+            }
+        }
+
+        std::size_t bin(std::uint64_t item, std::size_t i) const {
+            return static_cast<std::size_t>(mix(item ^ bin_keys_[i]) % bins_);
+        }
+
+        std::uint64_t value(std::uint64_t item, std::size_t i) const {
+            return mix(item ^ value_keys_[i]) % plain_modulus_;
+        }
+
+    private:
+        std::uint64_t bins_, plain_modulus_;
+        std::vector<std::uint64_t> bin_keys_, value_keys_;
+    };
+
+    // Exponents i * 2^(window * j) <= partition_size the receiver sends
+    std::vector<std::size_t> source_exponents(const PSIParams &params) {
+        std::size_t base = std::size_t(1) << params.window;
+        std::vector<std::size_t> exponents;
+        for (std::size_t power = 1; power <= params.partition_size; power *= base) {
+            for (std::size_t i = 1; i < base && i * power <= params.partition_size; i++) {
+                exponents.push_back(i * power);
+            }
+            if (power > params.partition_size / base) break;
+        }
+        return exponents;
+    }
+
+    // Nonzero base-2^window digits of k, lowest first, as digit * 2^(window * j)
+    std::vector<std::size_t> digit_terms(std::size_t k, std::size_t window) {
+        std::vector<std::size_t> terms;
+        std::size_t base = std::size_t(1) << window;
+        for (std::size_t power = 1; k; power *= base, k /= base) {
+            if (k % base) terms.push_back((k % base) * power);
+        }
+        return terms;
+    }
+
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+PSISender::PSISender(std::shared_ptr<SEALContext> context, const PSIParams &params, std::size_t threads)
+    : context_(std::move(context)), batch_(context_, threads), encoder_(*context_), params_(params),
+      parms_id_(context_->first_parms_id()) {
+    check_context(*context_);
+    check_params(params_);
+}
+
+void PSISender::set_items(const std::vector<std::uint64_t> &items) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::uint64_t> unique(items);
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    // Simple hashing: every item goes to the bins of all its hash functions
+    std::size_t slots = encoder_.slot_count();
+    auto &plain_modulus = context_->first_context_data()->parms().plain_modulus();
+    ItemHash hash(params_, slots, plain_modulus.value());
+    std::vector<std::vector<std::uint64_t>> bins(slots);
+    for (auto item : unique) {
+        for (std::size_t i = 0; i < params_.hash_count; i++) bins[hash.bin(item, i)].push_back(hash.value(item, i));
+    }
+    std::size_t load = 0;
+    for (auto &bin : bins) load = std::max(load, bin.size());
+    std::size_t degree = params_.partition_size;
+    std::size_t partitions = (load + degree - 1) / degree;
+
+    // table[(p * (degree + 1) + k) * slots + b]: coefficient k of bin b's
+    // polynomial in partition p
+    std::vector<std::uint64_t> table(partitions * (degree + 1) * slots);
+    batch_.pool().parallel_for(slots, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::uint64_t> poly(degree + 1);
+        for (std::size_t b = begin; b < end; b++) {
+            for (std::size_t p = 0; p < partitions; p++) {
+                std::fill(poly.begin(), poly.end(), 0);
+                poly[0] = 1;
+                std::size_t first = std::min(bins[b].size(), p * degree);
+                std::size_t last = std::min(bins[b].size(), first + degree);
+                for (std::size_t r = first; r < last; r++) {
+                    std::uint64_t root = bins[b][r];
+                    for (std::size_t k = r - first + 1; k > 0; k--) {
+                        poly[k] = sub_uint_mod(poly[k - 1], multiply_uint_mod(root, poly[k], plain_modulus),
+                                               plain_modulus);
+                    }
+                    poly[0] = negate_uint_mod(multiply_uint_mod(root, poly[0], plain_modulus), plain_modulus);
+                }
+                for (std::size_t k = 0; k <= degree; k++) table[(p * (degree + 1) + k) * slots + b] = poly[k];
+            }
+        }
+    });
+
+    std::vector<Plaintext> coefficients(partitions * degree), constants(partitions);
+    batch_.pool().parallel_for(partitions * (degree + 1), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t p = i / (degree + 1), k = i % (degree + 1);
+            std::vector<std::uint64_t> values(table.begin() + static_cast<std::ptrdiff_t>(i * slots),
+                                              table.begin() + static_cast<std::ptrdiff_t>((i + 1) * slots));
+            if (k == 0) {
+                encoder_.encode(values, constants[p]);
+                continue;
+            }
+            auto &plain = coefficients[p * degree + k - 1];
+            encoder_.encode(values, plain);
+            batch_.evaluator().transform_to_ntt_inplace(plain, parms_id_);
+        }
+    });
+
+    coefficients_ = std::move(coefficients);
+    constants_ = std::move(constants);
+    item_count_ = unique.size();
+    bin_load_ = load;
+    partitions_ = partitions;
+    has_items_ = true;
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.preprocess_seconds = seconds_since(start);
+}
+
+std::vector<Ciphertext> PSISender::respond(const std::vector<Ciphertext> &query, const RelinKeys &relin_keys) const {
+    if (!has_items_) throw std::logic_error("items have not been set");
+    auto exponents = source_exponents(params_);
+    if (query.size() != exponents.size()) throw std::invalid_argument("query has the wrong number of ciphertexts");
+    for (auto &encrypted : query) {
+        if (encrypted.parms_id() != parms_id_) throw std::invalid_argument("query is not at the first data level");
+        if (encrypted.size() != 2) throw std::invalid_argument("query ciphertexts must have size 2");
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto &evaluator = batch_.evaluator();
+    std::size_t degree = params_.partition_size;
+    std::vector<Ciphertext> response;
+    auto record = [&]() {
+        double elapsed = seconds_since(start);
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.queries++;
+        stats_.last_query_seconds = elapsed;
+        stats_.total_query_seconds += elapsed;
+    };
+
+    // An empty set matches nothing
+    if (!partitions_) {
+        record();
+        return response;
+    }
+
+    // x^k = x^lo * x^hi with the nonzero digits of k split in halves, so
+    // powers with n nonzero digits sit at depth ceil(log2(n)); each round
+    // only needs powers with fewer digits
+    std::vector<Ciphertext> powers(degree + 1);
+    for (std::size_t s = 0; s < exponents.size(); s++) powers[exponents[s]] = query[s];
+    std::vector<std::vector<std::size_t>> rounds;
+    for (std::size_t k = 1; k <= degree; k++) {
+        std::size_t digits = digit_terms(k, params_.window).size();
+        if (digits < 2) continue;
+        if (rounds.size() < digits - 1) rounds.resize(digits - 1);
+        rounds[digits - 2].push_back(k);
+    }
+    for (auto &round : rounds) {
+        batch_.pool().parallel_for(round.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::size_t k = round[i];
+                auto terms = digit_terms(k, params_.window);
+                std::size_t lo = 0;
+                for (std::size_t t = 0; t < terms.size() / 2; t++) lo += terms[t];
+                evaluator.multiply(powers[lo], powers[k - lo], powers[k]);
+                evaluator.relinearize_inplace(powers[k], relin_keys);
+            }
+        });
+    }
+    batch_.pool().parallel_for(degree, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin + 1; k <= end; k++) evaluator.transform_to_ntt_inplace(powers[k]);
+    });
+
+    // Partial sums over ranges of degrees, so a few partitions still fill
+    // the pool
+    std::size_t threads = batch_.threads();
+    std::size_t chunks = partitions_ >= threads ? 1 : std::min(degree, (threads + partitions_ - 1) / partitions_);
+    std::size_t span = (degree + chunks - 1) / chunks;
+    std::vector<Ciphertext> partial(partitions_ * chunks);
+    std::vector<char> filled(partial.size(), 0);
+    batch_.pool().parallel_for(partial.size(), [&](std::size_t begin, std::size_t end) {
+        Ciphertext term;
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t p = i / chunks, c = i % chunks;
+            for (std::size_t k = c * span + 1; k <= std::min(degree, (c + 1) * span); k++) {
+                auto &plain = coefficients_[p * degree + k - 1];
+                if (plain.is_zero()) continue;
+                evaluator.multiply_plain(powers[k], plain, filled[i] ? term : partial[i]);
+                if (filled[i]) evaluator.add_inplace(partial[i], term);
+                filled[i] = 1;
+            }
+        }
+    });
+
+    response.resize(partitions_);
+    std::vector<char> answered(partitions_, 0);
+    std::uint64_t plain_modulus = context_->first_context_data()->parms().plain_modulus().value();
+    batch_.pool().parallel_for(partitions_, [&](std::size_t begin, std::size_t end) {
+        auto random = UniformRandomGeneratorFactory::DefaultFactory()->create();
+        std::vector<std::uint64_t> mask(encoder_.slot_count());
+        Plaintext plain;
+        for (std::size_t p = begin; p < end; p++) {
+            auto &result = response[p];
+            bool first = true;
+            for (std::size_t c = 0; c < chunks; c++) {
+                if (!filled[p * chunks + c]) continue;
+                if (first) {
+                    result = partial[p * chunks + c];
+                } else {
+                    evaluator.add_inplace(result, partial[p * chunks + c]);
+                }
+                first = false;
+            }
+
+            // No terms at all: every bin's polynomial is the nonzero constant
+            if (first) continue;
+            answered[p] = 1;
+            evaluator.transform_from_ntt_inplace(result);
+            evaluator.add_plain_inplace(result, constants_[p]);
+
+            // r * P(x) for random nonzero r hides everything but the zeros
+            random->generate(mask.size() * sizeof(std::uint64_t), reinterpret_cast<seal_byte *>(mask.data()));
+            for (auto &value : mask) value = 1 + value % (plain_modulus - 1);
+            encoder_.encode(mask, plain);
+            evaluator.multiply_plain_inplace(result, plain);
+        }
+    });
+
+    std::size_t kept = 0;
+    for (std::size_t p = 0; p < partitions_; p++) {
+        if (!answered[p]) continue;
+        if (kept != p) response[kept] = std::move(response[p]);
+        kept++;
+    }
+    response.resize(kept);
+    record();
+    return response;
+}
+
+PSIStats PSISender::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+void PSISender::reset_stats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = PSIStats();
+}
+
+PSIReceiver::PSIReceiver(std::shared_ptr<SEALContext> context, const SecretKey &secret_key, const PSIParams &params)
+    : context_(std::move(context)), params_(params), encryptor_(*context_, secret_key),
+      decryptor_(*context_, secret_key), encoder_(*context_) {
+    check_context(*context_);
+    check_params(params_);
+}
+
+std::size_t PSIReceiver::query_size() const {
+    return source_exponents(params_).size();
+}
+
+std::size_t PSIReceiver::depth() const {
+    std::size_t digits = 0, depth = 0;
+    for (std::size_t k = 1; k <= params_.partition_size; k++) {
+        digits = std::max(digits, digit_terms(k, params_.window).size());
+    }
+    while ((std::size_t(1) << depth) < digits) depth++;
+    return depth;
+}
+
+PSIQuery PSIReceiver::query(const std::vector<std::uint64_t> &items) const {
+    PSIQuery query;
+    std::unordered_set<std::uint64_t> seen;
+    for (auto item : items) {
+        if (seen.insert(item).second) query.items.push_back(item);
+    }
+    std::size_t slots = encoder_.slot_count();
+    if (query.items.size() > slots) throw std::invalid_argument("more items than slots");
+
+    // Cuckoo hashing: an item takes a free bin among its hash functions' or
+    // evicts the occupant of a random one, which is then reinserted
+    constexpr std::size_t max_evictions = 1000;
+    auto &plain_modulus = context_->first_context_data()->parms().plain_modulus();
+    ItemHash hash(params_, slots, plain_modulus.value());
+    query.table.assign(slots, -1);
+    std::vector<std::size_t> choice(slots, 0);
+    std::mt19937_64 rng(mix(params_.seed));
+    for (std::size_t index = 0; index < query.items.size(); index++) {
+        auto current = static_cast<std::int64_t>(index);
+        for (std::size_t evictions = 0;; evictions++) {
+            auto item = query.items[static_cast<std::size_t>(current)];
+            bool placed = false;
+            for (std::size_t i = 0; i < params_.hash_count && !placed; i++) {
+                std::size_t b = hash.bin(item, i);
+                if (query.table[b] >= 0) continue;
+                query.table[b] = current;
+                choice[b] = i;
+                placed = true;
+            }
+            if (placed) break;
+            if (evictions == max_evictions) throw std::runtime_error("cuckoo hashing failed; query fewer items");
+            auto i = static_cast<std::size_t>(rng() % params_.hash_count);
+            std::size_t b = hash.bin(item, i);
+            std::swap(current, query.table[b]);
+            choice[b] = i;
+        }
+    }
+
+    std::vector<std::uint64_t> values(slots, 0), powered(slots);
+    for (std::size_t b = 0; b < slots; b++) {
+        if (query.table[b] < 0) continue;
+        values[b] = hash.value(query.items[static_cast<std::size_t>(query.table[b])], choice[b]);
+    }
+    Plaintext plain;
+    for (auto exponent : source_exponents(params_)) {
+        for (std::size_t b = 0; b < slots; b++) powered[b] = exponentiate_uint_mod(values[b], exponent, plain_modulus);
+        encoder_.encode(powered, plain);
+        query.ciphertexts.emplace_back();
+        encryptor_.encrypt_symmetric(plain, query.ciphertexts.back());
+    }
+    return query;
+}
+
+std::vector<std::uint64_t> PSIReceiver::intersect(const PSIQuery &query,
+                                               const std::vector<Ciphertext> &response) const {
+    if (query.table.size() != encoder_.slot_count()) throw std::invalid_argument("query does not match the context");
+    std::vector<char> found(query.items.size(), 0);
+    Plaintext plain;
+    std::vector<std::uint64_t> values;
+    for (auto &encrypted : response) {
+        decryptor_.decrypt(encrypted, plain);
+        encoder_.decode(plain, values);
+        for (std::size_t b = 0; b < values.size(); b++) {
+            if (query.table[b] >= 0 && values[b] == 0) found[static_cast<std::size_t>(query.table[b])] = 1;
+        }
+    }
+    std::vector<std::uint64_t> result;
+    for (std::size_t i = 0; i < query.items.size(); i++) {
+        if (found[i]) result.push_back(query.items[i]);
+    }
+    return result;
+}
+
+int PSIReceiver::noise_budget(const Ciphertext &response) const {
+    return decryptor_.invariant_noise_budget(response);
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include "batch_evaluator.h"
+#include <seal/batchencoder.h>
+#include <seal/ciphertext.h>
+#include <seal/decryptor.h>
+#include <seal/encryptor.h>
+#include <seal/plaintext.h>
+#include <seal/relinkeys.h>
+#include <seal/secretkey.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Protocol parameters; sender and receiver must agree on all of them
+struct PSIParams {
+    // Cuckoo hash functions (2 to 8)
+    std::size_t hash_count = 3;
+
+    // Sender items per bin polynomial, i.e. its degree
+    std::size_t partition_size = 32;
+
+    // The receiver sends x^(i * 2^(window * j)) for 1 <= i < 2^window; more
+    // bits mean more query ciphertexts and a shallower power computation
+    std::size_t window = 3;
+
+    std::uint64_t seed = 0;
+};
+
+struct PSIStats {
+    std::uint64_t queries = 0;
+    double preprocess_seconds = 0;
+    double last_query_seconds = 0;
+    double total_query_seconds = 0;
+};
+
+// The receiver's hashed set: query ciphertexts go to the sender, the bin
+// table stays with the receiver to read the response
+struct PSIQuery {
+    std::vector<seal::Ciphertext> ciphertexts;
+    std::vector<std::uint64_t> items;
+
+    // Index into items of the item cuckoo-hashed into each bin, or -1
+    std::vector<std::int64_t> table;
+};
+
+// Unbalanced private set intersection over BFV batching (Chen-Laine-Rindal).
+// There is one bin per slot and items are 64-bit integers (hash wider keys
+// first). Hash function i maps an item to a bin and to a value modulo the
+// plain modulus t. The receiver cuckoo-hashes its set so every bin holds at
+// most one value x; the sender inserts each of its items under every hash
+// function and splits each bin into partitions of partition_size values,
+// encoding the coefficients of P(z) = prod (z - y) for every partition as one
+// plaintext per degree, batched over the bins.
+//
+// The response holds, per partition, r * P(x) in every bin for random nonzero
+// r: zero exactly where x is one of the partition's roots. A receiver item
+// also matches by accident with probability about (bin load) / t, so t should
+// be large compared with the number of values per bin. The response is
+// re-randomized by r but not noise flooded.
+class PSISender {
+public:
+    PSISender(std::shared_ptr<seal::SEALContext> context, const PSIParams &params = PSIParams(),
+              std::size_t threads = 0);
+
+    // Hashes, bins and encodes the set; the coefficient plaintexts are kept
+    // in NTT form so answering is a fused multiply-accumulate
+    void set_items(const std::vector<std::uint64_t> &items);
+
+    std::size_t item_count() const noexcept { return item_count_; }
+    std::size_t bin_load() const noexcept { return bin_load_; }
+    std::size_t partition_count() const noexcept { return partitions_; }
+
+    // Computes x^1 .. x^partition_size from the windowed powers, one level
+    // of products at a time, and evaluates every partition's polynomial;
+    // partitions (and, when there are fewer than threads, ranges of their
+    // terms) run in parallel. At most one ciphertext per partition; an empty
+    // set gives an empty response.
+    std::vector<seal::Ciphertext> respond(const std::vector<seal::Ciphertext> &query,
+                                          const seal::RelinKeys &relin_keys) const;
+
+    PSIStats stats() const;
+    void reset_stats();
+
+private:
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    seal::BatchEncoder encoder_;
+    PSIParams params_;
+    seal::parms_id_type parms_id_;
+
+    std::size_t item_count_ = 0;
+    std::size_t bin_load_ = 0;
+    std::size_t partitions_ = 0;
+    bool has_items_ = false;
+
+    // coefficients_[p * partition_size + k - 1] holds degree k of partition
+    // p in NTT form; constants_[p] holds degree 0
+    std::vector<seal::Plaintext> coefficients_;
+    std::vector<seal::Plaintext> constants_;
+
+    mutable std::mutex stats_mutex_;
+    mutable PSIStats stats_;
+};
+
+class PSIReceiver {
+public:
+    PSIReceiver(std::shared_ptr<seal::SEALContext> context, const seal::SecretKey &secret_key,
+                const PSIParams &params = PSIParams());
+
+    // Query ciphertexts per query: (2^window - 1) per base-2^window digit of
+    // partition_size
+    std::size_t query_size() const;
+
+    // Multiplicative depth of the sender's power computation
+    std::size_t depth() const;
+
+    // At most slot_count() distinct items; duplicates are dropped. Throws
+    // std::runtime_error when cuckoo hashing fails, which becomes likely
+    // above about 90% of the slots.
+    PSIQuery query(const std::vector<std::uint64_t> &items) const;
+
+    // The query's items found in the sender's set, in query order
+    std::vector<std::uint64_t> intersect(const PSIQuery &query, const std::vector<seal::Ciphertext> &response) const;
+
+    int noise_budget(const seal::Ciphertext &response) const;
+
+private:
+    std::shared_ptr<seal::SEALContext> context_;
+    PSIParams params_;
+    seal::Encryptor encryptor_;
+    mutable seal::Decryptor decryptor_;
+    seal::BatchEncoder encoder_;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include "cpu_dispatch.h"
+#include <seal/modulus.h>
+#include <seal/util/polyarithsmallmod.h>
+#include <cstdint>
+#include <vector>
+
+// Limb-level helpers shared by the native kernels. Polynomials are laid out as
+// SEAL stores them: coeff_modulus.size() consecutive limbs of coeff_count words.
+
+// acc += x * y over every RNS limb (NTT form). The hexl backend multiplies
+// into scratch (one limb) and adds; the others run one fused pass per limb.
+inline void multiply_accumulate(const std::uint64_t *x, const std::uint64_t *y, std::uint64_t *acc,
+                                std::size_t coeff_count, const std::vector<seal::Modulus> &coeff_modulus,
+                                std::uint64_t *scratch, const KernelTable &table) {
+    for (std::size_t j = 0; j < coeff_modulus.size(); j++) {
+        std::size_t offset = j * coeff_count;
+        if (table.backend == KernelBackend::hexl) {
+            seal::util::dyadic_product_coeffmod(x + offset, y + offset, coeff_count, coeff_modulus[j], scratch);
+            seal::util::add_poly_coeffmod(acc + offset, scratch, coeff_count, coeff_modulus[j], acc + offset);
+        } else {
+            table.multiply_accumulate_limb(x + offset, y + offset, acc + offset, coeff_count, coeff_modulus[j].value(),
+                                           coeff_modulus[j].const_ratio().data());
+        }
+    }
+}
+
+inline void multiply_accumulate(const std::uint64_t *x, const std::uint64_t *y, std::uint64_t *acc,
+                                std::size_t coeff_count, const std::vector<seal::Modulus> &coeff_modulus,
+                                std::uint64_t *scratch) {
+    multiply_accumulate(x, y, acc, coeff_count, coeff_modulus, scratch, kernels());
+}
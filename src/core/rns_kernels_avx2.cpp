@@ -0,0 +1,7 @@
+// AVX2 + BMI2 build of the fused RNS kernels; CMakeLists.txt compiles only
+// this file with -mavx2 -mbmi2, and it is only called when CPUID reports both
+#include <cstddef>
+#include <cstdint>
+
+#define RNS_KERNEL_VARIANT avx2
+#include "rns_kernels_variant.inc"
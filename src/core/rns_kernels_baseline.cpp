@@ -0,0 +1,6 @@
+// Plain x86-64 build of the fused RNS kernels
+#include <cstddef>
+#include <cstdint>
+
+#define RNS_KERNEL_VARIANT baseline
+#include "rns_kernels_variant.inc"
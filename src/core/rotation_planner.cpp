@@ -0,0 +1,282 @@
+#include "rotation_planner.h"
+#include "bsgs.h"
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using namespace seal;
+
+namespace {
+    constexpr std::uint32_t unreachable = std::numeric_limits<std::uint32_t>::max();
+
+    std::size_t rotation_slots(const SEALContext &context) {
+        if (!context.parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+        return context.key_context_data()->parms().poly_modulus_degree() / 2;
+    }
+
+    std::size_t to_residue(int step, std::size_t slots) {
+        auto m = static_cast<long long>(slots);
+        auto r = static_cast<long long>(step) % m;
+        return static_cast<std::size_t>(r < 0 ? r + m : r);
+    }
+
+    // Breadth-first search from 0 over the rotation group with one edge per
+    // key step; last_key (optional) records the final key step of a shortest path
+    void shortest_paths(std::size_t slots, const std::vector<std::size_t> &keys, std::vector<std::uint32_t> &distance,
+                        std::vector<std::size_t> *last_key) {
+        distance.assign(slots, unreachable);
+        if (last_key) last_key->assign(slots, 0);
+        std::deque<std::size_t> frontier{ 0 };
+        distance[0] = 0;
+        while (!frontier.empty()) {
+            std::size_t v = frontier.front();
+            frontier.pop_front();
+            for (auto key : keys) {
+                std::size_t u = (v + key) % slots;
+                if (distance[u] != unreachable) continue;
+                distance[u] = distance[v] + 1;
+                if (last_key) (*last_key)[u] = key;
+                frontier.push_back(u);
+            }
+        }
+    }
+
+    // Residue-level plan node
+    struct Node {
+        std::size_t target;
+        std::size_t parent;
+        std::size_t key;
+        std::uint32_t depth;
+    };
+}
+
+RotationPlanner::RotationPlanner(std::shared_ptr<SEALContext> context, const GaloisKeys &galois_keys,
+                                 std::size_t threads)
+    : context_(std::move(context)), batch_(context_, threads), galois_keys_(&galois_keys),
+      slots_(rotation_slots(*context_)) {
+    for (int step : key_steps(*context_, galois_keys)) keys_.push_back(residue(step));
+    build();
+}
+
+RotationPlanner::RotationPlanner(std::shared_ptr<SEALContext> context, const std::vector<int> &key_steps)
+    : context_(std::move(context)), batch_(context_), slots_(rotation_slots(*context_)) {
+    for (int step : key_steps) {
+        std::size_t r = residue(step);
+        if (r && std::find(keys_.begin(), keys_.end(), r) == keys_.end()) keys_.push_back(r);
+    }
+    build();
+}
+
+std::vector<int> RotationPlanner::key_steps(const SEALContext &context, const GaloisKeys &galois_keys) {
+    std::size_t slots = rotation_slots(context);
+    std::uint64_t mask = 4 * static_cast<std::uint64_t>(slots) - 1;
+    std::vector<int> steps;
+    // Row rotation by r is the Galois element 3^r mod 2N
+    std::uint64_t elt = 1;
+    for (std::size_t r = 1; r < slots; r++) {
+        elt = (elt * 3) & mask;
+        if (galois_keys.has_key(static_cast<std::uint32_t>(elt))) {
+            steps.push_back(::signed_step(static_cast<long long>(r), slots));
+        }
+    }
+    return steps;
+}
+
+void RotationPlanner::build() {
+    std::uint64_t mask = 4 * static_cast<std::uint64_t>(slots_) - 1;
+    elts_.assign(slots_, 1);
+    for (std::size_t r = 1; r < slots_; r++) elts_[r] = static_cast<std::uint32_t>((elts_[r - 1] * 3ULL) & mask);
+    shortest_paths(slots_, keys_, distance_, &last_key_);
+}
+
+std::size_t RotationPlanner::residue(int step) const {
+    return to_residue(step, slots_);
+}
+
+int RotationPlanner::signed_step(std::size_t residue) const {
+    return ::signed_step(static_cast<long long>(residue), slots_);
+}
+
+const GaloisKeys &RotationPlanner::galois_keys() const {
+    if (!galois_keys_) throw std::logic_error("planner was created without Galois keys");
+    return *galois_keys_;
+}
+
+std::vector<int> RotationPlanner::key_steps() const {
+    std::vector<int> steps;
+    for (auto key : keys_) steps.push_back(signed_step(key));
+    std::sort(steps.begin(), steps.end());
+    return steps;
+}
+
+std::vector<int> RotationPlanner::decompose(int step) const {
+    std::size_t r = residue(step);
+    if (distance_[r] == unreachable) {
+        throw std::invalid_argument("step " + std::to_string(step) + " cannot be composed from the available keys");
+    }
+    std::vector<int> path;
+    while (r) {
+        std::size_t key = last_key_[r];
+        path.push_back(signed_step(key));
+        r = (r + slots_ - key) % slots_;
+    }
+    return path;
+}
+
+std::size_t RotationPlanner::cost(int step) const {
+    return decompose(step).size();
+}
+
+RotationPlanner::Plan RotationPlanner::plan(const std::vector<int> &steps) const {
+    // Walk back from the deepest targets; each node takes a predecessor one
+    // level up, preferring one some other request already needs
+    std::vector<char> needed(slots_, 0);
+    std::vector<std::vector<std::size_t>> levels;
+    Plan result;
+    for (int step : steps) {
+        std::size_t r = residue(step);
+        if (!r || needed[r]) continue;
+        if (distance_[r] == unreachable) {
+            throw std::invalid_argument("step " + std::to_string(step) + " cannot be composed from the available keys");
+        }
+        needed[r] = 1;
+        result.independent_keyswitches += distance_[r];
+        if (levels.size() <= distance_[r]) levels.resize(distance_[r] + 1);
+        levels[distance_[r]].push_back(r);
+    }
+
+    std::vector<Node> nodes;
+    for (std::size_t depth = levels.size(); depth-- > 1;) {
+        for (std::size_t i = 0; i < levels[depth].size(); i++) {
+            std::size_t v = levels[depth][i];
+            std::size_t chosen = slots_;
+            for (auto key : keys_) {
+                std::size_t p = (v + slots_ - key) % slots_;
+                if (distance_[p] != depth - 1) continue;
+                if (p == 0 || needed[p]) {
+                    chosen = key;
+                    break;
+                }
+                if (chosen == slots_) chosen = key;
+            }
+            std::size_t p = (v + slots_ - chosen) % slots_;
+            nodes.push_back({ v, p, chosen, static_cast<std::uint32_t>(depth) });
+            if (p && !needed[p]) {
+                needed[p] = 1;
+                levels[depth - 1].push_back(p);
+            }
+        }
+    }
+    std::reverse(nodes.begin(), nodes.end());
+    std::stable_sort(nodes.begin(), nodes.end(), [](const Node &a, const Node &b) { return a.depth < b.depth; });
+
+    for (auto &node : nodes) {
+        result.steps.push_back(
+            { signed_step(node.target), signed_step(node.parent), signed_step(node.key), node.depth });
+    }
+    result.keyswitches = nodes.size();
+    result.depth = levels.empty() ? 0 : levels.size() - 1;
+    return result;
+}
+
+Ciphertext RotationPlanner::rotate(const Ciphertext &encrypted, int step) const {
+    auto &keys = galois_keys();
+    Ciphertext result = encrypted;
+    for (int key : decompose(step)) batch_.evaluator().apply_galois_inplace(result, elts_[residue(key)], keys);
+    return result;
+}
+
+std::vector<Ciphertext> RotationPlanner::rotate_many(const Ciphertext &encrypted, const std::vector<int> &steps) const {
+    auto &keys = galois_keys();
+    auto plan = this->plan(steps);
+    std::unordered_map<std::size_t, std::size_t> index;
+    for (std::size_t i = 0; i < plan.steps.size(); i++) index[residue(plan.steps[i].target)] = i;
+
+    // Nodes of one depth only read the level above, so each level runs in parallel
+    std::vector<Ciphertext> values(plan.steps.size());
+    for (std::size_t begin = 0; begin < plan.steps.size();) {
+        std::size_t end = begin;
+        while (end < plan.steps.size() && plan.steps[end].depth == plan.steps[begin].depth) end++;
+        batch_.pool().parallel_for(end - begin, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = begin + first; i < begin + last; i++) {
+                auto &step = plan.steps[i];
+                std::size_t parent = residue(step.parent);
+                const Ciphertext &source = parent ? values[index.at(parent)] : encrypted;
+                batch_.evaluator().apply_galois(source, elts_[residue(step.key_step)], keys, values[i]);
+            }
+        });
+        begin = end;
+    }
+
+    std::vector<Ciphertext> result;
+    result.reserve(steps.size());
+    for (int step : steps) {
+        std::size_t r = residue(step);
+        result.push_back(r ? values[index.at(r)] : encrypted);
+    }
+    return result;
+}
+
+std::vector<int> RotationPlanner::recommend_keys(const SEALContext &context, const std::vector<int> &steps,
+                                                 const std::vector<double> &weights, std::size_t max_keys) {
+    if (!weights.empty() && weights.size() != steps.size()) {
+        throw std::invalid_argument("weights must be empty or match steps");
+    }
+    if (!max_keys) throw std::invalid_argument("max_keys must be positive");
+    std::size_t slots = rotation_slots(context);
+
+    std::vector<std::size_t> targets, candidates;
+    std::vector<double> target_weights;
+    for (std::size_t i = 0; i < steps.size(); i++) {
+        std::size_t r = to_residue(steps[i], slots);
+        if (!r) continue;
+        targets.push_back(r);
+        target_weights.push_back(weights.empty() ? 1.0 : weights[i]);
+        if (std::find(candidates.begin(), candidates.end(), r) == candidates.end()) candidates.push_back(r);
+    }
+    for (std::size_t power = 1; power < slots; power <<= 1) {
+        for (std::size_t r : { power, slots - power }) {
+            if (std::find(candidates.begin(), candidates.end(), r) == candidates.end()) candidates.push_back(r);
+        }
+    }
+
+    // Unreachable targets cost more than any path, so reachability comes first
+    auto workload_cost = [&](const std::vector<std::size_t> &keys) {
+        std::vector<std::uint32_t> distance;
+        shortest_paths(slots, keys, distance, nullptr);
+        double total = 0;
+        for (std::size_t i = 0; i < targets.size(); i++) {
+            auto d = distance[targets[i]];
+            total += target_weights[i] * static_cast<double>(d == unreachable ? slots : d);
+        }
+        return total;
+    };
+
+    std::vector<std::size_t> chosen;
+    double current = workload_cost(chosen);
+    while (chosen.size() < max_keys && !candidates.empty()) {
+        std::vector<double> costs(candidates.size());
+        ThreadPool::Global().parallel_for(candidates.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                auto keys = chosen;
+                keys.push_back(candidates[i]);
+                costs[i] = workload_cost(keys);
+            }
+        });
+        auto best = static_cast<std::size_t>(std::min_element(costs.begin(), costs.end()) - costs.begin());
+        if (costs[best] >= current) break;
+        current = costs[best];
+        chosen.push_back(candidates[best]);
+        candidates.erase(candidates.begin() + static_cast<std::ptrdiff_t>(best));
+    }
+
+    std::vector<int> result;
+    for (auto r : chosen) {
+        result.push_back(r <= slots / 2 ? static_cast<int>(r) : static_cast<int>(r) - static_cast<int>(slots));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
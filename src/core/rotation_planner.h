@@ -0,0 +1,88 @@
+#pragma once
+#include "batch_evaluator.h"
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/galoiskeys.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Composes rotations from whatever Galois keys are available. Rotation steps
+// form the cyclic group of order slots (poly_modulus_degree / 2: CKKS slots,
+// or a BFV/BGV batching row), so a step without its own key can be reached as
+// a sum of steps that have one. The planner finds the fewest key switches for
+// every step at once with a breadth-first search over that group, which is
+// never worse than SEAL's NAF fallback and also works for key sets that are
+// not powers of two.
+class RotationPlanner {
+public:
+    // One node of a batch plan: target is reached by rotating parent by
+    // key_step (one key switch). Nodes are ordered by depth.
+    struct PlanStep {
+        int target;
+        int parent;
+        int key_step;
+        std::size_t depth;
+    };
+
+    struct Plan {
+        std::vector<PlanStep> steps;
+        // Key switches of the shared plan, and of rotating every requested
+        // step on its own
+        std::size_t keyswitches = 0;
+        std::size_t independent_keyswitches = 0;
+        std::size_t depth = 0;
+    };
+
+    // Executes plans with galois_keys, which the caller keeps alive; threads
+    // == 0 shares the process-wide pool
+    RotationPlanner(std::shared_ptr<seal::SEALContext> context, const seal::GaloisKeys &galois_keys,
+                    std::size_t threads = 0);
+
+    // Planning only, for a key set described by its rotation steps
+    RotationPlanner(std::shared_ptr<seal::SEALContext> context, const std::vector<int> &key_steps);
+
+    // Rotation steps the Galois keys hold a key for
+    static std::vector<int> key_steps(const seal::SEALContext &context, const seal::GaloisKeys &galois_keys);
+
+    std::vector<int> key_steps() const;
+    std::size_t slots() const noexcept { return slots_; }
+
+    // Key steps whose sum is step, fewest first; throws std::invalid_argument
+    // when the keys cannot reach step
+    std::vector<int> decompose(int step) const;
+    std::size_t cost(int step) const;
+
+    // One rotation tree for all steps in which intermediate rotations are
+    // shared between requests
+    Plan plan(const std::vector<int> &steps) const;
+
+    seal::Ciphertext rotate(const seal::Ciphertext &encrypted, int step) const;
+
+    // Rotations of encrypted by every step, computed level by level along
+    // plan(steps) on the pool
+    std::vector<seal::Ciphertext> rotate_many(const seal::Ciphertext &encrypted, const std::vector<int> &steps) const;
+
+    // Greedily picks at most max_keys key steps minimizing the weighted sum
+    // of key switches over the workload (weights default to 1). Candidates
+    // are the requested steps and the signed powers of two.
+    static std::vector<int> recommend_keys(const seal::SEALContext &context, const std::vector<int> &steps,
+                                           const std::vector<double> &weights, std::size_t max_keys);
+
+private:
+    void build();
+    std::size_t residue(int step) const;
+    int signed_step(std::size_t residue) const;
+    const seal::GaloisKeys &galois_keys() const;
+
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    const seal::GaloisKeys *galois_keys_ = nullptr;
+    std::size_t slots_;
+    std::vector<std::size_t> keys_;
+    // Per residue: Galois element, key switches from 0 and the last key step
+    // of one shortest path
+    std::vector<std::uint32_t> elts_;
+    std::vector<std::uint32_t> distance_;
+    std::vector<std::size_t> last_key_;
+};
@@ -0,0 +1,194 @@
+#include "stream_reducer.h"
+#include "bounded_queue.h"
+#include "rns_kernels.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+using namespace seal;
+
+namespace {
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // A compute worker's running result. The metadata of the first item is
+    // kept so later items can take the fused path only when they match it.
+    struct Partial {
+        Ciphertext sum;
+        bool started = false;
+        parms_id_type parms_id = parms_id_zero;
+        double scale = 1.0;
+        std::uint64_t correction_factor = 1;
+        std::uint64_t items = 0;
+        std::vector<std::uint64_t> scratch;
+    };
+
+    void accumulate(const SEALContext &context, const Evaluator &evaluator, Partial &partial, Ciphertext &encrypted,
+                    StreamingReducer::Mode mode) {
+        if (!partial.started) {
+            partial.parms_id = encrypted.parms_id();
+            partial.scale = encrypted.scale();
+            partial.correction_factor = encrypted.correction_factor();
+            if (mode == StreamingReducer::Mode::sum) {
+                partial.sum = std::move(encrypted);
+            } else {
+                evaluator.square(encrypted, partial.sum);
+            }
+            partial.started = true;
+            return;
+        }
+        if (mode == StreamingReducer::Mode::sum) {
+            evaluator.add_inplace(partial.sum, encrypted);
+            return;
+        }
+
+        // Squares of NTT-form ciphertexts that match the first item are
+        // accumulated limb by limb at size 3 without a temporary ciphertext
+        bool fused = encrypted.is_ntt_form() && encrypted.size() == 2 && partial.sum.size() == 3 &&
+                     encrypted.parms_id() == partial.parms_id && encrypted.scale() == partial.scale &&
+                     encrypted.correction_factor() == partial.correction_factor;
+        if (!fused) {
+            Ciphertext squared;
+            evaluator.square(encrypted, squared);
+            evaluator.add_inplace(partial.sum, squared);
+            return;
+        }
+        auto &coeff_modulus = context.get_context_data(encrypted.parms_id())->parms().coeff_modulus();
+        std::size_t coeff_count = encrypted.poly_modulus_degree();
+        partial.scratch.resize(coeff_count);
+        const std::uint64_t *c0 = encrypted.data(0);
+        const std::uint64_t *c1 = encrypted.data(1);
+        multiply_accumulate(c0, c0, partial.sum.data(0), coeff_count, coeff_modulus, partial.scratch.data());
+        multiply_accumulate(c0, c1, partial.sum.data(1), coeff_count, coeff_modulus, partial.scratch.data());
+        multiply_accumulate(c1, c0, partial.sum.data(1), coeff_count, coeff_modulus, partial.scratch.data());
+        multiply_accumulate(c1, c1, partial.sum.data(2), coeff_count, coeff_modulus, partial.scratch.data());
+    }
+}
+
+StreamingReducer::StreamingReducer(std::shared_ptr<SEALContext> context, std::size_t readers, std::size_t workers,
+                                   std::size_t queue_capacity)
+    : context_(std::move(context)), batch_(context_), readers_(std::max<std::size_t>(1, readers)),
+      workers_(workers ? workers : std::max<std::size_t>(1, std::thread::hardware_concurrency())),
+      queue_capacity_(std::max<std::size_t>(1, queue_capacity)) {
+    if (!context_->parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+}
+
+Ciphertext StreamingReducer::reduce(const std::vector<std::string> &paths, Mode mode, const RelinKeys *relin_keys,
+                                    bool rescale) {
+    auto start = std::chrono::steady_clock::now();
+    BoundedQueue<Ciphertext> queue(queue_capacity_);
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto fail = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+        queue.close();
+        queue.clear();
+    };
+
+    // Stage 1: readers claim whole files and stream ciphertexts out of them
+    std::atomic<std::size_t> next_file{ 0 };
+    std::atomic<std::size_t> readers_left{ readers_ };
+    std::atomic<std::uint64_t> bytes{ 0 };
+    std::vector<double> reader_busy(readers_, 0.0), reader_stall(readers_, 0.0);
+    auto read_files = [&](std::size_t r) {
+        for (std::size_t f = next_file++; f < paths.size(); f = next_file++) {
+            std::ifstream in(paths[f], std::ios::binary);
+            if (!in.is_open()) throw std::runtime_error("Cannot open file: " + paths[f]);
+            while (in.peek() != std::ifstream::traits_type::eof()) {
+                auto load_start = std::chrono::steady_clock::now();
+                Ciphertext encrypted;
+                bytes += static_cast<std::uint64_t>(encrypted.load(*context_, in));
+                reader_busy[r] += seconds_since(load_start);
+                if (!queue.push(std::move(encrypted), reader_stall[r])) return;
+            }
+        }
+    };
+
+    // Stage 2: workers fold queued ciphertexts into their own partial
+    std::vector<Partial> partials(workers_);
+    std::vector<double> worker_busy(workers_, 0.0), worker_stall(workers_, 0.0);
+    auto fold = [&](std::size_t w) {
+        Ciphertext encrypted;
+        while (queue.pop(encrypted, worker_stall[w])) {
+            auto fold_start = std::chrono::steady_clock::now();
+            accumulate(*context_, batch_.evaluator(), partials[w], encrypted, mode);
+            partials[w].items++;
+            worker_busy[w] += seconds_since(fold_start);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(readers_ + workers_);
+    for (std::size_t r = 0; r < readers_; r++) {
+        threads.emplace_back([&, r]() {
+            try {
+                read_files(r);
+            } catch (...) {
+                fail();
+            }
+            if (--readers_left == 0) queue.close();
+        });
+    }
+    for (std::size_t w = 0; w < workers_; w++) {
+        threads.emplace_back([&, w]() {
+            try {
+                fold(w);
+            } catch (...) {
+                fail();
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+    if (error) std::rethrow_exception(error);
+
+    // Stage 3: pairwise tree merge of the partials on the pool
+    auto merge_start = std::chrono::steady_clock::now();
+    std::vector<Ciphertext> sums;
+    std::uint64_t items = 0;
+    for (auto &partial : partials) {
+        items += partial.items;
+        if (partial.started) sums.push_back(std::move(partial.sum));
+    }
+    if (sums.empty()) throw std::invalid_argument("no ciphertexts to reduce");
+    while (sums.size() > 1) {
+        std::size_t half = (sums.size() + 1) / 2;
+        batch_.pool().parallel_for(sums.size() / 2, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) batch_.evaluator().add_inplace(sums[i], sums[i + half]);
+        });
+        sums.resize(half);
+    }
+    Ciphertext result = std::move(sums.front());
+    if (result.size() == 3 && relin_keys) batch_.evaluator().relinearize_inplace(result, *relin_keys);
+    if (mode == Mode::sum_of_squares && rescale &&
+        context_->get_context_data(result.parms_id())->parms().scheme() == scheme_type::ckks) {
+        batch_.evaluator().rescale_to_next_inplace(result);
+    }
+
+    StreamStats stats;
+    stats.items = items;
+    stats.bytes = bytes.load();
+    stats.merge_seconds = seconds_since(merge_start);
+    stats.seconds = seconds_since(start);
+    stats.reader_busy_seconds = std::accumulate(reader_busy.begin(), reader_busy.end(), 0.0);
+    stats.reader_stall_seconds = std::accumulate(reader_stall.begin(), reader_stall.end(), 0.0);
+    stats.worker_busy_seconds = std::accumulate(worker_busy.begin(), worker_busy.end(), 0.0);
+    stats.worker_stall_seconds = std::accumulate(worker_stall.begin(), worker_stall.end(), 0.0);
+    stats.queue_high_water = queue.high_water();
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = stats;
+    return result;
+}
+
+StreamStats StreamingReducer::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "batch_evaluator.h"
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/relinkeys.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Per-run pipeline metrics. busy is time spent doing work, stall is time
+// blocked on the queue (readers: queue full, workers: queue empty), summed
+// over the threads of a stage.
+struct StreamStats {
+    std::uint64_t items = 0;
+    std::uint64_t bytes = 0;
+    double seconds = 0;
+    double reader_busy_seconds = 0;
+    double reader_stall_seconds = 0;
+    double worker_busy_seconds = 0;
+    double worker_stall_seconds = 0;
+    double merge_seconds = 0;
+    std::size_t queue_high_water = 0;
+};
+
+// Reduces ciphertexts streamed from files in three overlapped stages: reader
+// threads load and validate ciphertexts into a bounded queue, compute workers
+// fold them into per-thread partial sums, and the partials are merged as a
+// tree on the worker pool. A file may hold any number of ciphertexts saved
+// back to back (see save_ciphertexts).
+class StreamingReducer {
+public:
+    enum class Mode { sum, sum_of_squares };
+
+    // workers == 0 uses one per hardware thread
+    StreamingReducer(std::shared_ptr<seal::SEALContext> context, std::size_t readers = 2, std::size_t workers = 0,
+                     std::size_t queue_capacity = 64);
+
+    // sum_of_squares keeps products at size 3 and relinearizes once when
+    // relin_keys is given; CKKS results are rescaled once when rescale is true
+    seal::Ciphertext reduce(const std::vector<std::string> &paths, Mode mode,
+                            const seal::RelinKeys *relin_keys = nullptr, bool rescale = true);
+
+    // Metrics of the last reduce
+    StreamStats stats() const;
+
+    std::size_t readers() const noexcept { return readers_; }
+    std::size_t workers() const noexcept { return workers_; }
+    std::size_t queue_capacity() const noexcept { return queue_capacity_; }
+
+private:
+    std::shared_ptr<seal::SEALContext> context_;
+    BatchEvaluator batch_;
+    std::size_t readers_, workers_, queue_capacity_;
+
+    mutable std::mutex stats_mutex_;
+    StreamStats stats_;
+};
@@ -0,0 +1,130 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <exception>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    thread_local bool is_pool_worker = false;
+}
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+        workers_.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ThreadPool::ThreadPool(std::size_t threads, std::vector<int> cpus) : cpus_(std::move(cpus)) {
+    if (threads == 0) threads = std::max<std::size_t>(1, cpus_.size());
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+        workers_.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) worker.join();
+}
+
+std::size_t ThreadPool::queue_depth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+std::size_t ThreadPool::in_flight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::worker_loop() {
+    is_pool_worker = true;
+    if (!cpus_.empty()) pin_current_thread(cpus_);
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+            if (stop_ && queue_.empty()) return;
+            task = std::move(queue_.front());
+            queue_.pop_front();
+            active_++;
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_--;
+        }
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t, std::size_t)> &fn,
+                              std::size_t min_chunk) {
+    if (count == 0) return;
+    min_chunk = std::max<std::size_t>(1, min_chunk);
+    std::size_t chunks = std::min(size(), (count + min_chunk - 1) / min_chunk);
+    if (chunks <= 1 || on_worker_thread()) {
+        fn(0, count);
+        return;
+    }
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunks);
+    std::size_t base = count / chunks;
+    std::size_t extra = count % chunks;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < chunks; i++) {
+        std::size_t end = begin + base + (i < extra ? 1 : 0);
+        pending.push_back(submit([&fn, begin, end]() { fn(begin, end); }));
+        begin = end;
+    }
+
+    std::exception_ptr error;
+    for (auto &future : pending) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+bool ThreadPool::on_worker_thread() noexcept {
+    return is_pool_worker;
+}
+
+bool ThreadPool::pin_current_thread(const std::vector<int> &cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(static_cast<std::size_t>(cpu), &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+ThreadPool &ThreadPool::Global() {
+    static ThreadPool pool;
+    return pool;
+}
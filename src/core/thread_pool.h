@@ -0,0 +1,73 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed-size native worker pool shared by the batched kernels. Tasks never
+// touch Python objects, so callers release the GIL before waiting on them.
+class ThreadPool {
+public:
+    // threads == 0 uses std::thread::hardware_concurrency()
+    explicit ThreadPool(std::size_t threads = 0);
+
+    // Workers restricted to cpus (Linux; ignored elsewhere); threads == 0
+    // starts one per CPU
+    ThreadPool(std::size_t threads, std::vector<int> cpus);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    std::size_t size() const noexcept { return workers_.size(); }
+
+    // Tasks waiting for a worker
+    std::size_t queue_depth() const;
+
+    // Tasks currently running on a worker
+    std::size_t in_flight() const;
+
+    template <class F>
+    std::future<std::invoke_result_t<F>> submit(F &&task) {
+        using result_type = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<result_type()>>(std::forward<F>(task));
+        auto future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    // Splits [0, count) into at most size() contiguous chunks of at least
+    // min_chunk items and runs fn(begin, end) on each, blocking until all are
+    // done. The first exception thrown by a chunk is rethrown. Runs inline when
+    // called from one of this pool's own workers to avoid self-deadlock.
+    void parallel_for(std::size_t count, const std::function<void(std::size_t, std::size_t)> &fn,
+                      std::size_t min_chunk = 1);
+
+    // True when the calling thread is a worker of any ThreadPool
+    static bool on_worker_thread() noexcept;
+
+    // Restricts the calling thread to cpus; false when the platform or the
+    // process's affinity mask does not allow it
+    static bool pin_current_thread(const std::vector<int> &cpus);
+
+    // Process-wide pool sized to the machine
+    static ThreadPool &Global();
+
+private:
+    void enqueue(std::function<void()> task);
+    void worker_loop();
+
+    std::vector<std::thread> workers_;
+    std::vector<int> cpus_;
+    std::deque<std::function<void()>> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::size_t active_ = 0;
+    bool stop_ = false;
+};
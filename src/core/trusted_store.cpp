@@ -0,0 +1,294 @@
+#include "trusted_store.h"
+#include "content_hash.h"
+#include "mapped_file.h"
+#include <seal/serialization.h>
+#include <seal/valcheck.h>
+#include <seal/util/blake2.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace seal;
+
+namespace {
+    constexpr char store_magic[8] = { 'S', 'E', 'A', 'L', 'T', 'R', 'S', '1' };
+    constexpr std::uint64_t hash_seed = 0x5345414c54525331ULL;
+    constexpr std::size_t tag_bytes = 32;
+
+    // File layout: Prologue, count Entries, the tag of both, then the objects
+    // each padded to 8 bytes. The tag covers everything before it, so object
+    // order, sizes and tags cannot be changed without detection.
+    struct Prologue {
+        char magic[8];
+        std::uint64_t integrity;
+        std::uint64_t kind;
+        std::uint64_t count;
+    };
+
+    struct Entry {
+        std::uint64_t offset;
+        std::uint64_t size;
+        unsigned char tag[tag_bytes];
+    };
+
+    static_assert(sizeof(Prologue) == 32 && sizeof(Entry) == 48, "unexpected padding in file layout");
+
+    // Object type recorded in the file so a load of the wrong type fails
+    template <class T>
+    struct ObjectKind;
+    template <>
+    struct ObjectKind<Ciphertext> { static constexpr std::uint64_t value = 1; };
+    template <>
+    struct ObjectKind<Plaintext> { static constexpr std::uint64_t value = 2; };
+    template <>
+    struct ObjectKind<PublicKey> { static constexpr std::uint64_t value = 3; };
+    template <>
+    struct ObjectKind<SecretKey> { static constexpr std::uint64_t value = 4; };
+    template <>
+    struct ObjectKind<RelinKeys> { static constexpr std::uint64_t value = 5; };
+    template <>
+    struct ObjectKind<GaloisKeys> { static constexpr std::uint64_t value = 6; };
+
+    std::size_t padded(std::size_t size) {
+        return (size + 7) & ~std::size_t(7);
+    }
+
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    ContentHash hash_bytes(const unsigned char *data, std::size_t size) {
+        std::size_t length = size;
+        ContentHasher hasher(hash_seed);
+        std::uint64_t block[512];
+        while (size) {
+            std::size_t take = std::min(size, sizeof(block));
+            if (take % 8) block[take / 8] = 0;
+            std::memcpy(block, data, take);
+            hasher.update(block, (take + 7) / 8);
+            data += take;
+            size -= take;
+        }
+        hasher.update(static_cast<std::uint64_t>(length));
+        return hasher.finish();
+    }
+}
+
+TrustedStore::TrustedStore(Integrity integrity, std::vector<unsigned char> key, std::size_t threads)
+    : integrity_(integrity), key_(std::move(key)), pool_(std::make_unique<ThreadPool>(threads)) {
+    if (integrity_ == Integrity::mac) {
+        if (key_.empty() || key_.size() > static_cast<std::size_t>(BLAKE2B_KEYBYTES)) {
+            throw std::invalid_argument("mac key must be 1 to 64 bytes");
+        }
+    } else {
+        key_.clear();
+    }
+}
+
+void TrustedStore::tag(const unsigned char *data, std::size_t size, unsigned char *out) const {
+    std::memset(out, 0, tag_bytes);
+    if (integrity_ == Integrity::hash) {
+        auto digest = hash_bytes(data, size);
+        std::memcpy(out, &digest.lo, sizeof(digest.lo));
+        std::memcpy(out + sizeof(digest.lo), &digest.hi, sizeof(digest.hi));
+    } else if (integrity_ == Integrity::mac) {
+        if (blake2b(out, tag_bytes, data, size, key_.data(), key_.size()) != 0) {
+            throw std::runtime_error("failed to compute mac");
+        }
+    }
+}
+
+bool TrustedStore::verify(const unsigned char *data, std::size_t size, const unsigned char *expected) const {
+    unsigned char actual[tag_bytes];
+    tag(data, size, actual);
+    // Constant time, so a forger learns nothing from how long a reject takes
+    unsigned char diff = 0;
+    for (std::size_t i = 0; i < tag_bytes; i++) diff = static_cast<unsigned char>(diff | (actual[i] ^ expected[i]));
+    return diff == 0;
+}
+
+template <class T>
+void TrustedStore::save(const std::vector<const T *> &objects, const std::string &path, bool compress) const {
+    auto mode = compress ? Serialization::compr_mode_default : compr_mode_type::none;
+    std::size_t count = objects.size();
+    std::vector<std::vector<seal_byte>> blobs(count);
+    std::vector<Entry> entries(count);
+    pool_->parallel_for(count, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            blobs[i].resize(static_cast<std::size_t>(objects[i]->save_size(mode)));
+            blobs[i].resize(static_cast<std::size_t>(objects[i]->save(blobs[i].data(), blobs[i].size(), mode)));
+            entries[i].size = blobs[i].size();
+            tag(reinterpret_cast<const unsigned char *>(blobs[i].data()), blobs[i].size(), entries[i].tag);
+        }
+    });
+
+    std::size_t table_bytes = sizeof(Prologue) + count * sizeof(Entry);
+    std::uint64_t offset = table_bytes + tag_bytes;
+    for (auto &entry : entries) {
+        entry.offset = offset;
+        offset += padded(static_cast<std::size_t>(entry.size));
+    }
+    std::vector<unsigned char> table(table_bytes + tag_bytes);
+    Prologue prologue;
+    std::memcpy(prologue.magic, store_magic, sizeof(store_magic));
+    prologue.integrity = static_cast<std::uint64_t>(integrity_);
+    prologue.kind = ObjectKind<T>::value;
+    prologue.count = count;
+    std::memcpy(table.data(), &prologue, sizeof(prologue));
+    if (count) std::memcpy(table.data() + sizeof(prologue), entries.data(), count * sizeof(Entry));
+    tag(table.data(), table_bytes, table.data() + table_bytes);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) throw std::runtime_error("Cannot open file: " + path);
+    out.write(reinterpret_cast<const char *>(table.data()), static_cast<std::streamsize>(table.size()));
+    const char padding[8] = {};
+    for (auto &blob : blobs) {
+        out.write(reinterpret_cast<const char *>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        out.write(padding, static_cast<std::streamsize>(padded(blob.size()) - blob.size()));
+    }
+    if (!out) throw std::runtime_error("failed to write " + path);
+}
+
+template <class T>
+std::vector<T> TrustedStore::load(const SEALContext &context, const std::string &path) {
+    auto start = std::chrono::steady_clock::now();
+    MappedFile file(path);
+    Prologue prologue;
+    if (file.size() < sizeof(prologue) + tag_bytes) throw std::runtime_error(path + " is not a trusted store file");
+    std::memcpy(&prologue, file.data(), sizeof(prologue));
+    if (std::memcmp(prologue.magic, store_magic, sizeof(store_magic)) != 0) {
+        throw std::runtime_error(path + " is not a trusted store file");
+    }
+    if (prologue.integrity != static_cast<std::uint64_t>(integrity_)) {
+        throw std::invalid_argument(path + " was written with a different integrity mode");
+    }
+    if (prologue.kind != ObjectKind<T>::value) throw std::invalid_argument(path + " holds a different object type");
+    if (prologue.count > (file.size() - sizeof(prologue) - tag_bytes) / sizeof(Entry)) {
+        throw std::runtime_error(path + " is truncated");
+    }
+    std::size_t count = static_cast<std::size_t>(prologue.count);
+    std::size_t table_bytes = sizeof(prologue) + count * sizeof(Entry);
+
+    auto verify_start = std::chrono::steady_clock::now();
+    if (!verify(file.data(), table_bytes, file.data() + table_bytes)) {
+        throw std::runtime_error("integrity check failed for the object table of " + path);
+    }
+    double verify_seconds = seconds_since(verify_start);
+    std::vector<Entry> entries(count);
+    if (count) std::memcpy(entries.data(), file.data() + sizeof(prologue), count * sizeof(Entry));
+
+    std::vector<T> result(count);
+    std::mutex verify_mutex;
+    pool_->parallel_for(count, [&](std::size_t begin, std::size_t end) {
+        double chunk_verify = 0;
+        for (std::size_t i = begin; i < end; i++) {
+            auto &entry = entries[i];
+            if (entry.offset > file.size() || entry.size > file.size() - entry.offset) {
+                throw std::runtime_error(path + " is truncated");
+            }
+            auto data = file.data() + entry.offset;
+            auto size = static_cast<std::size_t>(entry.size);
+            auto object_start = std::chrono::steady_clock::now();
+            if (!verify(data, size, entry.tag)) {
+                throw std::runtime_error("integrity check failed for object " + std::to_string(i) + " of " + path);
+            }
+            chunk_verify += seconds_since(object_start);
+            result[i].unsafe_load(context, reinterpret_cast<const seal_byte *>(data), size);
+            if (!is_metadata_valid_for(result[i], context)) {
+                throw std::logic_error("object " + std::to_string(i) + " is not valid for encryption parameters");
+            }
+        }
+        std::lock_guard<std::mutex> lock(verify_mutex);
+        verify_seconds += chunk_verify;
+    });
+
+    LoadStats stats;
+    stats.objects = count;
+    stats.bytes = file.size();
+    stats.verify_seconds = verify_seconds;
+    stats.seconds = seconds_since(start);
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = stats;
+    return result;
+}
+
+LoadStats TrustedStore::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+BulkLoader::BulkLoader(std::shared_ptr<SEALContext> context, std::size_t threads)
+    : context_(std::move(context)), pool_(std::make_unique<ThreadPool>(threads)) {
+    if (!context_->parameters_set()) throw std::invalid_argument("encryption parameters are not set correctly");
+}
+
+template <class T>
+std::vector<T> BulkLoader::load(const std::string &path) {
+    MappedFile file(path);
+    // Only the fixed-size SEAL headers are read here; they give each
+    // object's size, so the objects themselves can be loaded concurrently
+    std::vector<std::pair<const unsigned char *, std::size_t>> spans;
+    std::size_t offset = 0;
+    while (offset < file.size()) {
+        std::size_t remaining = file.size() - offset;
+        if (remaining < sizeof(Serialization::SEALHeader)) throw std::runtime_error(path + " is truncated");
+        Serialization::SEALHeader header;
+        Serialization::LoadHeader(reinterpret_cast<const seal_byte *>(file.data() + offset), remaining, header);
+        if (!Serialization::IsValidHeader(header)) throw std::logic_error("loaded SEALHeader is invalid");
+        if (header.size > remaining) throw std::runtime_error(path + " is truncated");
+        spans.emplace_back(file.data() + offset, static_cast<std::size_t>(header.size));
+        offset += static_cast<std::size_t>(header.size);
+    }
+    return load_spans<T>(spans);
+}
+
+template <class T>
+std::vector<T> BulkLoader::load(const std::vector<std::string> &buffers) {
+    std::vector<std::pair<const unsigned char *, std::size_t>> spans;
+    spans.reserve(buffers.size());
+    for (auto &buffer : buffers) {
+        spans.emplace_back(reinterpret_cast<const unsigned char *>(buffer.data()), buffer.size());
+    }
+    return load_spans<T>(spans);
+}
+
+template <class T>
+std::vector<T> BulkLoader::load_spans(const std::vector<std::pair<const unsigned char *, std::size_t>> &spans) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<T> result(spans.size());
+    pool_->parallel_for(spans.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            result[i].load(*context_, reinterpret_cast<const seal_byte *>(spans[i].first), spans[i].second);
+        }
+    });
+
+    LoadStats stats;
+    stats.objects = spans.size();
+    for (auto &span : spans) stats.bytes += span.second;
+    stats.seconds = seconds_since(start);
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_ = stats;
+    return result;
+}
+
+LoadStats BulkLoader::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+#define TRUSTED_STORE_INSTANTIATE(T)                                                                              \
+    template void TrustedStore::save<T>(const std::vector<const T *> &, const std::string &, bool) const;        \
+    template std::vector<T> TrustedStore::load<T>(const SEALContext &, const std::string &);                    \
+    template std::vector<T> BulkLoader::load<T>(const std::string &);                                            \
+    template std::vector<T> BulkLoader::load<T>(const std::vector<std::string> &);
+
+TRUSTED_STORE_INSTANTIATE(Ciphertext)
+TRUSTED_STORE_INSTANTIATE(Plaintext)
+TRUSTED_STORE_INSTANTIATE(PublicKey)
+TRUSTED_STORE_INSTANTIATE(SecretKey)
+TRUSTED_STORE_INSTANTIATE(RelinKeys)
+TRUSTED_STORE_INSTANTIATE(GaloisKeys)
+
+#undef TRUSTED_STORE_INSTANTIATE
@@ -0,0 +1,98 @@
+#pragma once
+#include "thread_pool.h"
+#include <seal/context.h>
+#include <seal/ciphertext.h>
+#include <seal/plaintext.h>
+#include <seal/publickey.h>
+#include <seal/secretkey.h>
+#include <seal/relinkeys.h>
+#include <seal/galoiskeys.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// How a TrustedStore file proves it has not changed since it was written:
+// none trusts the storage outright, hash detects accidental corruption with
+// a 128-bit ContentHasher digest, mac detects tampering with keyed BLAKE2b.
+enum class Integrity : std::uint64_t { none = 0, hash = 1, mac = 2 };
+
+struct LoadStats {
+    std::uint64_t objects = 0;
+    std::uint64_t bytes = 0;
+    double seconds = 0;
+    // Summed over threads; only TrustedStore verifies tags
+    double verify_seconds = 0;
+};
+
+// Saves and loads SEAL objects for storage we produced ourselves. Every
+// object carries an integrity tag and is checked against it on load, after
+// which it is read with unsafe_load: the metadata is still checked against
+// the context, but the per-coefficient range scan of is_valid_for is
+// skipped. Objects in one file are verified and loaded in parallel.
+//
+// Only use this for files written by a TrustedStore with the same key;
+// anything else should go through load_* or BulkLoader.
+class TrustedStore {
+public:
+    // key is required (1 to 64 bytes) for Integrity::mac and ignored otherwise
+    TrustedStore(Integrity integrity, std::vector<unsigned char> key = {}, std::size_t threads = 0);
+
+    // compress uses SEAL's default compression; without it files are larger
+    // but loading is a plain copy
+    template <class T>
+    void save(const std::vector<const T *> &objects, const std::string &path, bool compress = true) const;
+
+    // Throws std::runtime_error when a tag does not match and
+    // std::logic_error when an object does not belong to the context
+    template <class T>
+    std::vector<T> load(const seal::SEALContext &context, const std::string &path);
+
+    Integrity integrity() const noexcept { return integrity_; }
+    std::size_t threads() const noexcept { return pool_->size(); }
+
+    // Metrics of the last load
+    LoadStats stats() const;
+
+private:
+    void tag(const unsigned char *data, std::size_t size, unsigned char *out) const;
+    bool verify(const unsigned char *data, std::size_t size, const unsigned char *expected) const;
+
+    Integrity integrity_;
+    std::vector<unsigned char> key_;
+    std::unique_ptr<ThreadPool> pool_;
+
+    mutable std::mutex stats_mutex_;
+    LoadStats stats_;
+};
+
+// Fully validating loader for untrusted input that spreads the work over
+// threads: the SEAL headers of a stream of objects saved back to back (see
+// save_ciphertexts) are scanned first, then every object is decompressed and
+// validated by its own task.
+class BulkLoader {
+public:
+    BulkLoader(std::shared_ptr<seal::SEALContext> context, std::size_t threads = 0);
+
+    template <class T>
+    std::vector<T> load(const std::string &path);
+
+    template <class T>
+    std::vector<T> load(const std::vector<std::string> &buffers);
+
+    std::size_t threads() const noexcept { return pool_->size(); }
+
+    LoadStats stats() const;
+
+private:
+    template <class T>
+    std::vector<T> load_spans(const std::vector<std::pair<const unsigned char *, std::size_t>> &spans);
+
+    std::shared_ptr<seal::SEALContext> context_;
+    std::unique_ptr<ThreadPool> pool_;
+
+    mutable std::mutex stats_mutex_;
+    LoadStats stats_;
+};
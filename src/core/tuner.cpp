@@ -0,0 +1,346 @@
+#include "tuner.h"
+#include <seal/batchencoder.h>
+#include <seal/ckks.h>
+#include <seal/decryptor.h>
+#include <seal/encryptor.h>
+#include <seal/evaluator.h>
+#include <seal/keygenerator.h>
+#include <seal/modulus.h>
+#include <seal/util/uintarithsmallmod.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ios>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+using namespace seal;
+
+namespace {
+    constexpr std::size_t min_degree = 1024;
+    constexpr std::size_t max_degree = 32768;
+    constexpr int max_prime_bits = 60;
+
+    int log2_degree(std::size_t poly_modulus_degree) {
+        int bits = 0;
+        while ((std::size_t(1) << bits) < poly_modulus_degree) bits++;
+        return bits;
+    }
+
+    std::size_t slot_count(scheme_type scheme, std::size_t poly_modulus_degree) {
+        return scheme == scheme_type::ckks ? poly_modulus_degree / 2 : poly_modulus_degree;
+    }
+
+    void check_request(const TuningRequest &request) {
+        if (request.scheme == scheme_type::none) throw std::invalid_argument("scheme must be CKKS, BFV or BGV");
+        if (request.depth < 0) throw std::invalid_argument("depth must be non-negative");
+        if (request.trials == 0) throw std::invalid_argument("trials must be positive");
+        if (request.scheme == scheme_type::ckks && (request.precision_bits <= 0 || request.integer_bits < 0)) {
+            throw std::invalid_argument("precision_bits must be positive and integer_bits non-negative");
+        }
+        if (request.scheme != scheme_type::ckks && (request.plain_modulus_bits < 2 || request.plain_modulus_bits > max_prime_bits)) {
+            throw std::invalid_argument("plain_modulus_bits must be between 2 and 60");
+        }
+    }
+
+    // CKKS layouts: [scale + integer_bits, scale x depth, special]. Two scales
+    // are tried per degree; the larger trades speed for headroom.
+    std::vector<std::vector<int>> ckks_layouts(const TuningRequest &request) {
+        std::vector<std::vector<int>> layouts;
+        for (int margin : { 10, 20 }) {
+            int scale_bits = request.precision_bits + margin;
+            int first_bits = scale_bits + request.integer_bits;
+            if (first_bits > max_prime_bits) continue;
+            std::vector<int> bits{ first_bits };
+            bits.insert(bits.end(), static_cast<std::size_t>(request.depth), scale_bits);
+            bits.push_back(first_bits);
+            layouts.push_back(std::move(bits));
+        }
+        return layouts;
+    }
+
+    // BFV/BGV layouts from a noise estimate: a fresh ciphertext needs about
+    // plain_modulus_bits + 10 bits, and each multiplication consumes about
+    // plain_modulus_bits + log2(N) + 4. BGV spends one prime per level. A second
+    // layout adds one prime of headroom in case the estimate is optimistic.
+    std::vector<std::vector<int>> integer_layouts(const TuningRequest &request, std::size_t poly_modulus_degree) {
+        int log_n = log2_degree(poly_modulus_degree);
+        int needed = request.plain_modulus_bits + 10 + request.depth * (request.plain_modulus_bits + log_n + 4);
+        int count = (needed + max_prime_bits - 1) / max_prime_bits;
+        if (request.scheme == scheme_type::bgv) count = std::max(count, request.depth + 1);
+        int prime_bits = std::min(max_prime_bits, std::max((needed + count - 1) / count, request.plain_modulus_bits + log_n / 2 + 12));
+
+        std::vector<std::vector<int>> layouts;
+        for (int extra : { 0, 1 }) {
+            std::vector<int> bits(static_cast<std::size_t>(count + extra), prime_bits);
+            bits.push_back(prime_bits);
+            layouts.push_back(std::move(bits));
+        }
+        return layouts;
+    }
+
+    template <class F>
+    double time_ms(std::size_t trials, F &&fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < trials; i++) fn();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / static_cast<double>(trials);
+    }
+
+    std::size_t saved_size(std::streamoff size) {
+        return static_cast<std::size_t>(size);
+    }
+
+    // Rotation steps 1, 2, ... used for key generation; the benchmark rotates by 1
+    std::vector<int> rotation_steps(const TuningRequest &request, std::size_t poly_modulus_degree) {
+        std::size_t limit = slot_count(request.scheme, poly_modulus_degree) / 2 - 1;
+        std::vector<int> steps(std::min(request.rotations, limit));
+        std::iota(steps.begin(), steps.end(), 1);
+        return steps;
+    }
+
+    void run_ckks(const TuningRequest &request, const SEALContext &context, KeyGenerator &keygen,
+                  const RelinKeys &relin_keys, const GaloisKeys *galois_keys, CandidateReport &report) {
+        PublicKey public_key;
+        keygen.create_public_key(public_key);
+        Encryptor encryptor(context, public_key);
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        CKKSEncoder encoder(context);
+
+        // Inputs in [-1, 1] keep every intermediate power inside integer_bits
+        std::mt19937_64 engine(42);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        std::size_t slots = encoder.slot_count();
+        std::vector<double> x(slots), y(slots);
+        for (auto &v : x) v = dist(engine);
+        for (auto &v : y) v = dist(engine);
+
+        Plaintext plain_x, plain_y;
+        encoder.encode(x, report.scale, plain_x);
+        encoder.encode(y, report.scale, plain_y);
+        Ciphertext ct_x, ct_y, ct_tmp;
+        report.encrypt_ms = time_ms(request.trials, [&]() { encryptor.encrypt(plain_x, ct_x); });
+        encryptor.encrypt(plain_y, ct_y);
+        report.ciphertext_bytes = saved_size(ct_x.save_size(compr_mode_type::none));
+
+        if (request.depth > 0) {
+            report.multiply_ms = time_ms(request.trials, [&]() {
+                evaluator.multiply(ct_x, ct_y, ct_tmp);
+                evaluator.relinearize_inplace(ct_tmp, relin_keys);
+            });
+            report.rescale_ms = time_ms(request.trials, [&]() {
+                Ciphertext copy = ct_tmp;
+                evaluator.rescale_to_next_inplace(copy);
+            });
+        }
+        if (galois_keys) {
+            report.rotate_ms = time_ms(request.trials, [&]() { evaluator.rotate_vector(ct_x, 1, *galois_keys, ct_tmp); });
+        }
+
+        // The circuit itself: depth products with fresh operands, then a rotation
+        std::vector<double> expected = x;
+        Ciphertext result = ct_x;
+        for (int d = 0; d < request.depth; d++) {
+            Ciphertext operand = ct_y;
+            evaluator.mod_switch_to_inplace(operand, result.parms_id());
+            evaluator.multiply_inplace(result, operand);
+            evaluator.relinearize_inplace(result, relin_keys);
+            evaluator.rescale_to_next_inplace(result);
+            for (std::size_t i = 0; i < slots; i++) expected[i] *= y[i];
+        }
+        if (galois_keys) {
+            evaluator.rotate_vector_inplace(result, 1, *galois_keys);
+            std::rotate(expected.begin(), expected.begin() + 1, expected.end());
+        }
+
+        Plaintext decrypted;
+        report.decrypt_ms = time_ms(request.trials, [&]() { decryptor.decrypt(result, decrypted); });
+        std::vector<double> output;
+        encoder.decode(decrypted, output);
+        double max_error = 0;
+        for (std::size_t i = 0; i < slots; i++) max_error = std::max(max_error, std::abs(output[i] - expected[i]));
+        report.precision_bits = max_error > 0 ? -std::log2(max_error) : static_cast<double>(max_prime_bits);
+        if (report.precision_bits < request.precision_bits) {
+            report.failure = "measured precision " + std::to_string(report.precision_bits) + " bits is below the requirement";
+        }
+    }
+
+    void run_integer(const TuningRequest &request, const SEALContext &context, KeyGenerator &keygen,
+                     const RelinKeys &relin_keys, const GaloisKeys *galois_keys, CandidateReport &report) {
+        PublicKey public_key;
+        keygen.create_public_key(public_key);
+        Encryptor encryptor(context, public_key);
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        BatchEncoder encoder(context);
+        auto &plain_modulus = context.first_context_data()->parms().plain_modulus();
+        bool bgv = request.scheme == scheme_type::bgv;
+
+        std::mt19937_64 engine(42);
+        std::uniform_int_distribution<std::uint64_t> dist(0, plain_modulus.value() - 1);
+        std::size_t slots = encoder.slot_count();
+        std::vector<std::uint64_t> x(slots), y(slots);
+        for (auto &v : x) v = dist(engine);
+        for (auto &v : y) v = dist(engine);
+
+        Plaintext plain_x, plain_y;
+        encoder.encode(x, plain_x);
+        encoder.encode(y, plain_y);
+        Ciphertext ct_x, ct_y, ct_tmp;
+        report.encrypt_ms = time_ms(request.trials, [&]() { encryptor.encrypt(plain_x, ct_x); });
+        encryptor.encrypt(plain_y, ct_y);
+        report.ciphertext_bytes = saved_size(ct_x.save_size(compr_mode_type::none));
+
+        if (request.depth > 0) {
+            report.multiply_ms = time_ms(request.trials, [&]() {
+                evaluator.multiply(ct_x, ct_y, ct_tmp);
+                evaluator.relinearize_inplace(ct_tmp, relin_keys);
+            });
+            if (bgv) {
+                report.rescale_ms = time_ms(request.trials, [&]() {
+                    Ciphertext copy = ct_tmp;
+                    evaluator.mod_switch_to_next_inplace(copy);
+                });
+            }
+        }
+        if (galois_keys) {
+            report.rotate_ms = time_ms(request.trials, [&]() { evaluator.rotate_rows(ct_x, 1, *galois_keys, ct_tmp); });
+        }
+
+        std::vector<std::uint64_t> expected = x;
+        Ciphertext result = ct_x;
+        for (int d = 0; d < request.depth; d++) {
+            Ciphertext operand = ct_y;
+            if (bgv) evaluator.mod_switch_to_inplace(operand, result.parms_id());
+            evaluator.multiply_inplace(result, operand);
+            evaluator.relinearize_inplace(result, relin_keys);
+            if (bgv) evaluator.mod_switch_to_next_inplace(result);
+            for (std::size_t i = 0; i < slots; i++) expected[i] = util::multiply_uint_mod(expected[i], y[i], plain_modulus);
+        }
+        if (galois_keys) {
+            // rotate_rows rotates each of the two rows of slots / 2 values
+            evaluator.rotate_rows_inplace(result, 1, *galois_keys);
+            auto half = static_cast<std::ptrdiff_t>(slots / 2);
+            std::rotate(expected.begin(), expected.begin() + 1, expected.begin() + half);
+            std::rotate(expected.begin() + half, expected.begin() + half + 1, expected.end());
+        }
+
+        report.noise_budget = decryptor.invariant_noise_budget(result);
+        Plaintext decrypted;
+        report.decrypt_ms = time_ms(request.trials, [&]() { decryptor.decrypt(result, decrypted); });
+        std::vector<std::uint64_t> output;
+        encoder.decode(decrypted, output);
+        if (report.noise_budget <= 0 || output != expected) report.failure = "circuit result is incorrect (noise budget exhausted)";
+    }
+}
+
+std::vector<EncryptionParameters> ParameterTuner::candidates(const TuningRequest &request) {
+    check_request(request);
+    std::vector<EncryptionParameters> result;
+    for (std::size_t degree = min_degree; degree <= max_degree; degree *= 2) {
+        if (slot_count(request.scheme, degree) < request.slots) continue;
+        int max_bits = CoeffModulus::MaxBitCount(degree, request.sec_level);
+
+        EncryptionParameters parms(request.scheme);
+        parms.set_poly_modulus_degree(degree);
+        Modulus plain_modulus;
+        if (request.scheme != scheme_type::ckks) {
+            try {
+                plain_modulus = PlainModulus::Batching(degree, request.plain_modulus_bits);
+            } catch (const std::exception &) {
+                // No batching prime of that size for this degree
+                continue;
+            }
+            parms.set_plain_modulus(plain_modulus);
+        }
+
+        auto layouts = request.scheme == scheme_type::ckks ? ckks_layouts(request) : integer_layouts(request, degree);
+        for (auto &bits : layouts) {
+            if (std::accumulate(bits.begin(), bits.end(), 0) > max_bits) continue;
+            try {
+                parms.set_coeff_modulus(request.scheme == scheme_type::ckks ? CoeffModulus::Create(degree, bits)
+                                                                            : CoeffModulus::Create(degree, plain_modulus, bits));
+            } catch (const std::exception &) {
+                // Not enough NTT-friendly primes of these sizes
+                continue;
+            }
+            result.push_back(parms);
+        }
+    }
+    return result;
+}
+
+CandidateReport ParameterTuner::evaluate(const TuningRequest &request, const EncryptionParameters &parms) {
+    check_request(request);
+    CandidateReport report;
+    report.parms = parms;
+    report.poly_modulus_degree = parms.poly_modulus_degree();
+    report.max_bits = CoeffModulus::MaxBitCount(parms.poly_modulus_degree(), request.sec_level);
+    for (auto &modulus : parms.coeff_modulus()) {
+        report.bit_sizes.push_back(modulus.bit_count());
+        report.total_bits += modulus.bit_count();
+    }
+    if (parms.scheme() == scheme_type::ckks && !report.bit_sizes.empty()) {
+        int scale_bits = report.bit_sizes.size() > 2 ? report.bit_sizes[1] : report.bit_sizes.front() - request.integer_bits;
+        report.scale = std::pow(2.0, scale_bits);
+    }
+
+    try {
+        SEALContext context(parms, true, request.sec_level);
+        if (!context.parameters_set()) {
+            report.failure = context.parameter_error_message();
+            return report;
+        }
+        bool needs_keys = request.depth > 0 || request.rotations > 0;
+        if (needs_keys && !context.using_keyswitching()) {
+            report.failure = "key switching is not available with a single prime";
+            return report;
+        }
+
+        KeyGenerator keygen(context);
+        RelinKeys relin_keys;
+        GaloisKeys galois_keys;
+        auto steps = rotation_steps(request, parms.poly_modulus_degree());
+        auto start = std::chrono::steady_clock::now();
+        if (request.depth > 0) keygen.create_relin_keys(relin_keys);
+        if (!steps.empty()) keygen.create_galois_keys(steps, galois_keys);
+        std::chrono::duration<double, std::milli> keygen_elapsed = std::chrono::steady_clock::now() - start;
+        report.keygen_ms = keygen_elapsed.count();
+        if (request.depth > 0) report.relin_key_bytes = saved_size(relin_keys.save_size(compr_mode_type::none));
+        if (!steps.empty()) report.galois_key_bytes = saved_size(galois_keys.save_size(compr_mode_type::none));
+
+        const GaloisKeys *rotation_keys = steps.empty() ? nullptr : &galois_keys;
+        if (parms.scheme() == scheme_type::ckks) {
+            run_ckks(request, context, keygen, relin_keys, rotation_keys, report);
+        } else {
+            run_integer(request, context, keygen, relin_keys, rotation_keys, report);
+        }
+    } catch (const std::exception &e) {
+        report.failure = e.what();
+    }
+
+    report.passed = report.failure.empty();
+    report.circuit_ms = report.encrypt_ms + request.depth * (report.multiply_ms + report.rescale_ms) +
+                        static_cast<double>(request.rotations) * report.rotate_ms + report.decrypt_ms;
+    return report;
+}
+
+TuningResult ParameterTuner::tune(const TuningRequest &request) {
+    TuningResult result;
+    for (auto &parms : candidates(request)) result.candidates.push_back(evaluate(request, parms));
+
+    bool found = false;
+    for (std::size_t i = 0; i < result.candidates.size(); i++) {
+        auto &candidate = result.candidates[i];
+        if (!candidate.passed) continue;
+        if (!found || candidate.circuit_ms < result.candidates[result.best].circuit_ms) result.best = i;
+        found = true;
+    }
+    if (!found) {
+        throw std::runtime_error("none of " + std::to_string(result.candidates.size()) +
+                                 " candidate parameter sets satisfies the request");
+    }
+    return result;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <seal/context.h>
+#include <seal/encryptionparams.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What the circuit needs from its encryption parameters
+struct TuningRequest {
+    seal::scheme_type scheme = seal::scheme_type::ckks;
+    int depth = 1;                // multiplicative depth
+    int precision_bits = 20;      // CKKS: bits of precision required on the output
+    int integer_bits = 10;        // CKKS: bits above the binary point
+    int plain_modulus_bits = 20;  // BFV/BGV: batching plain modulus size
+    std::size_t slots = 0;        // minimum slot count
+    std::size_t rotations = 0;    // number of distinct rotation keys the circuit uses
+    seal::sec_level_type sec_level = seal::sec_level_type::tc128;
+    std::size_t trials = 5;       // repetitions per timed operation
+};
+
+// Measurements for one candidate. Operation timings are averages in
+// milliseconds at the top data level; circuit_ms estimates the whole circuit
+// as encrypt + depth * (multiply + rescale) + rotations * rotate + decrypt.
+struct CandidateReport {
+    seal::EncryptionParameters parms;
+    std::size_t poly_modulus_degree = 0;
+    std::vector<int> bit_sizes;
+    int total_bits = 0;
+    int max_bits = 0;
+    double scale = 0;
+
+    bool passed = false;
+    std::string failure;
+
+    double keygen_ms = 0;
+    double encrypt_ms = 0;
+    double multiply_ms = 0;  // multiply + relinearize
+    double rescale_ms = 0;   // CKKS rescale or BGV modulus switch
+    double rotate_ms = 0;
+    double decrypt_ms = 0;
+    double circuit_ms = 0;
+
+    std::size_t ciphertext_bytes = 0;
+    std::size_t relin_key_bytes = 0;
+    std::size_t galois_key_bytes = 0;
+
+    double precision_bits = 0;  // CKKS: -log2 of the largest output error
+    int noise_budget = 0;       // BFV/BGV: bits left after the circuit
+};
+
+struct TuningResult {
+    std::vector<CandidateReport> candidates;
+    std::size_t best = 0;
+
+    const CandidateReport &best_candidate() const { return candidates.at(best); }
+};
+
+// Enumerates encryption parameters that can satisfy a request, runs the
+// request's circuit on each one to check it actually passes, and picks the
+// fastest passing candidate by estimated circuit time.
+class ParameterTuner {
+public:
+    // Candidates within the security bound, smallest poly_modulus_degree first
+    static std::vector<seal::EncryptionParameters> candidates(const TuningRequest &request);
+
+    // Benchmarks and validates one candidate; failures are reported, not thrown
+    static CandidateReport evaluate(const TuningRequest &request, const seal::EncryptionParameters &parms);
+
+    // Throws std::runtime_error when no candidate passes
+    static TuningResult tune(const TuningRequest &request);
+};